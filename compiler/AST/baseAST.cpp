@@ -181,18 +181,185 @@ void trace_remove(BaseAST* ast, char flag) {
     INT_FATAL(ast, "Unexpected attempt to eviscerate a global type symbol.");
 }
 
+/************************************* | **************************************
+*                                                                             *
+* AST nodes are allocated from slabs, with a free list for each node size, so *
+* that nodes of the same type are packed together.  The nodes deleted by      *
+* cleanAst() go back on their free list to be reused by the next pass, and    *
+* the slabs that are left without any live node are then freed.              *
+*                                                                             *
+************************************** | *************************************/
+
+struct AstSlab {
+  AstSlab* next;
+  int      numLive;
+  bool     release;
+};
+
+struct AstSlabPool {
+  AstSlab* slabs;
+  void*    freeList;
+};
+
+static const size_t kAstSlabSize      = 64 * 1024;   // must be a power of 2
+static const size_t kAstChunkAlign    = 16;
+static const size_t kAstMaxChunkSize  = 1024;
+static const size_t kAstSlabHeaderSize =
+  (sizeof(AstSlab) + kAstChunkAlign - 1) & ~(kAstChunkAlign - 1);
+
+static AstSlabPool astSlabPools[kAstMaxChunkSize / kAstChunkAlign + 1];
+static int         numAstSlabs = 0;
+
+static size_t astChunkSize(size_t size) {
+  return (size + kAstChunkAlign - 1) & ~(kAstChunkAlign - 1);
+}
+
+static AstSlab* astSlabOf(void* ptr) {
+  return (AstSlab*) ((uintptr_t) ptr & ~(uintptr_t) (kAstSlabSize - 1));
+}
+
+static void addAstSlab(AstSlabPool& pool, size_t chunkSize) {
+  void* mem = NULL;
+
+  if (posix_memalign(&mem, kAstSlabSize, kAstSlabSize) != 0) {
+    INT_FATAL("out of memory allocating AST nodes");
+  }
+
+  AstSlab* slab = (AstSlab*) mem;
+
+  slab->next    = pool.slabs;
+  slab->numLive = 0;
+  slab->release = false;
+  pool.slabs    = slab;
+
+  numAstSlabs++;
+
+  // Push the chunks in reverse so that they are handed out in order.
+  char*  first     = (char*) mem + kAstSlabHeaderSize;
+  size_t numChunks = (kAstSlabSize - kAstSlabHeaderSize) / chunkSize;
+
+  for (size_t i = numChunks; i > 0; i--) {
+    void** chunk = (void**) (first + (i - 1) * chunkSize);
+
+    *chunk        = pool.freeList;
+    pool.freeList = chunk;
+  }
+}
+
+void* BaseAST::operator new(size_t size) {
+  size_t chunkSize = astChunkSize(size);
+
+  if (chunkSize > kAstMaxChunkSize) {
+    return ::operator new(size);
+  }
+
+  AstSlabPool& pool = astSlabPools[chunkSize / kAstChunkAlign];
+
+  if (pool.freeList == NULL) {
+    addAstSlab(pool, chunkSize);
+  }
+
+  void** chunk = (void**) pool.freeList;
+
+  pool.freeList = *chunk;
+  astSlabOf(chunk)->numLive++;
+
+  return chunk;
+}
+
+void BaseAST::operator delete(void* ptr, size_t size) {
+  size_t chunkSize = astChunkSize(size);
+
+  if (ptr == NULL) {
+    return;
+  }
+
+  if (chunkSize > kAstMaxChunkSize) {
+    ::operator delete(ptr);
+    return;
+  }
+
+  AstSlabPool& pool = astSlabPools[chunkSize / kAstChunkAlign];
+
+  *(void**) ptr = pool.freeList;
+  pool.freeList = ptr;
+  astSlabOf(ptr)->numLive--;
+}
+
+//
+// Free the slabs that no longer hold a live node, after dropping
+// their chunks from the free list.  Returns the number of slabs freed.
+//
+static int releaseEmptyAstSlabs() {
+  int retval = 0;
+
+  for (size_t i = 0; i < sizeof(astSlabPools) / sizeof(AstSlabPool); i++) {
+    AstSlabPool& pool    = astSlabPools[i];
+    bool         anyFree = false;
+
+    for (AstSlab* slab = pool.slabs; slab != NULL; slab = slab->next) {
+      slab->release = (slab->numLive == 0);
+      anyFree       = anyFree || slab->release;
+    }
+
+    if (anyFree == false) {
+      continue;
+    }
+
+    void*  head = NULL;
+    void** tail = &head;
+
+    for (void* chunk = pool.freeList; chunk != NULL; ) {
+      void* next = *(void**) chunk;
+
+      if (astSlabOf(chunk)->release == false) {
+        *tail = chunk;
+        tail  = (void**) chunk;
+      }
+
+      chunk = next;
+    }
+
+    *tail         = NULL;
+    pool.freeList = head;
+
+    AstSlab** prev = &pool.slabs;
+
+    while (AstSlab* slab = *prev) {
+      if (slab->release == true) {
+        *prev = slab->next;
+        free(slab);
+
+        numAstSlabs--;
+        retval++;
+
+      } else {
+        prev = &slab->next;
+      }
+    }
+  }
+
+  return retval;
+}
+
 #define clean_gvec(type)                        \
   int i##type = 0;                              \
+  int d##type = 0;                              \
   forv_Vec(type, ast, g##type##s) {             \
     if (isAlive(ast) || isRootModuleWithType(ast, type)) { \
       g##type##s.v[i##type++] = ast;            \
     } else {                                    \
       trace_remove(ast, 'x');                   \
       delete ast; ast = 0;                      \
+      d##type++;                                \
     }                                           \
   }                                             \
   g##type##s.n = i##type
 
+#define print_clean_counts(type)                \
+  if (i##type > 0 || d##type > 0)               \
+    fprintf(stderr, "    %-20s live %9d  dead %9d\n", #type, i##type, d##type)
+
 
 static void clean_modvec(Vec<ModuleSymbol*>& modvec) {
   int aliveMods = 0;
@@ -258,6 +425,15 @@ void cleanAst() {
   // clean global vectors and delete dead ast instances
   //
   foreach_ast(clean_gvec);
+
+  int released = releaseEmptyAstSlabs();
+
+  if (strchr(fPrintStatistics, 'd') != NULL) {
+    foreach_ast(print_clean_counts);
+
+    fprintf(stderr, "    AST slabs %d (%dK), %d freed\n",
+            numAstSlabs, (int) (numAstSlabs * kAstSlabSize / 1024), released);
+  }
 }
 
 
@@ -72,6 +72,76 @@ int      gStmtCount =  0;
 
 std::map<std::string, int> commIDMap;
 
+//
+// With --c-units, the functions are written to a number of C files
+// that are compiled separately.  They are filled in code generation
+// order, each one getting its share of the total weight, so that
+// functions from the same module mostly end up together.
+//
+static std::vector<fileinfo>  cUnitFiles;
+static std::map<FnSymbol*, int>  cUnitFnWeights;
+static int64_t                cUnitTotalWeight = 0;
+static int64_t                cUnitDoneWeight  = 0;
+static size_t                 cUnitCurrent     = 0;
+
+
+// Is the generated C code compiled as more than one translation unit?
+// If so, symbols can't be static and globals are defined only once.
+bool codegenSeparateUnits() {
+  return fIncrementalCompilation || fNumCUnits > 1;
+}
+
+// The size of a function, for balancing the C translation units.
+static int cUnitWeight(FnSymbol* fn) {
+  std::vector<BaseAST*> asts;
+  collect_asts(fn, asts);
+  return (int) asts.size();
+}
+
+static void openCUnits(std::vector<const char*>& unitNames) {
+  forv_Vec(FnSymbol, fn, gFnSymbols) {
+    if (!fn->hasFlag(FLAG_EXTERN) && !fn->hasFlag(FLAG_NO_CODEGEN) &&
+        isModuleSymbol(fn->defPoint->parentSymbol)) {
+      int weight = cUnitWeight(fn);
+      cUnitFnWeights[fn] = weight;
+      cUnitTotalWeight += weight;
+    }
+  }
+
+  cUnitFiles.resize(fNumCUnits);
+  for (int i = 0; i < fNumCUnits; i++) {
+    fileinfo* unit = &cUnitFiles[i];
+    openCFile(unit, astr("chpl__unit", istr(i)), "c");
+    fprintf(unit->fptr, "#include \"chpl__header.h\"\n");
+
+    // the Makefile wants the object file name, which is this sans ".c"
+    std::string path(unit->pathname);
+    unitNames.push_back(astr(path.substr(0, path.size() - 2).c_str()));
+  }
+}
+
+static void closeCUnits() {
+  for (size_t i = 0; i < cUnitFiles.size(); i++)
+    closeCFile(&cUnitFiles[i]);
+  cUnitFiles.clear();
+}
+
+//
+// Direct the output for 'fn' to the right translation unit, if we are
+// generating more than one.
+//
+void codegenSelectCUnit(FnSymbol* fn) {
+  if (cUnitFiles.empty())
+    return;
+
+  int64_t share = cUnitTotalWeight / cUnitFiles.size();
+  if (cUnitCurrent + 1 < cUnitFiles.size() &&
+      cUnitDoneWeight >= share * (int64_t) (cUnitCurrent + 1))
+    cUnitCurrent++;
+  cUnitDoneWeight += cUnitFnWeights[fn];
+
+  gGenInfo->cfile = cUnitFiles[cUnitCurrent].fptr;
+}
 
 // ensure these two produce consistent output
 std::string zlineToString(BaseAST* ast) {
@@ -1354,7 +1424,7 @@ static void codegen_defn(std::set<const char*> & cnames, std::vector<TypeSymbol*
   genComment("Virtual Method Table");
   genVirtualMethodTable(types, false);
 
-  if(fIncrementalCompilation) {
+  if(codegenSeparateUnits()) {
     genComment("Global Variables");
     forv_Vec(VarSymbol, varSymbol, globals) {
       varSymbol->codegenGlobalDef(false);
@@ -2326,7 +2396,9 @@ void codegen() {
     fprintf(mainfile.fptr, "#include \"chpl__defn.c\"\n");
 
     std::vector<const char*> userFileName;
-    if(fIncrementalCompilation) {
+    if(fNumCUnits > 1) {
+      openCUnits(userFileName);
+    } else if(fIncrementalCompilation) {
       ChainHashMap<char*, StringHashFns, int> fileNameHashMap;
       forv_Vec(ModuleSymbol, currentModule, allModules) {
         const char* filename = NULL;
@@ -2402,6 +2474,11 @@ void codegen() {
       mysystem(astr("# codegen-ing module", currentModule->name),
                "generating comment for --print-commands option");
 
+      if (!cUnitFiles.empty()) {
+        currentModule->codegenDef();
+        continue;
+      }
+
       const char* filename = NULL;
       filename = generateFileName(fileNameHashMap, filename,currentModule->name);
 
@@ -2417,6 +2494,8 @@ void codegen() {
         fprintf(mainfile.fptr, "#include \"%s%s\"\n", filename, ".c");
     }
 
+    closeCUnits();
+
     fprintf(strconfig.fptr, "#include \"chpl-string.h\"\n");
     fprintf(strconfig.fptr, "chpl_string defaultStringValue=\"\";\n");
 
@@ -2449,6 +2528,10 @@ void makeBinary(void) {
 #endif
   } else {
     const char* makeflags = printSystemCommands ? "-f " : "-s -f ";
+    if (fNumCUnits > 1) {
+      // compile the translation units in parallel
+      makeflags = astr("-j", istr(fNumCUnits), " ", makeflags);
+    }
     const char* command = astr(astr(CHPL_MAKE, " "),
                                makeflags,
                                getIntermediateDirName(), "/Makefile");
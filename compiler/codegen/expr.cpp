@@ -4035,9 +4035,11 @@ DEFINE_PRIM(PRIM_ASSIGN) {
 }
 
 static bool commUnorderedOpsAvailable(Type* elementType) {
-  if (0 == strcmp(CHPL_COMM, "ugni")) {
-    // the ugni layer only supports unordered gets for up to 8 bytes
-    // and we use numeric type as a stand-in for that
+  if (0 == strcmp(CHPL_COMM, "ugni") ||
+      0 == strcmp(CHPL_COMM, "gasnet")) {
+    // the ugni layer only supports unordered gets for up to 8 bytes,
+    // and gasnet only aggregates ones that small, so we use numeric
+    // type as a stand-in for that
     if (is_bool_type(elementType) ||
         is_int_type(elementType) ||
         is_uint_type(elementType) ||
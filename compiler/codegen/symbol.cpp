@@ -730,7 +730,7 @@ void VarSymbol::codegenDefC(bool global, bool isHeader) {
   //
   std::string str;
 
-  if(fIncrementalCompilation || (this->hasFlag(FLAG_EXTERN) &&
+  if(codegenSeparateUnits() || (this->hasFlag(FLAG_EXTERN) &&
                                  this->hasFlag(FLAG_GENERATE_SIGNATURE))) {
     bool addExtern =  global && isHeader;
     str = (addExtern ? "extern " : "") + typestr + " " + cname;
@@ -1696,7 +1696,7 @@ void FnSymbol::codegenHeaderC(void) {
   if (fGenIDS)
     fprintf(outfile, "%s", idCommentTemp(this));
 
-  if (!fIncrementalCompilation && !hasFlag(FLAG_EXPORT) && !hasFlag(FLAG_EXTERN)) {
+  if (!codegenSeparateUnits() && !hasFlag(FLAG_EXPORT) && !hasFlag(FLAG_EXTERN)) {
     fprintf(outfile, "static ");
   }
   fprintf(outfile, "%s", codegenFunctionType(true).c.c_str());
@@ -2359,6 +2359,7 @@ void ModuleSymbol::codegenDef() {
 #endif
 
   for_vector(FnSymbol, fn, fns) {
+    codegenSelectCUnit(fn);
     fn->codegenDef();
   }
 
@@ -52,6 +52,7 @@ extern bool fNoDivZeroChecks;
 extern bool fMungeUserIdents;
 extern bool fEnableTaskTracking;
 extern bool fLLVMWideOpt;
+extern int  fLLVMCodegenThreads;
 
 extern bool fNoRemoteValueForwarding;
 extern bool fNoInferConstRefs;
@@ -124,6 +125,8 @@ extern const char* CHPL_LLVM_UNIQ_CFG_PATH;
 
 extern bool  printPasses;
 extern FILE* printPassesFile;
+extern bool  printPassProfile;
+extern FILE* printPassProfileJsonFile;
 
 extern char fExplainCall[256];
 extern int  explainCallID;
@@ -232,6 +235,10 @@ extern bool fMinimalModules;
 // Set to true if we want to enable incremental compilation.
 extern bool fIncrementalCompilation;
 
+// Number of translation units to split the generated C code into,
+// or 0 or 1 to generate a single one.
+extern int fNumCUnits;
+
 // LLVM flags (-mllvm)
 extern std::string llvmFlags;
 
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2004-2019 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _PASS_PROFILE_H_
+#define _PASS_PROFILE_H_
+
+#include "timer.h"
+
+//
+// Counters and timers for events inside the passes, reported per pass
+// by --print-pass-profile and --print-pass-profile-json.  The counters
+// are cumulative; PhaseTracker takes the difference between passes.
+//
+enum ProfileCounter {
+  PROFILE_CALLS_RESOLVED,
+  PROFILE_FNS_RESOLVED,
+  PROFILE_VISIBLE_FN_LOOKUPS,
+  PROFILE_VISIBLE_FN_CACHE_HITS,
+  PROFILE_INSTANTIATIONS,
+  PROFILE_INSTANTIATION_CACHE_HITS,
+  PROFILE_PROMOTIONS,
+  PROFILE_PROMOTION_CACHE_HITS,
+
+  PROFILE_NUM_COUNTERS
+};
+
+enum ProfileTimer {
+  PROFILE_TIME_VISIBLE_FNS,
+  PROFILE_TIME_INSTANTIATION,
+
+  PROFILE_NUM_TIMERS
+};
+
+extern unsigned long profileCounters[PROFILE_NUM_COUNTERS];
+
+bool          passProfileEnabled();
+
+const char*   profileCounterName(ProfileCounter counter);
+const char*   profileTimerName(ProfileTimer timer);
+
+unsigned long profileTimerUsecs(ProfileTimer timer);
+
+static inline void profileCount(ProfileCounter counter) {
+  profileCounters[counter]++;
+}
+
+//
+// Adds the time spent in its scope to a timer, when profiling.  Nested
+// scopes for the same timer, e.g. from recursion, are not counted twice.
+//
+class ProfileTimerScope {
+public:
+                 ProfileTimerScope(ProfileTimer timer);
+                ~ProfileTimerScope();
+
+private:
+                 ProfileTimerScope();
+
+  ProfileTimer   mTimer;
+  bool           mOutermost;
+};
+
+#endif
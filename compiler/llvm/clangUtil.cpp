@@ -29,6 +29,7 @@
 #include <cstring>
 #include <cstdio>
 #include <sstream>
+#include <thread>
 
 #ifdef HAVE_LLVM
 #include "clang/AST/GlobalDecl.h"
@@ -54,6 +55,7 @@
 
 #include "llvm/Analysis/TargetLibraryInfo.h"
 #include "llvm/Analysis/TargetTransformInfo.h"
+#include "llvm/Bitcode/BitcodeReader.h"
 #include "llvm/Bitcode/BitcodeWriter.h"
 #include "llvm/IR/LegacyPassManager.h"
 #include "llvm/IR/Verifier.h"
@@ -66,6 +68,8 @@
 #include "llvm/Target/TargetMachine.h"
 #include "llvm/Transforms/IPO.h"
 #include "llvm/Transforms/IPO/PassManagerBuilder.h"
+#include "llvm/Transforms/Utils/Cloning.h"
+#include "llvm/Transforms/Utils/SplitModule.h"
 
 #ifdef HAVE_LLVM_RV
 #include "rv/passes.h"
@@ -2584,6 +2588,192 @@ static void runLLVMLinking(std::string useLinkCXX, std::string options,
 static void moveGeneratedLibraryFile(const char* tmpbinname);
 static void moveResultFromTmp(const char* resultName, const char* tmpbinname);
 
+// Should optimization after global-to-wide and code generation be
+// split across threads?  Not if we are printing the IR, since the
+// output from the threads would be interleaved.
+static bool splitLLVMCodegen() {
+  return fLLVMCodegenThreads > 1 &&
+         llvmPrintIrStageNum == llvmStageNum::NOPRINT;
+}
+
+// Run the optimizations needed after the GlobalToWide pass.
+static void runPostGlobalToWidePasses(llvm::Module* M,
+                                      llvm::TargetMachine* TM) {
+  llvm::legacy::PassManager mpm2;
+
+  mpm2.add(createTargetTransformInfoWrapperPass(TM->getTargetIRAnalysis()));
+
+  Triple TargetTriple(M->getTargetTriple());
+  llvm::TargetLibraryInfoImpl TLII(TargetTriple);
+  mpm2.add(new TargetLibraryInfoWrapperPass(TLII));
+
+  PassManagerBuilder PMBuilder2;
+
+  configurePMBuilder(PMBuilder2, false, /* opt level */ 1);
+  // Should we disable vectorization since we did that?
+  // Or run select few cleanup passes?
+  // Inlining is definitely important here..
+
+  PMBuilder2.populateModulePassManager(mpm2);
+
+  // Run the optimizations now!
+  mpm2.run(*M);
+}
+
+// Save M as bitcode.  Returns false if the file can't be opened.
+static bool tryWriteBitcodeFile(llvm::Module* M, std::string filename) {
+  std::error_code tmpErr;
+  TOOL_OUTPUT_FILE output (filename.c_str(), tmpErr, sys::fs::F_None);
+  if (tmpErr)
+    return false;
+#if HAVE_LLVM_VER < 70
+  WriteBitcodeToFile(M, output.os());
+#else
+  WriteBitcodeToFile(*M, output.os());
+#endif
+  output.keep();
+  output.os().flush();
+  return true;
+}
+
+static void writeBitcodeFile(llvm::Module* M, std::string filename) {
+  if (!tryWriteBitcodeFile(M, filename))
+    USR_FATAL("Could not open output file %s", filename.c_str());
+}
+
+// Setup and run LLVM passes to emit a .o file for M to os
+static void emitObjectFile(llvm::Module* M, llvm::TargetMachine* TM,
+                           llvm::raw_pwrite_stream& os) {
+  llvm::legacy::PassManager emitPM;
+
+  emitPM.add(createTargetTransformInfoWrapperPass(TM->getTargetIRAnalysis()));
+
+  llvm::TargetMachine::CodeGenFileType FileType =
+    llvm::TargetMachine::CGFT_ObjectFile;
+  bool disableVerify = ! developer;
+#if HAVE_LLVM_VER > 60
+  TM->addPassesToEmitFile(emitPM, os, nullptr, FileType, disableVerify);
+#else
+  TM->addPassesToEmitFile(emitPM, os, FileType, disableVerify);
+#endif
+
+  // Run the passes to emit the .o file now!
+  emitPM.run(*M);
+}
+
+//
+// Split the optimized module into --llvm-codegen-threads parts and
+// finish optimizing and emit an object file for each on its own
+// thread.  This comes after the whole-module passes, so inlining and
+// the GlobalToWide lowering are not limited by the partitioning.
+//
+// LLVM contexts can't be shared between threads, so the parts are
+// passed to the threads as bitcode and each one reads its part into a
+// context of its own.  The first part goes to 'outputOfile'; the
+// object files for the others are added to 'dotOFiles'.  With --savec,
+// the bitcode for part <i> after the post-GlobalToWide passes is saved
+// as chpl__module-opt2-<i>.bc in place of chpl__module-opt2.bc.
+//
+static void splitAndEmitLLVM(llvm::raw_fd_ostream& outputOfile,
+                             std::vector<std::string>& dotOFiles) {
+  GenInfo* info = gGenInfo;
+  llvm::TargetMachine* mainTM = info->targetMachine;
+  int numParts = fLLVMCodegenThreads;
+
+  // Partition the module.  Internal symbols are given hidden external
+  // linkage so that they can be referenced across the parts.
+  std::vector<SmallString<0> > partBitcode;
+#if HAVE_LLVM_VER < 70
+  std::unique_ptr<llvm::Module> wholeModule = llvm::CloneModule(info->module);
+#else
+  std::unique_ptr<llvm::Module> wholeModule = llvm::CloneModule(*info->module);
+#endif
+  llvm::SplitModule(std::move(wholeModule), numParts,
+                    [&](std::unique_ptr<llvm::Module> part) {
+                      partBitcode.emplace_back();
+                      raw_svector_ostream bcos(partBitcode.back());
+#if HAVE_LLVM_VER < 70
+                      WriteBitcodeToFile(part.get(), bcos);
+#else
+                      WriteBitcodeToFile(*part, bcos);
+#endif
+                    },
+                    /* PreserveLocals */ false);
+
+  numParts = partBitcode.size();
+  std::vector<std::string> partErrors(numParts);
+  std::vector<std::string> partOFiles(numParts);
+  std::vector<std::string> partOpt2Files(numParts);
+  for (int i = 0; i < numParts; i++) {
+    // Name the files here; genIntermediateFilename() isn't thread-safe.
+    if (i > 0)
+      partOFiles[i] = genIntermediateFilename(
+                        astr("chpl__module-", istr(i), ".o"));
+    if (fLLVMWideOpt && saveCDir[0] != '\0')
+      partOpt2Files[i] = genIntermediateFilename(
+                           astr("chpl__module-opt2-", istr(i), ".bc"));
+  }
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < numParts; i++) {
+    threads.emplace_back([&, i] () {
+      llvm::LLVMContext ctx;
+      llvm::MemoryBufferRef buf(StringRef(partBitcode[i].data(),
+                                          partBitcode[i].size()),
+                                "chpl__module");
+      llvm::Expected<std::unique_ptr<llvm::Module> > partOrErr =
+        llvm::parseBitcodeFile(buf, ctx);
+      if (!partOrErr) {
+        partErrors[i] = llvm::toString(partOrErr.takeError());
+        return;
+      }
+      std::unique_ptr<llvm::Module> part = std::move(*partOrErr);
+
+      // Each thread needs its own TargetMachine, too.
+      std::unique_ptr<llvm::TargetMachine> TM(
+        mainTM->getTarget().createTargetMachine(
+          mainTM->getTargetTriple().str(),
+          mainTM->getTargetCPU(),
+          mainTM->getTargetFeatureString(),
+          mainTM->Options,
+          mainTM->getRelocationModel(),
+          mainTM->getCodeModel(),
+          mainTM->getOptLevel()));
+
+      if (fLLVMWideOpt)
+        runPostGlobalToWidePasses(part.get(), TM.get());
+
+      if (!partOpt2Files[i].empty() &&
+          !tryWriteBitcodeFile(part.get(), partOpt2Files[i])) {
+        partErrors[i] = "Could not open output file " + partOpt2Files[i];
+        return;
+      }
+
+      if (i == 0) {
+        emitObjectFile(part.get(), TM.get(), outputOfile);
+      } else {
+        std::error_code error;
+        llvm::raw_fd_ostream os(partOFiles[i], error, llvm::sys::fs::F_None);
+        if (error || os.has_error()) {
+          partErrors[i] = "Could not open output file " + partOFiles[i];
+          return;
+        }
+        emitObjectFile(part.get(), TM.get(), os);
+      }
+    });
+  }
+
+  for (size_t i = 0; i < threads.size(); i++)
+    threads[i].join();
+
+  for (int i = 0; i < numParts; i++) {
+    if (!partErrors[i].empty())
+      USR_FATAL("LLVM code generation failed: %s", partErrors[i].c_str());
+    if (i > 0)
+      dotOFiles.push_back(partOFiles[i]);
+  }
+}
+
 void makeBinaryLLVM(void) {
 
   GenInfo* info = gGenInfo;
@@ -2597,19 +2787,8 @@ void makeBinaryLLVM(void) {
   std::string opt2Filename = genIntermediateFilename("chpl__module-opt2.bc");
 
   if( saveCDir[0] != '\0' ) {
-    std::error_code tmpErr;
     // Save the generated LLVM before optimization.
-    TOOL_OUTPUT_FILE output (preOptFilename.c_str(),
-                             tmpErr, sys::fs::F_None);
-    if (tmpErr)
-      USR_FATAL("Could not open output file %s", preOptFilename.c_str());
-#if HAVE_LLVM_VER < 70
-    WriteBitcodeToFile(info->module, output.os());
-#else
-    WriteBitcodeToFile(*info->module, output.os());
-#endif
-    output.keep();
-    output.os().flush();
+    writeBitcodeFile(info->module, preOptFilename);
   }
 
   // Handle --llvm-print-ir-stage=basic
@@ -2692,19 +2871,15 @@ void makeBinaryLLVM(void) {
     adjustLayoutForGlobalToWide();
 
     llvm::legacy::PassManager mpm;
-    llvm::legacy::PassManager mpm2;
 
     // Add the TransformInfo pass
     mpm.add(createTargetTransformInfoWrapperPass(
             info->targetMachine->getTargetIRAnalysis()));
-    mpm2.add(createTargetTransformInfoWrapperPass(
-             info->targetMachine->getTargetIRAnalysis()));
 
     // Add the TargetLibraryInfo pass
     Triple TargetTriple(info->module->getTargetTriple());
     llvm::TargetLibraryInfoImpl TLII(TargetTriple);
     mpm.add(new TargetLibraryInfoWrapperPass(TLII));
-    mpm2.add(new TargetLibraryInfoWrapperPass(TLII));
 
     PMBuilder.populateModulePassManager(mpm);
 
@@ -2713,55 +2888,24 @@ void makeBinaryLLVM(void) {
 
     if( saveCDir[0] != '\0' ) {
       // Save the generated LLVM after first chunk of optimization
-      std::error_code tmpErr;
-      TOOL_OUTPUT_FILE output1 (opt1Filename.c_str(),
-                               tmpErr, sys::fs::F_None);
-      if (tmpErr)
-        USR_FATAL("Could not open output file %s", opt1Filename.c_str());
-#if HAVE_LLVM_VER < 70
-      WriteBitcodeToFile(info->module, output1.os());
-#else
-      WriteBitcodeToFile(*info->module, output1.os());
-#endif
-      output1.keep();
-      output1.os().flush();
+      writeBitcodeFile(info->module, opt1Filename);
     }
 
 
     if (fLLVMWideOpt) {
-      // the GlobalToWide pass creates calls to inline functions, among
-      // other things, that will need to be optimized. So run an additional
-      // battery of optimizations now.
-
-      PassManagerBuilder PMBuilder2;
-
-      configurePMBuilder(PMBuilder2, false, /* opt level */ 1);
-      // Should we disable vectorization since we did that?
-      // Or run select few cleanup passes?
-      // Inlining is definitely important here..
-
-      PMBuilder2.populateModulePassManager(mpm2);
-
       // Reset the data layout.
       info->module->setDataLayout(clangInfo->asmTargetLayoutStr);
 
-      // Run the optimizations now!
-      mpm2.run(*info->module);
+      // the GlobalToWide pass creates calls to inline functions, among
+      // other things, that will need to be optimized. So run an additional
+      // battery of optimizations now, or on each part when splitting.
+      if (!splitLLVMCodegen()) {
+        runPostGlobalToWidePasses(info->module, info->targetMachine);
 
-      if( saveCDir[0] != '\0' ) {
-        // Save the generated LLVM after second chunk of optimization
-        std::error_code tmpErr;
-        TOOL_OUTPUT_FILE output2 (opt2Filename.c_str(),
-                                 tmpErr, sys::fs::F_None);
-        if (tmpErr)
-          USR_FATAL("Could not open output file %s", opt2Filename.c_str());
-#if HAVE_LLVM_VER < 70
-        WriteBitcodeToFile(info->module, output2.os());
-#else
-        WriteBitcodeToFile(*info->module, output2.os());
-#endif
-        output2.keep();
-        output2.os().flush();
+        if( saveCDir[0] != '\0' ) {
+          // Save the generated LLVM after second chunk of optimization
+          writeBitcodeFile(info->module, opt2Filename);
+        }
       }
     }
   }
@@ -2787,32 +2931,14 @@ void makeBinaryLLVM(void) {
         == llvm::Reloc::Model::PIC_);
   }
 
-  // Emit the .o file for linking with clang
-  // Setup and run LLVM passes to emit a .o file to outputOfile
-  {
-    llvm::legacy::PassManager emitPM;
-
-    emitPM.add(createTargetTransformInfoWrapperPass(
-               info->targetMachine->getTargetIRAnalysis()));
-
-    llvm::TargetMachine::CodeGenFileType FileType =
-      llvm::TargetMachine::CGFT_ObjectFile;
-    bool disableVerify = ! developer;
-#if HAVE_LLVM_VER > 60
-    info->targetMachine->addPassesToEmitFile(emitPM, outputOfile,
-                                             nullptr,
-                                             FileType,
-                                             disableVerify);
-#else
-    info->targetMachine->addPassesToEmitFile(emitPM, outputOfile,
-                                             FileType,
-                                             disableVerify);
-#endif
+  // Emit the .o file(s) for linking with clang
+  std::vector<std::string> dotOFiles;
 
-    // Run the passes to emit the .o file now!
-    emitPM.run(*info->module);
-    outputOfile.close();
-  }
+  if (splitLLVMCodegen())
+    splitAndEmitLLVM(outputOfile, dotOFiles);
+  else
+    emitObjectFile(info->module, info->targetMachine, outputOfile);
+  outputOfile.close();
 
   //finishClang is before the call to the debug finalize
   deleteClang(clangInfo);
@@ -2902,8 +3028,6 @@ void makeBinaryLLVM(void) {
     useLinkCXX = ldOverride[0];
 
 
-  std::vector<std::string> dotOFiles;
-
   // Gather C flags for compiling C files.
   std::string cargs;
   for( size_t i = 0; i < clangInfo->clangCCArgs.size(); ++i ) {
@@ -19,12 +19,19 @@
 
 #include "PhaseTracker.h"
 
+#include "AstCount.h"
 #include "baseAST.h"
 #include "driver.h"
+#include "ModuleSymbol.h"
+#include "passProfile.h"
 
 #include <cstdlib>
 #include <cstring>
 #include <algorithm>
+#include <map>
+
+#include <sys/resource.h>
+#include <unistd.h>
 
 // Used to collect the times as the program runs
 class Phase
@@ -84,6 +91,35 @@ public:
   unsigned long  mCleanAst;         // usecs()
 };
 
+// A snapshot of memory use, live AST nodes and the profile counters
+// taken at the end of a pass
+class PassProfile
+{
+public:
+                   PassProfile(int passId, bool countAsts);
+
+  static void      TextReport(FILE*                            fp,
+                              const std::vector<Pass>&         passes,
+                              const PassProfile*               start,
+                              const std::vector<PassProfile*>& profiles);
+
+  static void      JsonReport(FILE*                            fp,
+                              const std::vector<Pass>&         passes,
+                              const PassProfile*               start,
+                              const std::vector<PassProfile*>& profiles,
+                              unsigned long                    totalTime);
+
+  int              mPassId;
+  unsigned long    mRss;                                // KiB
+  unsigned long    mPeakRss;                            // KiB
+  std::vector<int> mAstCounts;                          // see astCountNames
+  unsigned long    mCounters[PROFILE_NUM_COUNTERS];
+  unsigned long    mTimers[PROFILE_NUM_TIMERS];         // usecs
+
+private:
+                   PassProfile();
+};
+
 struct SortByTime
 {
   bool operator() (Pass const& a, Pass const& b) const
@@ -113,12 +149,19 @@ PhaseTracker::PhaseTracker()
 
   mTimer.start();
   StartPhase("startup");
+
+  mStartProfile = new PassProfile(0, false);
 }
 
 PhaseTracker::~PhaseTracker()
 {
   for (size_t i = 0; i < mPhases.size(); i++)
     delete mPhases[i];
+
+  for (size_t i = 0; i < mProfiles.size(); i++)
+    delete mProfiles[i];
+
+  delete mStartProfile;
 }
 
 void PhaseTracker::StartPhase(const char* name)
@@ -179,6 +222,28 @@ void PhaseTracker::ReportRollup() const
   PassesReport(passes, totalTime);
 }
 
+void PhaseTracker::RecordPassProfile()
+{
+  mProfiles.push_back(new PassProfile(mPhaseId, true));
+}
+
+void PhaseTracker::ReportPassProfile() const
+{
+  std::vector<Pass> passes;
+
+  PassesCollect(passes);
+
+  if (printPassProfile         == true)
+    PassProfile::TextReport(stderr, passes, mStartProfile, mProfiles);
+
+  if (printPassProfileJsonFile != 0)
+    PassProfile::JsonReport(printPassProfileJsonFile,
+                            passes,
+                            mStartProfile,
+                            mProfiles,
+                            mTimer.elapsedUsecs());
+}
+
 void PhaseTracker::PassesCollect(std::vector<Pass>& passes) const
 {
   unsigned long totalTime = mTimer.elapsedUsecs();
@@ -458,3 +523,274 @@ void Pass::Footer(FILE*         fp,
 
 
 
+
+/************************************* | **************************************
+*                                                                             *
+* Implementation of PassProfile                                               *
+*                                                                             *
+************************************** | *************************************/
+
+#define ast_count_name(type) #type
+#define ast_count_sep        ,
+
+static const char* astCountNames[] = {
+  foreach_ast_sep(ast_count_name, ast_count_sep),
+  "WhileDoStmt",
+  "DoWhileStmt",
+  "CForLoop",
+  "ForLoop",
+  "ParamForLoop"
+};
+
+#undef ast_count_sep
+#undef ast_count_name
+
+static const int kNumAstCounts = sizeof(astCountNames) / sizeof(char*);
+
+// The peak resident set size of the compiler, in KiB
+static unsigned long peakRssKB()
+{
+  struct rusage usage;
+
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+
+#ifdef __APPLE__
+  return usage.ru_maxrss / 1024;
+#else
+  return usage.ru_maxrss;
+#endif
+}
+
+// The current resident set size, in KiB, or the peak if it is unknown
+static unsigned long currentRssKB()
+{
+  unsigned long retval = 0;
+
+  if (FILE* fp = fopen("/proc/self/statm", "r"))
+  {
+    unsigned long size     = 0;
+    unsigned long resident = 0;
+
+    if (fscanf(fp, "%lu %lu", &size, &resident) == 2)
+      retval = resident * (sysconf(_SC_PAGESIZE) / 1024);
+
+    fclose(fp);
+  }
+
+  return (retval > 0) ? retval : peakRssKB();
+}
+
+PassProfile::PassProfile(int passId, bool countAsts)
+{
+  mPassId  = passId;
+  mRss     = currentRssKB();
+  mPeakRss = std::max(peakRssKB(), mRss);
+
+  if (countAsts == true && rootModule != NULL)
+  {
+    AstCount visitor;
+
+    rootModule->accept(&visitor);
+
+#define push_ast_count(type) mAstCounts.push_back(visitor.num##type)
+    foreach_ast(push_ast_count);
+#undef push_ast_count
+
+    mAstCounts.push_back(visitor.numWhileDoStmt);
+    mAstCounts.push_back(visitor.numDoWhileStmt);
+    mAstCounts.push_back(visitor.numCForLoop);
+    mAstCounts.push_back(visitor.numForLoop);
+    mAstCounts.push_back(visitor.numParamForLoop);
+  }
+  else
+  {
+    mAstCounts.resize(kNumAstCounts, 0);
+  }
+
+  for (int i = 0; i < PROFILE_NUM_COUNTERS; i++)
+    mCounters[i] = profileCounters[i];
+
+  for (int i = 0; i < PROFILE_NUM_TIMERS; i++)
+    mTimers[i]   = profileTimerUsecs((ProfileTimer) i);
+}
+
+static const Pass* findPass(const std::vector<Pass>& passes, int passId)
+{
+  for (size_t i = 0; i < passes.size(); i++)
+  {
+    if (passes[i].mPassId == passId)
+      return &passes[i];
+  }
+
+  return NULL;
+}
+
+void PassProfile::TextReport(FILE*                            fp,
+                             const std::vector<Pass>&         passes,
+                             const PassProfile*               start,
+                             const std::vector<PassProfile*>& profiles)
+{
+  const PassProfile* prev = start;
+
+  fprintf(fp, "\n");
+  fprintf(fp, "Pass               Name               ");
+  fprintf(fp, "    Time ");
+  fprintf(fp, "  RSS MB ");
+  fprintf(fp, "  Delta MB ");
+  fprintf(fp, " Peak MB ");
+  fprintf(fp, "      ASTs");
+  fprintf(fp, "\n");
+
+  fprintf(fp, "---- ---------------------------------");
+  fprintf(fp, "  -------");
+  fprintf(fp, "  -------");
+  fprintf(fp, "  ---------");
+  fprintf(fp, "  -------");
+  fprintf(fp, "  ---------");
+  fprintf(fp, "\n");
+
+  for (size_t i = 0; i < profiles.size(); i++)
+  {
+    const PassProfile* profile = profiles[i];
+    const Pass*        pass    = findPass(passes, profile->mPassId);
+    long               delta   = (long) profile->mRss - (long) prev->mRss;
+    int                numAsts = 0;
+
+    if (pass == NULL)
+      continue;
+
+    for (int j = 0; j < kNumAstCounts; j++)
+      numAsts = numAsts + profile->mAstCounts[j];
+
+    fprintf(fp, "%4d %-33s", pass->mPassId, pass->mName);
+    fprintf(fp, "  %7.3f", pass->TotalTime() / 1e6);
+    fprintf(fp, "  %7.1f", profile->mRss     / 1024.0);
+    fprintf(fp, "  %+9.1f", delta            / 1024.0);
+    fprintf(fp, "  %7.1f", profile->mPeakRss / 1024.0);
+    fprintf(fp, "  %9d",   numAsts);
+    fprintf(fp, "\n");
+
+    prev = profile;
+  }
+
+  // The counters and timers of the passes that changed them
+  prev = start;
+
+  for (size_t i = 0; i < profiles.size(); i++)
+  {
+    const PassProfile* profile = profiles[i];
+    const Pass*        pass    = findPass(passes, profile->mPassId);
+    bool               header  = false;
+
+    if (pass == NULL)
+      continue;
+
+    for (int j = 0; j < PROFILE_NUM_COUNTERS; j++)
+    {
+      unsigned long count = profile->mCounters[j] - prev->mCounters[j];
+
+      if (count > 0)
+      {
+        if (header == false)
+          fprintf(fp, "\n%4d %s\n", pass->mPassId, pass->mName);
+
+        header = true;
+
+        fprintf(fp, "       %-28s %12lu\n",
+                profileCounterName((ProfileCounter) j), count);
+      }
+    }
+
+    for (int j = 0; j < PROFILE_NUM_TIMERS; j++)
+    {
+      unsigned long usecs = profile->mTimers[j] - prev->mTimers[j];
+
+      if (usecs > 0)
+      {
+        if (header == false)
+          fprintf(fp, "\n%4d %s\n", pass->mPassId, pass->mName);
+
+        header = true;
+
+        fprintf(fp, "       %-28s %12.3f seconds\n",
+                profileTimerName((ProfileTimer) j), usecs / 1e6);
+      }
+    }
+
+    prev = profile;
+  }
+
+  fprintf(fp, "\n");
+}
+
+void PassProfile::JsonReport(FILE*                            fp,
+                             const std::vector<Pass>&         passes,
+                             const PassProfile*               start,
+                             const std::vector<PassProfile*>& profiles,
+                             unsigned long                    totalTime)
+{
+  const PassProfile* prev  = start;
+  bool               first = true;
+
+  fprintf(fp, "{\n");
+  fprintf(fp, "  \"totalTime\": %.6f,\n", totalTime / 1e6);
+  fprintf(fp, "  \"passes\": [");
+
+  for (size_t i = 0; i < profiles.size(); i++)
+  {
+    const PassProfile* profile = profiles[i];
+    const Pass*        pass    = findPass(passes, profile->mPassId);
+
+    if (pass == NULL)
+      continue;
+
+    fprintf(fp, "%s\n    {\n", first ? "" : ",");
+
+    fprintf(fp, "      \"id\": %d,\n",            pass->mPassId);
+    fprintf(fp, "      \"name\": \"%s\",\n",      pass->mName);
+    fprintf(fp, "      \"mainTime\": %.6f,\n",    pass->mPrimary  / 1e6);
+    fprintf(fp, "      \"checkTime\": %.6f,\n",   pass->mVerify   / 1e6);
+    fprintf(fp, "      \"cleanTime\": %.6f,\n",   pass->mCleanAst / 1e6);
+    fprintf(fp, "      \"rssKB\": %lu,\n",        profile->mRss);
+    fprintf(fp, "      \"rssDeltaKB\": %ld,\n",
+            (long) profile->mRss - (long) prev->mRss);
+    fprintf(fp, "      \"peakRssKB\": %lu,\n",    profile->mPeakRss);
+
+    fprintf(fp, "      \"asts\": {");
+
+    for (int j = 0; j < kNumAstCounts; j++)
+    {
+      fprintf(fp, "%s\n        \"%s\": %d",
+              j == 0 ? "" : ",", astCountNames[j], profile->mAstCounts[j]);
+    }
+
+    fprintf(fp, "\n      },\n");
+
+    fprintf(fp, "      \"counters\": {");
+
+    for (int j = 0; j < PROFILE_NUM_COUNTERS; j++)
+    {
+      fprintf(fp, "%s\n        \"%s\": %lu",
+              j == 0 ? "" : ",",
+              profileCounterName((ProfileCounter) j),
+              profile->mCounters[j] - prev->mCounters[j]);
+    }
+
+    for (int j = 0; j < PROFILE_NUM_TIMERS; j++)
+    {
+      fprintf(fp, ",\n        \"%s\": %.6f",
+              profileTimerName((ProfileTimer) j),
+              (profile->mTimers[j] - prev->mTimers[j]) / 1e6);
+    }
+
+    fprintf(fp, "\n      }\n");
+    fprintf(fp, "    }");
+
+    first = false;
+    prev  = profile;
+  }
+
+  fprintf(fp, "\n  ]\n");
+  fprintf(fp, "}\n");
+}
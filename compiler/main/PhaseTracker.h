@@ -60,6 +60,7 @@
 
 class Phase;
 class Pass;
+class PassProfile;
 
 class PhaseTracker
 {
@@ -84,6 +85,10 @@ public:
 
   void                 ReportRollup()                                const;
 
+  // Support for --print-pass-profile and --print-pass-profile-json
+  void                 RecordPassProfile();
+  void                 ReportPassProfile()                           const;
+
 private:
   void                 PassesCollect(std::vector<Pass>& passes) const;
   
@@ -94,6 +99,9 @@ private:
   Timer                mTimer;
   int                  mPhaseId;
   std::vector<Phase*>  mPhases;
+
+  PassProfile*               mStartProfile;
+  std::vector<PassProfile*>  mProfiles;
 };
 
 #endif
@@ -37,6 +37,7 @@
 #include "misc.h"
 #include "mysystem.h"
 #include "parser.h"
+#include "passProfile.h"
 #include "PhaseTracker.h"
 #include "primitive.h"
 #include "runpasses.h"
@@ -153,10 +154,16 @@ bool fEnableTaskTracking = false;
 
 bool  printPasses     = false;
 FILE* printPassesFile = NULL;
+bool  printPassProfile         = false;
+FILE* printPassProfileJsonFile = NULL;
 
 // flag for llvmWideOpt
 bool fLLVMWideOpt = false;
 
+// number of threads for LLVM optimization and code generation after
+// the whole-module passes, 0 or 1 for no splitting
+int fLLVMCodegenThreads = 0;
+
 bool fWarnConstLoops = true;
 bool fWarnUnstable = false;
 bool fDefaultUnmanaged = false;
@@ -177,6 +184,7 @@ bool fNoRemoveEmptyRecords = true;
 bool fRemoveUnreachableBlocks = true;
 bool fMinimalModules = false;
 bool fIncrementalCompilation = false;
+int  fNumCUnits = 0;
 bool fNoOptimizeForallUnordered = true;
 
 int optimize_on_clause_limit = 20;
@@ -819,6 +827,15 @@ static void setPrintPassesFile(const ArgumentDescription* desc, const char* file
   }
 }
 
+static void setPrintPassProfileJsonFile(const ArgumentDescription* desc,
+                                        const char* fileName) {
+  printPassProfileJsonFile = fopen(fileName, "w");
+
+  if (printPassProfileJsonFile == NULL) {
+    USR_WARN("Error opening printPassProfileJsonFile: %s.", fileName);
+  }
+}
+
 static void setLocal (const ArgumentDescription* desc, const char* unused) {
   // Used in postLocal() to set fLocal if user threw flag
   fUserSetLocal = true;
@@ -927,6 +944,7 @@ static ArgumentDescription arg_desc[] = {
  {"stack-checks", ' ', NULL, "Enable [disable] stack overflow checking", "n", &fNoStackChecks, "CHPL_STACK_CHECKS", setStackChecks},
 
  {"", ' ', NULL, "C Code Generation Options", NULL, NULL, NULL, NULL},
+ {"c-units", ' ', "<n>", "Split generated C code into <n> separately compiled translation units", "I", &fNumCUnits, "CHPL_C_UNITS", NULL},
  {"codegen", ' ', NULL, "[Don't] Do code generation", "n", &no_codegen, "CHPL_NO_CODEGEN", NULL},
  {"cpp-lines", ' ', NULL, "[Don't] Generate #line annotations", "N", &printCppLineno, "CHPL_CG_CPP_LINES", noteCppLinesSet},
  {"max-c-ident-len", ' ', NULL, "Maximum length of identifiers in generated code, 0 for unlimited", "I", &fMaxCIdentLen, "CHPL_MAX_C_IDENT_LEN", NULL},
@@ -948,6 +966,7 @@ static ArgumentDescription arg_desc[] = {
 
  {"", ' ', NULL, "LLVM Code Generation Options", NULL, NULL, NULL, NULL},
  {"llvm", ' ', NULL, "[Don't] use the LLVM code generator", "N", &llvmCodegen, "CHPL_LLVM_CODEGEN", NULL},
+ {"llvm-codegen-threads", ' ', "<n>", "Split the LLVM module to optimize and generate code for it on <n> threads", "I", &fLLVMCodegenThreads, "CHPL_LLVM_CODEGEN_THREADS", NULL},
  {"llvm-wide-opt", ' ', NULL, "Enable [disable] LLVM wide pointer optimizations", "N", &fLLVMWideOpt, "CHPL_LLVM_WIDE_OPTS", NULL},
  {"mllvm", ' ', "<flags>", "LLVM flags (can be specified multiple times)", "S", NULL, "CHPL_MLLVM", setLLVMFlags},
 
@@ -955,6 +974,8 @@ static ArgumentDescription arg_desc[] = {
  {"print-commands", ' ', NULL, "[Don't] print system commands", "N", &printSystemCommands, "CHPL_PRINT_COMMANDS", NULL},
  {"print-passes", ' ', NULL, "[Don't] print compiler passes", "N", &printPasses, "CHPL_PRINT_PASSES", NULL},
  {"print-passes-file", ' ', "<filename>", "Print compiler passes to <filename>", "S", NULL, "CHPL_PRINT_PASSES_FILE", setPrintPassesFile},
+ {"print-pass-profile", ' ', NULL, "[Don't] print time, memory and AST profile of compiler passes", "N", &printPassProfile, "CHPL_PRINT_PASS_PROFILE", NULL},
+ {"print-pass-profile-json", ' ', "<filename>", "Print profile of compiler passes to <filename> as JSON", "S", NULL, "CHPL_PRINT_PASS_PROFILE_JSON", setPrintPassProfileJsonFile},
 
  {"", ' ', NULL, "Miscellaneous Options", NULL, NULL, NULL, NULL},
 // Support for extern { c-code-here } blocks could be toggled with this
@@ -1027,7 +1048,7 @@ static ArgumentDescription arg_desc[] = {
  {"print-emitted-code-size", ' ', NULL, "Print emitted code size", "F", &fPrintEmittedCodeSize, NULL, NULL},
  {"print-module-resolution", ' ', NULL, "Print name of module being resolved", "F", &fPrintModuleResolution, "CHPL_PRINT_MODULE_RESOLUTION", NULL},
  {"print-dispatch", ' ', NULL, "Print dynamic dispatch table", "F", &fPrintDispatch, NULL, NULL},
- {"print-statistics", ' ', "[n|k|t]", "Print AST statistics", "S256", fPrintStatistics, NULL, NULL},
+ {"print-statistics", ' ', "[n|k|t|d]", "Print AST statistics", "S256", fPrintStatistics, NULL, NULL},
  {"report-aliases", ' ', NULL, "Report aliases in user code", "N", &fReportAliases, NULL, NULL},
  {"report-blocking", ' ', NULL, "Report blocking functions in user code", "N", &fReportBlocking, NULL, NULL},
  {"report-inlining", ' ', NULL, "Print inlined functions", "F", &report_inlining, NULL, NULL},
@@ -1382,6 +1403,8 @@ static void checkLLVMCodeGen() {
 #ifndef HAVE_LLVM
  if (llvmCodegen) USR_FATAL("This compiler was built without LLVM support");
 #endif
+ if (fLLVMCodegenThreads < 0)
+   USR_FATAL("--llvm-codegen-threads takes a non-negative number of threads");
 }
 
 static void checkTargetCpu() {
@@ -1401,6 +1424,15 @@ static void checkIncrementalAndOptimized() {
               " using -O optimizations directly.");
 }
 
+static void checkNumCUnits() {
+  if (fNumCUnits < 0)
+    USR_FATAL("--c-units takes a non-negative number of translation units");
+  if (fNumCUnits > 1 && llvmCodegen) {
+    USR_WARN("--c-units has no effect with --llvm");
+    fNumCUnits = 0;
+  }
+}
+
 static void postprocess_args() {
   // Processes that depend on results of passed arguments or values of CHPL_vars
 
@@ -1423,6 +1455,8 @@ static void postprocess_args() {
   checkTargetCpu();
 
   checkIncrementalAndOptimized();
+
+  checkNumCUnits();
 }
 
 int main(int argc, char* argv[]) {
@@ -1501,6 +1535,14 @@ int main(int argc, char* argv[]) {
     fclose(printPassesFile);
   }
 
+  if (passProfileEnabled() == true) {
+    tracker.ReportPassProfile();
+  }
+
+  if (printPassProfileJsonFile != NULL) {
+    fclose(printPassProfileJsonFile);
+  }
+
   clean_exit(0);
 
   return 0;
@@ -0,0 +1,81 @@
+/*
+ * Copyright 2004-2019 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "passProfile.h"
+
+#include "driver.h"
+
+unsigned long      profileCounters[PROFILE_NUM_COUNTERS];
+
+static Timer       profileTimers[PROFILE_NUM_TIMERS];
+static int         profileTimerDepth[PROFILE_NUM_TIMERS];
+
+static const char* profileCounterNames[PROFILE_NUM_COUNTERS] = {
+  "callsResolved",
+  "fnsResolved",
+  "visibleFnLookups",
+  "visibleFnCacheHits",
+  "instantiations",
+  "instantiationCacheHits",
+  "promotions",
+  "promotionCacheHits"
+};
+
+static const char* profileTimerNames[PROFILE_NUM_TIMERS] = {
+  "visibleFnTime",
+  "instantiationTime"
+};
+
+bool passProfileEnabled() {
+  return printPassProfile == true || printPassProfileJsonFile != NULL;
+}
+
+const char* profileCounterName(ProfileCounter counter) {
+  return profileCounterNames[counter];
+}
+
+const char* profileTimerName(ProfileTimer timer) {
+  return profileTimerNames[timer];
+}
+
+unsigned long profileTimerUsecs(ProfileTimer timer) {
+  return profileTimers[timer].elapsedUsecs();
+}
+
+ProfileTimerScope::ProfileTimerScope(ProfileTimer timer) {
+  mTimer     = timer;
+  mOutermost = false;
+
+  if (passProfileEnabled() == true) {
+    if (profileTimerDepth[timer]++ == 0) {
+      profileTimers[timer].start();
+      mOutermost = true;
+    }
+  }
+}
+
+ProfileTimerScope::~ProfileTimerScope() {
+  if (passProfileEnabled() == true) {
+    profileTimerDepth[mTimer]--;
+
+    if (mOutermost == true) {
+      profileTimers[mTimer].stop();
+    }
+  }
+}
@@ -24,6 +24,7 @@
 #include "log.h"
 #include "parser.h"
 #include "passes.h"
+#include "passProfile.h"
 #include "PhaseTracker.h"
 
 #include <cstdio>
@@ -234,6 +235,10 @@ static void runPass(PhaseTracker& tracker, size_t passIndex, bool isChpldoc) {
     cleanAst();
   }
 
+  if (passProfileEnabled() == true) {
+    tracker.RecordPassProfile();
+  }
+
   if (printPasses == true || printPassesFile != 0) {
     tracker.ReportPass();
   }
@@ -33,10 +33,13 @@
 SymbolMapCache genericsCache;
 SymbolMapCache promotionsCache;
 
+static unsigned int cacheHash(FnSymbol* oldFn, SymbolMap* map);
 static bool isCacheEntryMatch(SymbolMap* s1, SymbolMap* s2);
 
-SymbolMapCacheEntry::SymbolMapCacheEntry(FnSymbol* ifn, SymbolMap* imap) :
-  fn(ifn), map(*imap) { }
+SymbolMapCacheEntry::SymbolMapCacheEntry(FnSymbol*  ioldFn,
+                                         FnSymbol*  ifn,
+                                         SymbolMap* imap) :
+  oldFn(ioldFn), fn(ifn), map(*imap) { }
 
 
 void
@@ -44,8 +47,9 @@ addCache(SymbolMapCache& cache,
          FnSymbol*       oldFn,
          FnSymbol*       fn,
          SymbolMap*      map) {
-  Vec<SymbolMapCacheEntry*>* entries = cache.get(oldFn);
-  SymbolMapCacheEntry*       entry   = new SymbolMapCacheEntry(fn, map);
+  unsigned int               hash    = cacheHash(oldFn, map);
+  Vec<SymbolMapCacheEntry*>* entries = cache.get(hash);
+  SymbolMapCacheEntry*       entry   = new SymbolMapCacheEntry(oldFn, fn, map);
 
   if (entries) {
     entries->add(entry);
@@ -53,16 +57,16 @@ addCache(SymbolMapCache& cache,
   } else {
     entries = new Vec<SymbolMapCacheEntry*>();
     entries->add(entry);
-    cache.put(oldFn, entries);
+    cache.put(hash, entries);
   }
 }
 
 
 FnSymbol*
 checkCache(SymbolMapCache& cache, FnSymbol* oldFn, SymbolMap* map) {
-  if (Vec<SymbolMapCacheEntry*>* entries = cache.get(oldFn)) {
+  if (Vec<SymbolMapCacheEntry*>* entries = cache.get(cacheHash(oldFn, map))) {
     forv_Vec(SymbolMapCacheEntry, entry, *entries) {
-      if (isCacheEntryMatch(map, &entry->map))
+      if (entry->oldFn == oldFn && isCacheEntryMatch(map, &entry->map))
         return entry->fn;
     }
   }
@@ -75,9 +79,9 @@ replaceCache(SymbolMapCache& cache,
              FnSymbol*       oldFn,
              FnSymbol*       fn,
              SymbolMap*      map) {
-  if (Vec<SymbolMapCacheEntry*>* entries = cache.get(oldFn)) {
+  if (Vec<SymbolMapCacheEntry*>* entries = cache.get(cacheHash(oldFn, map))) {
     forv_Vec(SymbolMapCacheEntry, entry, *entries) {
-      if (isCacheEntryMatch(map, &entry->map)) {
+      if (entry->oldFn == oldFn && isCacheEntryMatch(map, &entry->map)) {
         entry->fn = fn;
         return;
       }
@@ -99,6 +103,36 @@ freeCache(SymbolMapCache& cache) {
   cache.clear();
 }
 
+static unsigned int mixHash(unsigned int h) {
+  h ^= h >> 16;
+  h *= 0x85ebca6bU;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35U;
+  h ^= h >> 16;
+
+  return h;
+}
+
+//
+// Hash on the ids of the symbols, not their addresses, so that the
+// layout of the cache does not vary from run to run.  The pairs are
+// summed so that the hash does not depend on their order in the map.
+// A pair with a NULL value matches a missing key in
+// isCacheEntryMatch(), so it does not contribute either.  Zero is
+// the empty key of a Map, so it is never returned.
+//
+static unsigned int cacheHash(FnSymbol* oldFn, SymbolMap* map) {
+  unsigned int retval = mixHash(oldFn->id);
+
+  form_Map(SymbolMapElem, e, *map) {
+    if (e->value != NULL) {
+      retval += mixHash(mixHash(e->key->id) + e->value->id);
+    }
+  }
+
+  return (retval != 0) ? retval : 1;
+}
+
 static bool isCacheEntryMatch(SymbolMap* s1, SymbolMap* s2) {
   form_Map(SymbolMapElem, e, *s1) {
     if (s2->get(e->key) != e->value) {
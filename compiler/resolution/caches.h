@@ -35,16 +35,21 @@
 //
 //   freeCache(cache): frees memory associated with cache
 //
+//   Entries are hashed on old_fn and the key-value pairs of the map,
+//   independent of their order, so a lookup only compares the maps
+//   of the entries whose hash collides with it.
+//
 class SymbolMapCacheEntry {
 public:
-  SymbolMapCacheEntry(FnSymbol* ifn, SymbolMap* imap);
+  SymbolMapCacheEntry(FnSymbol* ioldFn, FnSymbol* ifn, SymbolMap* imap);
 
+  FnSymbol* oldFn;
   FnSymbol* fn;
   SymbolMap map;
 };
 
-typedef Map<FnSymbol*,     Vec<SymbolMapCacheEntry*>*> SymbolMapCache;
-typedef MapElem<FnSymbol*, Vec<SymbolMapCacheEntry*>*> SymbolMapCacheElem;
+typedef Map<unsigned int,     Vec<SymbolMapCacheEntry*>*> SymbolMapCache;
+typedef MapElem<unsigned int, Vec<SymbolMapCacheEntry*>*> SymbolMapCacheElem;
 
 
 void      addCache(SymbolMapCache& cache,
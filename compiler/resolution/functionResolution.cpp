@@ -45,6 +45,7 @@
 #include "ParamForLoop.h"
 #include "PartialCopyData.h"
 #include "passes.h"
+#include "passProfile.h"
 #include "postFold.h"
 #include "preFold.h"
 #include "ResolutionCandidate.h"
@@ -2260,6 +2261,8 @@ static FnSymbol* resolveNormalCall(CallInfo& info, bool checkOnly) {
 
   FnSymbol*                 retval     = NULL;
 
+  profileCount(PROFILE_CALLS_RESOLVED);
+
   findVisibleFunctionsAndCandidates(info, mostApplicable, candidates);
 
   numMatches = disambiguateByMatch(info,
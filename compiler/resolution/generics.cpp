@@ -25,6 +25,7 @@
 #include "driver.h"
 #include "expr.h"
 #include "PartialCopyData.h"
+#include "passProfile.h"
 #include "resolveFunction.h"
 #include "resolveIntents.h"
 #include "stmt.h"
@@ -456,7 +457,10 @@ void gatherFieldSubstitutionsForNewType(AggregateType* oldType,
 FnSymbol* instantiateSignature(FnSymbol*  fn,
                                SymbolMap& subs,
                                CallExpr*  call) {
-  FnSymbol* retval = NULL;
+  ProfileTimerScope profileTimer(PROFILE_TIME_INSTANTIATION);
+  FnSymbol*         retval = NULL;
+
+  profileCount(PROFILE_INSTANTIATIONS);
 
   //
   // Handle tuples explicitly
@@ -494,6 +498,8 @@ FnSymbol* instantiateSignature(FnSymbol*  fn,
     // use cached instantiation if possible
     if (FnSymbol* cached = checkCache(genericsCache, root, &allSubs)) {
       if (cached != (FnSymbol*) gVoid) {
+        profileCount(PROFILE_INSTANTIATION_CACHE_HITS);
+
         checkInfiniteWhereInstantiation(cached);
 
         retval = cached;
@@ -34,6 +34,7 @@
 #include "UnmanagedClassType.h"
 #include "ParamForLoop.h"
 #include "passes.h"
+#include "passProfile.h"
 #include "postFold.h"
 #include "resolution.h"
 #include "resolveIntents.h"
@@ -466,6 +467,8 @@ void resolveFunction(FnSymbol* fn, CallExpr* forCall) {
       gdbShouldBreakHere();
     }
 
+    profileCount(PROFILE_FNS_RESOLVED);
+
     fn->addFlag(FLAG_RESOLVED);
 
     if (strcmp(fn->name, "init") == 0 && fn->isMethod()) {
@@ -23,6 +23,7 @@
 #include "driver.h"
 #include "expr.h"
 #include "map.h"
+#include "passProfile.h"
 #include "resolution.h"
 #include "resolveIntents.h"
 #include "stmt.h"
@@ -32,6 +33,7 @@
 
 #include <map>
 #include <set>
+#include <vector>
 
 
 /*
@@ -49,6 +51,12 @@
    symbols available to all modules (i.e. what is in ChapelStandard)
    is considered to be in a single block. This optimization
    provides a significant performance improvement for compiling 'hello'.
+
+   The result of walking the blocks for a name is also memoized per
+   (name, starting block), since many calls in the same block look
+   for the same names, e.g. '=' or 'chpl__autoCopy'.  The memoized
+   results for a name are dropped whenever a function with that name
+   is added to the tables above.
  */
 
 class VisibleFunctionBlock {
@@ -62,6 +70,15 @@ static Map<BlockStmt*, VisibleFunctionBlock*> visibleFunctionMap;
 
 static int                                    nVisibleFunctions       = 0;
 
+typedef std::pair<const char*, BlockStmt*>         VisibleFunctionsKey;
+typedef std::map<VisibleFunctionsKey,
+                 std::vector<FnSymbol*> >         VisibleFunctionsCache;
+
+// indexed by whether the call is a method call
+static VisibleFunctionsCache                  visibleFunctionsCache[2];
+
+static void invalidateVisibleFunctionsCache(const char* name);
+
 
 
 /************************************* | **************************************
@@ -74,7 +91,8 @@ static void  buildVisibleFunctionMap();
 
 void findVisibleFunctions(CallInfo&       info,
                           Vec<FnSymbol*>& visibleFns) {
-  CallExpr* call = info.call;
+  ProfileTimerScope profileTimer(PROFILE_TIME_VISIBLE_FNS);
+  CallExpr*         call = info.call;
 
   //
   // update visible function map as necessary
@@ -151,38 +169,90 @@ static void buildVisibleFunctionMap() {
         vfb->visibleFunctions.put(fn->name, fns);
       }
       fns->add(fn);
+
+      invalidateVisibleFunctionsCache(fn->name);
     }
   }
   nVisibleFunctions = gFnSymbols.n;
 }
 
+static void invalidateVisibleFunctionsCache(const char* name) {
+  VisibleFunctionsKey key(name, NULL);
+
+  for (int i = 0; i < 2; i++) {
+    VisibleFunctionsCache&          cache = visibleFunctionsCache[i];
+    VisibleFunctionsCache::iterator it    = cache.lower_bound(key);
+
+    while (it != cache.end() && it->first.first == name) {
+      cache.erase(it++);
+    }
+  }
+}
+
 /************************************* | **************************************
 *                                                                             *
 * Collects functions called 'name' visible in 'block' and up the visibility   *
 * chain.                                                                      *
 * The functions defined/visible in a block are given by 'visibleFunctionMap'. *
 *                                                                             *
+* The result only depends on the call through the visibility of private       *
+* functions and modules and through renaming 'use's, so it is memoized for    *
+* the starting block unless one of those was involved.                        *
+*                                                                             *
 ************************************** | *************************************/
 
 static void getVisibleFunctions(const char*           name,
                                 CallExpr*             call,
                                 BlockStmt*            block,
                                 std::set<BlockStmt*>& visited,
+                                bool&                 cacheable,
                                 Vec<FnSymbol*>&       visibleFns);
 
 void getVisibleFunctions(const char*      name,
                          CallExpr*        call,
                          Vec<FnSymbol*>&  visibleFns) {
-  BlockStmt*           block    = getVisibilityScope(call);
+  ProfileTimerScope      profileTimer(PROFILE_TIME_VISIBLE_FNS);
+  BlockStmt*             block        = getVisibilityScope(call);
+  bool                   isMethodCall = false;
+
+  profileCount(PROFILE_VISIBLE_FN_LOOKUPS);
+
+  if (call->numActuals() >= 2 && call->get(1)->typeInfo() == dtMethodToken)
+    isMethodCall = true;
+
+  VisibleFunctionsCache& cache        = visibleFunctionsCache[isMethodCall];
+  VisibleFunctionsKey    key(name, block);
+
+  if (call->id != breakOnResolveID) {
+    VisibleFunctionsCache::iterator it = cache.find(key);
+
+    if (it != cache.end()) {
+      profileCount(PROFILE_VISIBLE_FN_CACHE_HITS);
+
+      for (size_t i = 0; i < it->second.size(); i++) {
+        visibleFns.add(it->second[i]);
+      }
+
+      return;
+    }
+  }
+
   std::set<BlockStmt*> visited;
+  bool                 cacheable = true;
+  int                  start     = visibleFns.n;
+
+  getVisibleFunctions(name, call, block, visited, cacheable, visibleFns);
 
-  getVisibleFunctions(name, call, block, visited, visibleFns);
+  if (cacheable == true) {
+    cache[key].assign(visibleFns.v + start, visibleFns.v + visibleFns.n);
+  }
 }
 
 static void getVisibleFunctions(const char*           name,
                                 CallExpr*             call,
                                 BlockStmt*            block,
                                 std::set<BlockStmt*>& visited,
+                                bool&                 cacheable,
                                 Vec<FnSymbol*>&       visibleFns) {
 
   //
@@ -252,6 +322,10 @@ static void getVisibleFunctions(const char*           name,
 
       if (Vec<FnSymbol*>* fns = vfb->visibleFunctions.get(name)) {
         forv_Vec(FnSymbol, fn, *fns) {
+          if (fn->hasFlag(FLAG_PRIVATE) == true) {
+            cacheable = false;
+          }
+
           if (fn->isVisible(call) == true) {
             // isVisible checks if the function is private to its defining
             // module (and in that case, if we are under its defining module)
@@ -284,18 +358,28 @@ static void getVisibleFunctions(const char*           name,
             // The use statement could be of an enum instead of a module,
             // but only modules can define functions.
 
+            if (mod->hasFlag(FLAG_PRIVATE) == true) {
+              cacheable = false;
+            }
+
             if (mod->isVisible(call) == true) {
               if (use->isARename(name) == true) {
+                // The result would also need to be dropped when a
+                // function with the original name is added.
+                cacheable = false;
+
                 getVisibleFunctions(use->getRename(name),
                                     call,
                                     mod->block,
                                     visited,
+                                    cacheable,
                                     visibleFns);
               } else {
                 getVisibleFunctions(name,
                                     call,
                                     mod->block,
                                     visited,
+                                    cacheable,
                                     visibleFns);
               }
             }
@@ -308,11 +392,12 @@ static void getVisibleFunctions(const char*           name,
       BlockStmt* next  = getVisibilityScope(block);
 
       // Recurse in the enclosing block
-      getVisibleFunctions(name, call, next, visited, visibleFns);
+      getVisibleFunctions(name, call, next, visited, cacheable, visibleFns);
 
       if (instantiationPt != NULL) {
         // Also look at the instantiation point
-        getVisibleFunctions(name, call, instantiationPt, visited, visibleFns);
+        getVisibleFunctions(name, call, instantiationPt, visited, cacheable,
+                            visibleFns);
       }
     }
   }
@@ -421,6 +506,9 @@ void visibleFunctionsClear() {
   }
 
   visibleFunctionMap.clear();
+
+  visibleFunctionsCache[0].clear();
+  visibleFunctionsCache[1].clear();
 }
 
 /************************************* | **************************************
@@ -53,6 +53,7 @@
 #include "iterator.h"
 #include "UnmanagedClassType.h"
 #include "passes.h"
+#include "passProfile.h"
 #include "resolution.h"
 #include "resolveFunction.h"
 #include "resolveIntents.h"
@@ -1710,7 +1711,12 @@ static FnSymbol* promotionWrap(FnSymbol* fn,
 
   retval = checkCache(promotionsCache, promotion.fn, &promotion.subs);
 
-  if (retval == NULL) {
+  profileCount(PROFILE_PROMOTIONS);
+
+  if (retval != NULL) {
+    profileCount(PROFILE_PROMOTION_CACHE_HITS);
+
+  } else {
     SET_LINENO(info.call);
     BlockStmt* instantiationPt = getInstantiationPoint(info.call);
     retval = buildPromotionWrapper(promotion,
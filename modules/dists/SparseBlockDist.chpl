@@ -46,18 +46,6 @@ config param debugSparseBlockDistBulkTransfer = false;
 // There is no SparseBlock distribution class. Instead, we
 // just use Block.
 
-// Helper type for sorting locales
-record TargetLocaleComparator {
-  param rank;
-  type idxType;
-  type sparseLayoutType;
-  var dist: unmanaged Block(rank, idxType, sparseLayoutType);
-  proc key(a: index(rank, idxType)) {
-    return (dist.targetLocsIdx(a), a);
-  }
-}
-
-
 //
 // SparseBlock Domain Class
 //
@@ -137,46 +125,67 @@ class SparseBlockDom: BaseSparseDomImpl {
     return max reduce ([l in locDoms] l.mySparseBlock.last);
   }
 
-  override proc bulkAdd_help(inds: [] index(rank,idxType),
+  // Routes the indices to the locales that own them without sorting them
+  // first: each task counts the indices of a chunk of 'inds' bound for each
+  // locale, a prefix sum over those counts gives every (locale, task) pair
+  // its own part of a buffer grouped by locale, and the tasks then copy
+  // their indices there.  Each locale fetches its group in one bulk
+  // transfer and adds it to its local block, which sorts it in parallel.
+  // The copy keeps the indices' order, so sorted input stays sorted.
+  override proc bulkAdd_help(inds: [?indsDom] index(rank,idxType),
       dataSorted=false, isUnique=false) {
-    use Sort;
-    use Search;
+    use RangeChunk;
 
-    // without _new_, record functions throw null deref
-    var comp = new TargetLocaleComparator(rank=rank, idxType=idxType,
-                                          sparseLayoutType=sparseLayoutType,
-                                          dist=dist);
+    const numLocs = dist.targetLocDom.size;
+    const numChunks = max(1, _computeNumChunks(indsDom.size));
+    const indsRange = indsDom.dim(1);
 
-    if !dataSorted then sort(inds, comparator=comp);
+    // the position of the locale that owns index i in targetLocDom
+    inline proc locOrder(i) {
+      return dist.targetLocDom.indexOrder(dist.targetLocsIdx(i));
+    }
 
-    var localeRanges: [dist.targetLocDom] range;
-    on inds {
-      for l in dist.targetLocDom {
-        const _first = locDoms[l].mySparseBlock._value.parentDom.first;
-        const _last = locDoms[l].mySparseBlock._value.parentDom.last;
+    var offsets: [0..#numLocs, 0..#numChunks] int;
 
-        var (foundFirst, locFirst) = binarySearch(inds, _first, comp);
-        var (foundLast, locLast) = binarySearch(inds, _last, comp);
+    coforall tid in 0..#numChunks with (ref offsets) {
+      for i in chunk(indsRange, numChunks, tid) do
+        offsets[locOrder(inds[i]), tid] += 1;
+    }
 
-        if !foundLast then locLast -= 1;
+    // Turn the counts into the start of each task's part of each locale's
+    // group, and note where the groups start
+    var localeStarts: [0..numLocs] int;
+    var sum = 0;
+    for l in 0..#numLocs {
+      localeStarts[l] = sum;
+      for tid in 0..#numChunks {
+        const count = offsets[l, tid];
+        offsets[l, tid] = sum;
+        sum += count;
+      }
+    }
+    localeStarts[numLocs] = sum;
 
-        // two ifs are necessary to catch out of bounds in the bulkAdd call
-        // chain. otherwise this methods would cutoff indices that are smaller
-        // than parentDom.first or larger than parentDom.last, which is
-        // _probably_ not desirable.
-        if dist.targetLocDom.first == l then
-          locFirst = inds.domain.first;
-        if dist.targetLocDom.last == l then
-          locLast = inds.domain.last;
+    var routed: [0..#indsDom.size] index(rank, idxType);
 
-        localeRanges[l] = locFirst..locLast;
+    coforall tid in 0..#numChunks with (ref offsets) {
+      for i in chunk(indsRange, numChunks, tid) {
+        const l = locOrder(inds[i]);
+        routed[offsets[l, tid]] = inds[i];
+        offsets[l, tid] += 1;
       }
     }
+
     var _totalAdded: atomic int;
-    coforall l in dist.targetLocDom do on dist.targetLocales[l] {
-      const _retval = locDoms[l].mySparseBlock.bulkAdd(inds[localeRanges[l]],
-          dataSorted=true, isUnique=false);
-      _totalAdded.add(_retval);
+    coforall (l, locOrd) in zip(dist.targetLocDom, 0..) do on dist.targetLocales[l] {
+      const myRange = localeStarts[locOrd]..localeStarts[locOrd+1]-1;
+      if myRange.size > 0 {
+        var myInds: [0..#myRange.size] index(rank, idxType);
+        myInds = routed[myRange];
+        const _retval = locDoms[l].mySparseBlock.bulkAdd(myInds,
+            dataSorted=dataSorted, isUnique=isUnique, preserveInds=false);
+        _totalAdded.add(_retval);
+      }
     }
     const _retval = _totalAdded.read();
     nnz += _retval;
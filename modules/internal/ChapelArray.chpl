@@ -167,10 +167,6 @@ module ChapelArray {
   use ArrayViewRankChange;
   use ArrayViewReindex;
 
-  // Explicitly use a processor atomic, as most calls to this function are
-  // likely be on locale 0
-  pragma "no doc"
-  var numPrivateObjects: chpl__processorAtomicType(int);
   pragma "no doc"
   param nullPid = -1;
 
@@ -213,6 +209,8 @@ module ChapelArray {
   //    relatively low overhead, adds work to Locale 0 that is not present on
   //    the other locales, and again would be surprising if a Block array were
   //    created over other locales only (say, Locales[2] and Locales[3]).
+  //    Locale 0 reuses the ids of freed objects, so that the tables on each
+  //    locale stay as small as the number of privatized objects alive.
 
   // Given a dsi Dist/Dom/Array, create an pid integer identifying the
   // privatized version on all locales; and populate each locale
@@ -220,12 +218,15 @@ module ChapelArray {
   // without communication.
   proc _newPrivatizedClass(value) : int {
 
-    const n = numPrivateObjects.fetchAdd(1);
+    var n: int;
 
     const hereID = here.id;
     const privatizeData = value.dsiGetPrivatizeData();
-    on Locales[0] do
+    on Locales[0] {
+      extern proc chpl_privatization_allocPid(): int;
+      n = chpl_privatization_allocPid();
       _newPrivatizedClassHelp(value, value, n, hereID, privatizeData);
+    }
 
     proc _newPrivatizedClassHelp(parentValue, originalValue, n, hereID, privatizeData) {
       var newValue = originalValue;
@@ -259,6 +260,10 @@ module ChapelArray {
 
     on Locales[0] {
       _freePrivatizedClassHelp(pid, original);
+
+      // Every locale has cleared pid now, so it can be handed out again.
+      extern proc chpl_privatization_releasePid(pid:int);
+      chpl_privatization_releasePid(pid);
     }
 
     proc _freePrivatizedClassHelp(pid, original) {
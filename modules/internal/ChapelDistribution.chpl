@@ -454,16 +454,55 @@ module ChapelDistribution {
       }
     }
 
-    inline proc _countDuplicates(arr) where isArray(arr) {
-      var dupCount = -1;
-      var prev = arr[arr.domain.low];
-      for a in arr {
-        if a == prev then
-          dupCount += 1;
-        else
-          prev = a;;
+    // Replaces each entry of 'ranks' that is not -1 by the number of such
+    // entries up to and including it, and returns how many there are.  Each
+    // task counts a contiguous chunk, and a prefix sum over the tasks'
+    // counts gives the rank each chunk starts from.
+    proc _bulkAddScan(ref ranks: [?D] int): int {
+      use DSIUtil, RangeChunk;
+
+      const numChunks = max(1, _computeNumChunks(D.size));
+      const inds = D.dim(1);
+      var chunkCounts: [0..#numChunks] int;
+
+      coforall tid in 0..#numChunks with (ref chunkCounts) {
+        var count = 0;
+        for i in chunk(inds, numChunks, tid) do
+          if ranks[i] != -1 then count += 1;
+        chunkCounts[tid] = count;
       }
-      return dupCount;
+
+      var total = 0;
+      for count in chunkCounts {
+        const c = count;
+        count = total;
+        total += c;
+      }
+
+      coforall tid in 0..#numChunks {
+        var rank = chunkCounts[tid];
+        for i in chunk(inds, numChunks, tid) {
+          if ranks[i] != -1 {
+            rank += 1;
+            ranks[i] = rank;
+          }
+        }
+      }
+
+      return total;
+    }
+
+    // For sorted 'inds', sets ranks[i] to the position of inds[i] among the
+    // distinct indices if it is the first of a run of equal indices, or to
+    // -1 otherwise.  Returns the number of distinct indices.
+    proc _bulkAddDistinctRanks(inds: [?indsDom], isUnique,
+                               ref ranks: [indsDom] int): int {
+      if !isUnique then
+        forall i in indsDom do
+          if i != indsDom.low && inds[i] == inds[i - indsDom.stride] then
+            ranks[i] = -1;
+
+      return _bulkAddScan(ranks);
     }
 
     // (1) sorts indices if !dataSorted
@@ -481,19 +520,18 @@ module ChapelDistribution {
 
         //check duplicates assuming sorted
         if isUnique {
-          const indsStart = inds.domain.low;
-          const indsEnd = inds.domain.high;
-          var lastInd = inds[indsStart];
-          for i in indsStart+1..indsEnd {
-            if inds[i] == lastInd then
-              halt("bulkAdd: There are duplicates, call the function \
-                  with isUnique=false");
-            else lastInd = inds[i];
-          }
+          const indsDom = inds.domain;
+          var hasDuplicates = false;
+          forall i in indsDom with (|| reduce hasDuplicates) do
+            if i != indsDom.low && inds[i] == inds[i - indsDom.stride] then
+              hasDuplicates = true;
+          if hasDuplicates then
+            halt("bulkAdd: There are duplicates, call the function \
+                with isUnique=false");
         }
 
         //check OOB
-        for i in inds do boundsCheck(i);
+        forall i in inds do boundsCheck(i);
       }
     }
 
@@ -510,34 +548,23 @@ module ChapelDistribution {
       var actualInsertPts: [inds.domain] int; //where to put in newdom
 
       //eliminate duplicates --assumes sorted
-      if !isUnique {
-        //make sure lastInd != inds[inds.domain.low]
-        var lastInd = inds[inds.domain.low] + 1;
-        for (i, p) in zip(inds, indivInsertPts)  {
-          if i == lastInd then p = -1;
-          else lastInd = i;
-        }
-      }
-
-      forall (i,p) in zip(inds, indivInsertPts) {
-        if isUnique || p != -1 { //don't do anything if it's duplicate
-          const (found, insertPt) = d.find(i);
+      const indsDom = inds.domain;
+      forall (i,p) in zip(indsDom, indivInsertPts) {
+        if !isUnique && i != indsDom.low && inds[i] == inds[i - indsDom.stride] then
+          p = -1; //duplicate within inds
+        else {
+          const (found, insertPt) = d.find(inds[i]);
           p = if found then -1 else insertPt; //mark as duplicate
         }
       }
 
       //shift insert points for bulk addition
       //previous indexes that are added will cause a shift in the next indexes
-      var actualAddCnt = 0;
+      var addRanks = indivInsertPts;
+      const actualAddCnt = _bulkAddScan(addRanks);
 
-      //NOTE: this can also be done with scan
-      for (ip, ap) in zip(indivInsertPts, actualInsertPts) {
-        if ip != -1 {
-          ap = ip + actualAddCnt;
-          actualAddCnt += 1;
-        }
-        else ap = ip;
-      }
+      forall (ip, ap, r) in zip(indivInsertPts, actualInsertPts, addRanks) do
+        ap = if ip != -1 then ip + r - 1 else -1;
 
       return (actualInsertPts, actualAddCnt);
     }
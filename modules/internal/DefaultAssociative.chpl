@@ -25,6 +25,15 @@ module DefaultAssociative {
   config param debugDefaultAssoc = false;
   config param debugAssocDataPar = false;
 
+  // Number of lock stripes a parSafe associative domain uses so that
+  // adds, removes and lookups of different indices can run concurrently.
+  // Setting this to 0 protects the whole table with a single lock.
+  config param defaultAssocLockStripes = 64;
+
+  proc chpl__assocLockStripes(param parSafe: bool) param
+    return if parSafe && defaultAssocLockStripes > 0
+           then defaultAssocLockStripes else 0;
+
   // TODO: make the domain parameterized by this?
   type chpl_table_index_type = int;
 
@@ -67,13 +76,68 @@ module DefaultAssociative {
     var tableSize : int;
     var tableDom = {0..tableSize-1};
     var table: [tableDom] chpl_TableEntry(idxType);
-  
+
+    // With striped locking, 'tableGate' is a readers-writer gate: it is
+    // held shared (count > 0) by operations on individual indices and
+    // exclusively (-1) by lockTable() for anything that restructures the
+    // table.  Operations on one index also hold that index's key stripe,
+    // and a free slot is only claimed while holding its slot stripe.
+    var tableGate: chpl__processorAtomicType(int); // do not access directly
+    var keyLocks: [0..#chpl__assocLockStripes(parSafe)]
+                  chpl__processorAtomicType(bool);
+    var slotLocks: [0..#chpl__assocLockStripes(parSafe)]
+                   chpl__processorAtomicType(bool);
+
+    proc stripedLocking param return chpl__assocLockStripes(parSafe) > 0;
+
     inline proc lockTable() {
-      while tableLock.testAndSet(memory_order_acquire) do chpl_task_yield();
+      if stripedLocking {
+        while !tableGate.compareExchangeWeak(0, -1, memory_order_acquire) do
+          chpl_task_yield();
+      } else {
+        while tableLock.testAndSet(memory_order_acquire) do chpl_task_yield();
+      }
     }
   
     inline proc unlockTable() {
-      tableLock.clear(memory_order_release);
+      if stripedLocking then
+        tableGate.write(0, memory_order_release);
+      else
+        tableLock.clear(memory_order_release);
+    }
+
+    // Lets other index operations proceed concurrently, but not
+    // anything that holds lockTable().
+    inline proc lockTableShared() {
+      if stripedLocking {
+        while true {
+          const g = tableGate.read(memory_order_relaxed);
+          if g >= 0 &&
+             tableGate.compareExchangeWeak(g, g+1, memory_order_acquire) then
+            break;
+          chpl_task_yield();
+        }
+      } else {
+        lockTable();
+      }
+    }
+
+    inline proc unlockTableShared() {
+      if stripedLocking then
+        tableGate.sub(1, memory_order_release);
+      else
+        unlockTable();
+    }
+
+    inline proc _lockStripe(ref locks, n: int) {
+      const stripe = n % locks.size;
+      while locks[stripe].testAndSet(memory_order_acquire) do
+        chpl_task_yield();
+      return stripe;
+    }
+
+    inline proc _unlockStripe(ref locks, stripe: int) {
+      locks[stripe].clear(memory_order_release);
     }
   
     // TODO: An ugly [0..-1] domain appears several times in the code --
@@ -304,22 +368,91 @@ module DefaultAssociative {
       const inSlot = slotNum;
       var retVal = 0;
       on this {
-        const shouldLock = needLock && parSafe;
-        if shouldLock then lockTable();
-        var findAgain = shouldLock;
-        if ((numEntries.read()+1)*2 > tableSize) {
-          _resize(grow=true);
-          findAgain = true;
+        if stripedLocking && needLock {
+          (slotNum, retVal) = _addStriped(idx);
+        } else {
+          const shouldLock = needLock && parSafe;
+          if shouldLock then lockTable();
+          var findAgain = shouldLock;
+          if ((numEntries.read()+1)*2 > tableSize) {
+            _resize(grow=true);
+            findAgain = true;
+          }
+          if findAgain then
+            (slotNum, retVal) = _add(idx, -1);
+          else
+            (_, retVal) = _add(idx, inSlot);
+          if shouldLock then unlockTable();
         }
-        if findAgain then
-          (slotNum, retVal) = _add(idx, -1);
-        else
-          (_, retVal) = _add(idx, inSlot);
-        if shouldLock then unlockTable();
       }
       return (slotNum, retVal);
     }
 
+    // Adds 'idx' holding the table gate shared, so that adds of indices
+    // in different key stripes proceed in parallel.  Growing the table
+    // still takes it exclusively.
+    proc _addStriped(idx: idxType) {
+      var fullAtSizeNum = -1;
+      while true {
+        if tableSizeNum == fullAtSizeNum ||
+           (numEntries.read()+1)*2 > tableSize {
+          lockTable();
+          if tableSizeNum == fullAtSizeNum ||
+             (numEntries.read()+1)*2 > tableSize then
+            _resize(grow=true);
+          unlockTable();
+        }
+
+        lockTableShared();
+        const stripe = _lockStripe(keyLocks, chpl__defaultHashWrapper(idx));
+        var (found, slotNum) = _findFilledSlot(idx, needLock=false);
+        var added = 0;
+        if !found then
+          (slotNum, added) = _claimSlot(idx);
+        _unlockStripe(keyLocks, stripe);
+        unlockTableShared();
+
+        if slotNum != -1 then return (slotNum, added);
+
+        // Concurrent adds filled the probe sequence before anyone grew
+        // the table.
+        if postponeResize then
+          halt("couldn't add ", idx, " -- ", numEntries.read(), " / ", tableSize, " taken");
+        fullAtSizeNum = tableSizeNum;
+      }
+      return (-1, 0); // unreachable
+    }
+
+    // Stores 'idx' in the first free slot along its probe sequence.
+    //
+    // NOTE: Calls to this routine assume that the table gate is held
+    // shared and that the key stripe for 'idx' is held.
+    //
+    pragma "unsafe" // see issue #11666
+    proc _claimSlot(idx: idxType) {
+      for slotNum in _lookForSlots(idx) {
+        if table[slotNum].status == chpl__hash_status.full then continue;
+
+        const stripe = _lockStripe(slotLocks, slotNum);
+        const claimed = table[slotNum].status != chpl__hash_status.full;
+        if claimed {
+          table[slotNum].idx = idx;
+          // unlocked lookups check the status before reading the index
+          chpl_atomic_thread_fence(memory_order_release);
+          table[slotNum].status = chpl__hash_status.full;
+        }
+        _unlockStripe(slotLocks, stripe);
+
+        if claimed {
+          numEntries.add(1);
+          for a in _arrs do
+            a.clearEntry(idx);
+          return (slotNum, 1);
+        }
+      }
+      return (-1, 0);
+    }
+
     // This routine adds new indices without checking the table size and
     //  is thus appropriate for use by routines like _resize().
     //
@@ -353,20 +486,52 @@ module DefaultAssociative {
     proc dsiRemove(idx: idxType) {
       var retval = 1;
       on this {
-        if parSafe then lockTable();
-        const (foundSlot, slotNum) = _findFilledSlot(idx, needLock=!parSafe);
-        if (foundSlot) {
-          for a in _arrs do
-            a.clearEntry(idx);
-          table[slotNum].status = chpl__hash_status.deleted;
-          numEntries.sub(1);
+        if stripedLocking {
+          retval = _removeStriped(idx);
         } else {
-          retval = 0;
+          if parSafe then lockTable();
+          const (foundSlot, slotNum) = _findFilledSlot(idx, needLock=!parSafe);
+          if (foundSlot) {
+            for a in _arrs do
+              a.clearEntry(idx);
+            table[slotNum].status = chpl__hash_status.deleted;
+            numEntries.sub(1);
+          } else {
+            retval = 0;
+          }
+          if (numEntries.read()*8 < tableSize && tableSizeNum > 1) {
+            _resize(grow=false);
+          }
+          if parSafe then unlockTable();
         }
+      }
+      return retval;
+    }
+
+    proc _removeStriped(idx: idxType) {
+      var retval = 1;
+      lockTableShared();
+      const stripe = _lockStripe(keyLocks, chpl__defaultHashWrapper(idx));
+      const (foundSlot, slotNum) = _findFilledSlot(idx, needLock=false);
+      if (foundSlot) {
+        for a in _arrs do
+          a.clearEntry(idx);
+        // Only the holder of the key stripe changes a full slot, and
+        // _claimSlot() rechecks the status under the slot stripe.
+        table[slotNum].status = chpl__hash_status.deleted;
+        numEntries.sub(1);
+      } else {
+        retval = 0;
+      }
+      _unlockStripe(keyLocks, stripe);
+      unlockTableShared();
+
+      if (numEntries.read()*8 < tableSize && tableSizeNum > 1) {
+        lockTable();
         if (numEntries.read()*8 < tableSize && tableSizeNum > 1) {
           _resize(grow=false);
         }
-        if parSafe then unlockTable();
+        unlockTable();
       }
       return retval;
     }
@@ -490,7 +655,7 @@ module DefaultAssociative {
     // Returns true if found, along with the first open slot that may be
     // re-used for faster addition to the domain
     proc _findFilledSlot(idx: idxType, needLock = true) : (bool, index(tableDom)) {
-      if parSafe && needLock then lockTable();
+      if parSafe && needLock then lockTableShared();
       var firstOpen = -1;
       for slotNum in _lookForSlots(idx, table.domain.high+1) {
         const slotStatus = table[slotNum].status;
@@ -498,18 +663,18 @@ module DefaultAssociative {
         // be found past this point.
         if (slotStatus == chpl__hash_status.empty) {
           if firstOpen == -1 then firstOpen = slotNum;
-          if parSafe && needLock then unlockTable();
+          if parSafe && needLock then unlockTableShared();
           return (false, firstOpen);
         } else if (slotStatus == chpl__hash_status.full) {
           if (table[slotNum].idx == idx) {
-            if parSafe && needLock then unlockTable();
+            if parSafe && needLock then unlockTableShared();
             return (true, slotNum);
           }
         } else { // this entry was removed, but is the first slot we could use
           if firstOpen == -1 then firstOpen = slotNum;
         }
       }
-      if parSafe && needLock then unlockTable();
+      if parSafe && needLock then unlockTableShared();
       return (false, -1);
     }
 
@@ -247,28 +247,18 @@ module DefaultSparse {
 
       if nnz == 0 {
 
-        const dupCount = if isUnique then 0 else _countDuplicates(inds);
+        var ranks: [indsDom] int;
+        const addCnt = _bulkAddDistinctRanks(inds, isUnique, ranks);
 
-        nnz += inds.size-dupCount;
+        nnz += addCnt;
         _bulkGrow();
 
-        var indIdx = indices.domain.low;
-        var prevIdx = parentDom.low - 1;
+        // each distinct index goes to its rank among them
+        const indIdx = indices.domain.low - 1;
+        forall (i, r) in zip(inds, ranks) do
+          if r != -1 then indices[indIdx + r] = i;
 
-        if isUnique {
-          indices[indices.domain.low..#inds.size]=inds;
-          return inds.size;
-        }
-        else {
-          for i in inds {
-            if i == prevIdx then continue;
-            else prevIdx = i;
-
-            indices[indIdx] = i;
-            indIdx += 1;
-          }
-          return indIdx-1;
-        }
+        return addCnt;
       }
 
       const (actualInsertPts, actualAddCnt) =
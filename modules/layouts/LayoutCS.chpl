@@ -379,53 +379,37 @@ class CSDom: BaseSparseDomImpl {
 
     if nnz == 0 {
 
-      const dupCount = if isUnique then 0 else _countDuplicates(inds);
+      var ranks: [indsDom] int;
+      const addCnt = _bulkAddDistinctRanks(inds, isUnique, ranks);
 
-      nnz += inds.size-dupCount;
+      nnz += addCnt;
       _bulkGrow();
 
-      var idxIdx = 1;
-      var prevIdx = parentDom.low - (1,1);
-      var current: idxType;
-
-      if this.compressRows then
-        current = parentDom.dim(1).low;
-      else
-        current = parentDom.dim(2).low;
-
-      // Update startIdx && idx
-      for (i,j) in inds {
-        if !isUnique && (i,j) == prevIdx then continue;
-        else prevIdx = (i,j);
-
-        if this.compressRows {
-          while i != current {
-            current += 1;
-            startIdx[current+1] = startIdx[current];
-          }
-          startIdx[i+1] += 1;
-          idx[idxIdx] = j;
-          idxIdx += 1;
-        } else {
-          while j != current {
-            current += 1;
-            startIdx[current+1] = startIdx[current];
-          }
-          startIdx[j+1] += 1;
-          idx[idxIdx] = i;
-          idxIdx += 1;
+      // The indices are sorted by row (column), so each row (column) starts
+      // at the first distinct index past the row (column) of the one before
+      // it, and those in between are empty.  Each distinct index fills in
+      // idx and the starts of the rows (columns) up to its own.
+      param major = if this.compressRows then 1 else 2,
+            minor = if this.compressRows then 2 else 1;
+      const majorLow = parentDom.dim(major).low;
+
+      forall (i, ind, r) in zip(indsDom, inds, ranks) {
+        if r != -1 {
+          idx[r] = ind[minor];
+
+          const prevMajor = if i == indsDom.low then majorLow - 1
+                            else inds[i - indsDom.stride][major];
+          for rc in prevMajor+1..ind[major] do
+            startIdx[rc] = r;
         }
       }
 
+      // Rows (columns) past the last index are empty
+      const lastMajor = if addCnt == 0 then majorLow - 1
+                        else inds[indsDom.high][major];
+      startIdx[lastMajor+1..startIdxDom.high] = addCnt + 1;
 
-      // make sure startIdx[i]>startIdx[j] for i>j for possibly
-      // untouched part of startIdx
-      const startIdxHigh = startIdx[current+1];
-      for r in current+2..startIdx.domain.high {
-        startIdx[r] = startIdxHigh;
-      }
-
-      return idxIdx-1;
+      return addCnt;
     } // if nnz == 0
 
     const (actualInsertPts, actualAddCnt) =
@@ -532,8 +532,22 @@ proc _array.elementDiv(A: [?Adom]) where isDenseArr(A) && isDenseArr(this) {
       Dense matrix-matrix and matrix-vector multiplication will utilize the
       :mod:`BLAS` module for improved performance, if available. Compile with
       ``--set blasImpl=none`` to opt out of the :mod:`BLAS` implementation.
+      Otherwise, and for element types that :mod:`BLAS` does not support,
+      a native cache-blocked implementation is used.
+
+    .. note::
+
+      When both ``A`` and ``B`` are matrices distributed such that each
+      locale owns a single block of them, such as with ``Block``, their
+      product is computed by each locale for the block of the result that
+      it owns.  The result is distributed like ``A``.  A distributed
+      matrix can't be multiplied by a local array or by a vector.
 */
-proc dot(A: [?Adom] ?eltType, B: [?Bdom] eltType) where isDenseArr(A) && isDenseArr(B) {
+proc dot(A: [?Adom] ?eltType, B: [?Bdom] eltType)
+  where (isDenseArr(A) || _isDistributedMatrix(A)) &&
+        (isDenseArr(B) || _isDistributedMatrix(B)) {
+  if _isDistributedMatrix(A) != _isDistributedMatrix(B) then
+    compilerError("dot() of a distributed matrix requires another distributed matrix");
   // vector-vector
   if Adom.rank == 1 && Bdom.rank == 1 then
     return inner(A, B);
@@ -551,7 +565,11 @@ proc dot(A: [?Adom] ?eltType, B: [?Bdom] eltType) where isDenseArr(A) && isDense
     ``--set blasImpl=none`` to opt out of the :mod:`BLAS` implementation.
 
 */
-proc _array.dot(A: []) where isDenseArr(this) && isDenseArr(A) {
+proc _array.dot(A: [])
+  where (isDenseArr(this) || _isDistributedMatrix(this)) &&
+        (isDenseArr(A) || _isDistributedMatrix(A)) {
+  if _isDistributedMatrix(this) != _isDistributedMatrix(A) then
+    compilerError("dot() of a distributed matrix requires another distributed matrix");
   return LinearAlgebra.dot(this, A);
 }
 
@@ -626,9 +644,13 @@ private proc _matmatMult(A: [?Adom] ?eltType, B: [?Bdom] eltType)
   if Adom.shape(2) != Bdom.shape(1) then
     halt("Mismatched shape in matrix-matrix multiplication");
 
-  var C: [Adom.dim(1), Bdom.dim(2)] eltType;
-  BLAS.gemm(A, B, C, 1:eltType, 0:eltType);
-  return C;
+  if _isDistributedMatrix(A) && _isDistributedMatrix(B) {
+    return _matmatMultDist(A, B);
+  } else {
+    var C: [Adom.dim(1), Bdom.dim(2)] eltType;
+    BLAS.gemm(A, B, C, 1:eltType, 0:eltType);
+    return C;
+  }
 }
 
 
@@ -655,6 +677,14 @@ proc outer(A: [?Adom] ?eltType, B: [?Bdom] eltType) {
 }
 
 
+/* Tile sizes of the native matrix multiplication kernels */
+private param matmatTileRows = 64,    // rows of C computed by a task
+              matmatTileCols = 64,    // columns of C computed by a task
+              matmatTileDepth = 256,  // inner dimension of one pass over C
+              matmatPanel = 512,      // inner dimension fetched per panel
+              matvecBlock = 512;      // elements of Y computed by a task
+
+
 pragma "no doc"
 /* Generic matrix-vector multiplication. */
 proc _matvecMult(A: [?Adom] ?eltType, X: [?Xdom] eltType, trans=false)
@@ -668,17 +698,57 @@ proc _matvecMult(A: [?Adom] ?eltType, X: [?Xdom] eltType, trans=false)
 
   var Y: [Ydom] eltType;
 
-  // naive algorithm
   if !trans {
     if Adom.shape(2) != Xdom.shape(1) then
       halt("Mismatched shape in matrix-vector multiplication");
-    forall i in Ydom do
-      Y[i] = + reduce (A[i,..]*X[..]);
   } else {
     if Adom.shape(1) != Xdom.shape(1) then
       halt("Mismatched shape in matrix-vector multiplication");
-    forall i in Ydom do
-      Y[i] = + reduce (A[.., i]*X[..]);
+  }
+
+  if Adom.stridable {
+    // naive algorithm
+    if !trans {
+      forall i in Ydom do
+        Y[i] = + reduce (A[i,..]*X[..]);
+    } else {
+      forall i in Ydom do
+        Y[i] = + reduce (A[.., i]*X[..]);
+    }
+    return Y;
+  }
+
+  const rows = Adom.dim(1),
+        cols = Adom.dim(2);
+
+  // A 0-based local copy of X, read with unit stride by the inner loops
+  const XP: [0..#Xdom.size] eltType = X;
+
+  if !trans {
+    // Y[i] is the dot product of row i of A with X
+    forall (y, i) in zip(Y, rows) {
+      var sum: eltType;
+      for k in 0..#cols.size do
+        sum += A[i, cols.low + k] * XP[k];
+      y = sum;
+    }
+  } else {
+    // Accumulate rows of A scaled by X into one block of Y at a time, so
+    // that A is read along its rows
+    forall b in 0..#divceil(cols.size, matvecBlock) {
+      const jLo = b * matvecBlock,
+            jHi = min(jLo + matvecBlock, cols.size) - 1;
+      var sum: [jLo..jHi] eltType;
+
+      for k in 0..#rows.size {
+        const x = XP[k];
+        for j in jLo..jHi do
+          sum[j] += A[rows.low + k, cols.low + j] * x;
+      }
+
+      for j in jLo..jHi do
+        Y[cols.low + j] = sum[j];
+    }
   }
 
   return Y;
@@ -692,12 +762,193 @@ proc _matmatMult(A: [?Adom] ?eltType, B: [?Bdom] eltType)
 {
   if Adom.rank != 2 || Bdom.rank != 2 then
     compilerError("Rank sizes are not 2 and 2");
+  if Adom.shape(2) != Bdom.shape(1) then
+    halt("Mismatched shape in matrix-matrix multiplication");
 
-  var C: [Adom.dim(1), Bdom.dim(2)] eltType;
+  if _isDistributedMatrix(A) && _isDistributedMatrix(B) {
+    return _matmatMultDist(A, B);
+  } else {
+    var C: [Adom.dim(1), Bdom.dim(2)] eltType;
+
+    const M = Adom.shape(1),
+          N = Bdom.shape(2),
+          K = Adom.shape(2);
+
+    if M == 0 || N == 0 || K == 0 then
+      return C;
+
+    // Pack A, and B transposed, into 0-based local arrays so that the
+    // kernel reads both along their rows
+    var AP: [0..#M, 0..#K] eltType = A;
+    var BT: [0..#N, 0..#K] eltType;
+    forall ((k, j), b) in zip({0..#K, 0..#N}, B) do
+      BT[j, k] = b;
+
+    if C.domain.stridable {
+      var CP: [0..#M, 0..#N] eltType;
+      _matmatKernel(M, N, K, c_ptrTo(AP), c_ptrTo(BT), c_ptrTo(CP));
+      C = CP;
+    } else {
+      _matmatKernel(M, N, K, c_ptrTo(AP), c_ptrTo(BT), c_ptrTo(C));
+    }
+
+    return C;
+  }
+}
 
-  // naive algorithm
-  forall (i,j) in C.domain do
-    C[i,j] = + reduce (A[i,..]*B[..,j]);
+
+/*
+  Compute C += A * transpose(BT), where A is M x K, BT is N x K and C is M x N,
+  and all three are stored contiguously in row-major order.
+
+  C is split into tiles that are computed in parallel.  Each tile is
+  updated by slices of the inner dimension that keep its rows of A and BT
+  in cache, and its elements are computed two rows by two columns at a time
+  so that each element loaded is used twice.
+*/
+private proc _matmatKernel(M: int, N: int, K: int,
+                           A: c_ptr(?eltType), BT: c_ptr(eltType),
+                           C: c_ptr(eltType)) {
+  const tiles = {0..#divceil(M, matmatTileRows),
+                 0..#divceil(N, matmatTileCols)};
+
+  forall (ti, tj) in tiles {
+    const iLo = ti * matmatTileRows,
+          iHi = min(iLo + matmatTileRows, M) - 1,
+          jLo = tj * matmatTileCols,
+          jHi = min(jLo + matmatTileCols, N) - 1;
+
+    for kLo in 0..K-1 by matmatTileDepth {
+      const kHi = min(kLo + matmatTileDepth, K) - 1;
+
+      for i in iLo..iHi by 2 {
+        const a0 = A + i * K,
+              c0 = C + i * N;
+
+        if i == iHi {
+          // a final single row
+          for j in jLo..jHi {
+            const b0 = BT + j * K;
+            var c00: eltType;
+            for k in kLo..kHi do
+              c00 += a0[k] * b0[k];
+            c0[j] += c00;
+          }
+          continue;
+        }
+
+        const a1 = a0 + K,
+              c1 = c0 + N;
+
+        for j in jLo..jHi by 2 {
+          const b0 = BT + j * K;
+
+          if j == jHi {
+            // a final single column
+            var c00, c10: eltType;
+            for k in kLo..kHi {
+              c00 += a0[k] * b0[k];
+              c10 += a1[k] * b0[k];
+            }
+            c0[j] += c00;
+            c1[j] += c10;
+            continue;
+          }
+
+          const b1 = b0 + K;
+          var c00, c01, c10, c11: eltType;
+          for k in kLo..kHi {
+            const x0 = a0[k],
+                  x1 = a1[k],
+                  y0 = b0[k],
+                  y1 = b1[k];
+            c00 += x0 * y0;
+            c01 += x0 * y1;
+            c10 += x1 * y0;
+            c11 += x1 * y1;
+          }
+          c0[j]   += c00;
+          c0[j+1] += c01;
+          c1[j]   += c10;
+          c1[j+1] += c11;
+        }
+      }
+    }
+  }
+}
+
+
+/*
+  Is A a matrix distributed such that each locale owns a single block of
+  it, as with ``Block``?
+*/
+private proc _isDistributedMatrix(A: [?D]) param {
+  use Reflection;
+
+  if isRectangularDom(D) && D.rank == 2 && !D.stridable &&
+     !D._value.isDefaultRectangular() {
+    if canResolveMethod(D._value, "dsiHasSingleLocalSubdomain") then
+      return D.hasSingleLocalSubdomain();
+  }
+  return false;
+}
+
+
+/*
+  Distributed matrix-matrix multiplication in the style of SUMMA.  C is
+  Block-distributed over A's target locales.  Each locale computes the
+  block of C that it owns, fetching the rows of A and columns of B it
+  needs one panel of the inner dimension at a time, with one bulk transfer
+  per panel of each.
+*/
+private proc _matmatMultDist(A: [?Adom] ?eltType, B: [?Bdom] eltType) {
+  use BlockDist;
+
+  // C's own bounds, not A's, decide how its columns are split.  Block
+  // needs a non-empty bounding box even when C is empty.
+  const rows = Adom.dim(1),
+        cols = Bdom.dim(2),
+        box = {rows.low..#max(1, rows.size), cols.low..#max(1, cols.size)};
+  const Cdom = {rows, cols} dmapped Block(boundingBox=box,
+                                          targetLocales=Adom.targetLocales());
+
+  var C: [Cdom] eltType;
+
+  const K = Adom.shape(2);
+
+  coforall loc in Cdom.targetLocales() do on loc {
+    const myInds = Cdom.localSubdomain(),
+          rows = myInds.dim(1),
+          cols = myInds.dim(2),
+          M = rows.size,
+          N = cols.size;
+
+    if M > 0 && N > 0 && K > 0 {
+      var CP: [0..#M, 0..#N] eltType;
+
+      for kLo in 0..K-1 by matmatPanel {
+        const kSize = min(matmatPanel, K - kLo),
+              aCols = Adom.dim(2).low + kLo..#kSize,
+              bRows = Bdom.dim(1).low + kLo..#kSize;
+
+        var Apanel: [rows, aCols] eltType;
+        var Bpanel: [bRows, cols] eltType;
+
+        Apanel = A[rows, aCols];
+        Bpanel = B[bRows, cols];
+
+        var BT: [0..#N, 0..#kSize] eltType;
+        forall ((k, j), b) in zip({0..#kSize, 0..#N}, Bpanel) do
+          BT[j, k] = b;
+
+        _matmatKernel(M, N, kSize, c_ptrTo(Apanel), c_ptrTo(BT),
+                      c_ptrTo(CP));
+      }
+
+      forall (i, j) in myInds do
+        C[i, j] = CP[i - rows.low, j - cols.low];
+    }
+  }
 
   return C;
 }
@@ -1600,6 +1851,13 @@ module Sparse {
         computes ``dot(transpose(A), B)``, which may not be as efficient as
         passing ``A`` and ``B`` in the reverse order.
 
+      .. note::
+
+        A sparse matrix multiplied by a vector may also be a sparse subdomain
+        of a ``Block`` domain whose ``sparseLayoutType`` is ``CS``.  The
+        result is then ``Block`` distributed along the locales that own the
+        first column (row, for vector-matrix) of the matrix's blocks.
+
   */
   proc dot(A: [?Adom] ?eltType, B: [?Bdom] eltType) where isSparseArr(B) || isSparseArr(A) {
     // Assumes matrix-(vector|matrix) case
@@ -1610,15 +1868,23 @@ module Sparse {
   private proc matMult(A: [?Adom] ?eltType, B: [?Bdom] eltType) where (isSparseArr(A) || isSparseArr(B)) {
     // matrix-vector
     if Adom.rank == 2 && Bdom.rank == 1 {
-      if !isCSArr(A) then
-        halt("Only CSR format is supported for sparse multiplication");
-      return _csrmatvecMult(A, B);
+      if isSparseBlockCSArr(A) then
+        return _csrmatvecMultDist(A, B);
+      else {
+        if !isCSArr(A) then
+          halt("Only CSR format is supported for sparse multiplication");
+        return _csrmatvecMult(A, B);
+      }
     }
     // vector-matrix
     else if Adom.rank == 1 && Bdom.rank == 2 {
-      if !isCSArr(B) then
-        halt("Only CSR format is supported for sparse multiplication");
-      return _csrmatvecMult(B, A, trans=true);
+      if isSparseBlockCSArr(B) then
+        return _csrmatvecMultDist(B, A, trans=true);
+      else {
+        if !isCSArr(B) then
+          halt("Only CSR format is supported for sparse multiplication");
+        return _csrmatvecMult(B, A, trans=true);
+      }
     }
     // matrix-matrix
     else if Adom.rank == 2 && Bdom.rank == 2 {
@@ -1632,7 +1898,9 @@ module Sparse {
   }
 
   /* Compute the dot-product */
-  proc _array.dot(A: []) where isCSArr(A) || isCSArr(this) {
+  proc _array.dot(A: [])
+    where isCSArr(A) || isCSArr(this) ||
+          isSparseBlockCSArr(A) || isSparseBlockCSArr(this) {
     return LinearAlgebra.Sparse.dot(this, A);
   }
 
@@ -1642,6 +1910,44 @@ module Sparse {
   }
 
 
+  /* Non-zeros below which the CSR kernels do not add another task */
+  private param csrTaskNnz = 8192;
+
+  /* Number of tasks the CSR kernels split ``nnz`` non-zeros across */
+  private proc _csrNumTasks(nnz) {
+    const maxTasks = if dataParTasksPerLocale > 0 then dataParTasksPerLocale
+                     else here.maxTaskPar;
+    return max(1, min(maxTasks, nnz / csrTaskNnz));
+  }
+
+  /*
+    Rows of chunk ``tid`` when ``rows`` of a CSR matrix with row pointers
+    ``indPtr`` are split into ``numChunks`` contiguous chunks that hold
+    about the same number of non-zeros, rather than the same number of rows.
+  */
+  private proc _csrRowChunk(const ref indPtr, rows: range, numChunks, tid) {
+    const first = indPtr[rows.low],
+          nnz = indPtr[rows.high+1] - first;
+
+    // First row of chunk t: the first row whose non-zeros start at or after
+    // chunk t's share of them.  The last chunk takes any trailing empty rows.
+    proc chunkStart(t) {
+      if t == numChunks then return rows.high+1;
+
+      const target = first + ((nnz:int * t) / numChunks):first.type;
+      var lo = rows.low,
+          hi = rows.high+1;
+      while lo < hi {
+        const mid = lo + (hi - lo) / 2;
+        if indPtr[mid] < target then lo = mid + 1;
+                                else hi = mid;
+      }
+      return lo;
+    }
+
+    return chunkStart(tid)..chunkStart(tid+1)-1;
+  }
+
   /* CSR Matrix-vector multiplication */
   private proc _csrmatvecMult(A: [?Adom] ?eltType, X: [?Xdom] eltType,
                               trans=false) where isCSArr(A)
@@ -1657,25 +1963,124 @@ module Sparse {
     if !trans {
       if Adom.shape(2) != Xdom.shape(1) then
         halt("Mismatched shape in matrix-vector multiplication");
-        // TODO: Loop over non-zero rows only
-        forall i in Adom.dim(1) {
-          for j in Adom.dimIter(2, i) {
-            Y[i] += A[i, j] * X[j];
-          }
-        }
+      _csrmatvecKernel(A, X, Y, trans=false);
     } else {
       if Adom.shape(1) != Xdom.shape(1) then
         halt("Mismatched shape in matrix-vector multiplication");
 
       // Ensure same domain indices
       ref X2 = X.reindex(Adom.dim(1));
+      _csrmatvecKernel(A, X2, Y, trans=true);
+    }
+    return Y;
+  }
 
-      forall i in Adom.dim(1) with (+ reduce Y) {
-        for j in Adom.dimIter(2, i) {
-          Y[j] += A[i, j] * X2[i];
+  /*
+    Compute ``Y = A * X``, or ``Y = transpose(A) * X`` if ``trans``, walking
+    the row pointers, column indices and values of the CSR array ``A``
+    directly.  ``X`` is indexed like the columns of ``A`` (rows, if
+    ``trans``) and ``Y`` like its rows (columns).  Each task multiplies a
+    contiguous chunk of rows holding about the same number of non-zeros.
+  */
+  private proc _csrmatvecKernel(A: [?Adom] ?eltType, const ref X, ref Y,
+                                trans: bool) {
+    if !Adom._value.compressRows then
+      compilerError("Only CSR format is supported for sparse multiplication");
+
+    /* Aliases for readability */
+    proc _array.indPtr const ref return this.dom.startIdx;
+    proc _array.indices const ref return this.dom.idx;
+
+    const ref indPtr = A.indPtr,
+              indices = A.indices,
+              data = A.data;
+
+    const rows = Adom.dim(1),
+          numTasks = _csrNumTasks(Adom.numIndices);
+
+    if !trans {
+      forall tid in 0..#numTasks {
+        for i in _csrRowChunk(indPtr, rows, numTasks, tid) {
+          var sum: eltType;
+          for k in indPtr[i]..indPtr[i+1]-1 do
+            sum += data[k] * X[indices[k]];
+          Y[i] = sum;
+        }
+      }
+    } else {
+      forall tid in 0..#numTasks with (+ reduce Y) {
+        for i in _csrRowChunk(indPtr, rows, numTasks, tid) {
+          const x = X[i];
+          for k in indPtr[i]..indPtr[i+1]-1 do
+            Y[indices[k]] += data[k] * x;
         }
       }
     }
+  }
+
+  /*
+    Distributed CSR matrix-vector multiplication for a ``SparseBlock`` array
+    whose local blocks use the ``CS`` layout.  ``Y`` is ``Block`` distributed
+    over the first column of target locales (first row, if ``trans``), so
+    that its pieces line up with the rows (columns) of ``A``'s blocks.
+
+    Each locale fetches the piece of ``X`` its block needs with one bulk
+    transfer and multiplies its block locally.  The locales sharing a row
+    (column) of blocks then add their partial results into ``Y`` on its
+    owner, one at a time.
+  */
+  private proc _csrmatvecMultDist(A: [?Adom] ?eltType, X: [?Xdom] eltType,
+                                  trans=false) {
+    use BlockDist;
+
+    if Xdom.rank != 1 then
+      compilerError("Rank sizes are not 2 and 1");
+
+    const xDim = if trans then 1 else 2,
+          yDim = if trans then 2 else 1;
+
+    if Adom.shape(xDim) != Xdom.shape(1) then
+      halt("Mismatched shape in matrix-vector multiplication");
+
+    const dist = Adom._value.dist;
+    const yLocs = if trans then dist.targetLocales[0, ..]
+                           else dist.targetLocales[.., 0];
+    const Ydom = {Adom.dim(yDim)} dmapped Block({dist.boundingBox.dim(yDim)},
+                                                targetLocales=yLocs);
+    var Y: [Ydom] eltType;
+
+    // Serializes the additions into each piece of Y
+    var locks: [0..#yLocs.size] sync bool;
+
+    // Offset from the indices of A to those of X
+    const xOffset = Xdom.dim(1).low - Adom.dim(xDim).low;
+
+    coforall (locIdx, loc) in zip(dist.targetLocDom, dist.targetLocales) do on loc {
+      const ref myA = A._value.locArr[locIdx].myElems;
+      const myDom = myA.domain;
+
+      if myDom.numIndices > 0 {
+        const xInds = myDom.dim(xDim),
+              yInds = myDom.dim(yDim),
+              lockIdx = if trans then locIdx(2) else locIdx(1);
+
+        var myX: [xInds] eltType;
+        myX = X[xInds + xOffset];
+
+        var myY: [yInds] eltType;
+        _csrmatvecKernel(myA, myX, myY, trans);
+
+        on Y[yInds.low] {
+          var partial: [yInds] eltType;
+          partial = myY;
+
+          locks[lockIdx].writeEF(true);
+          Y[yInds] += partial;
+          locks[lockIdx].readFE();
+        }
+      }
+    }
+
     return Y;
   }
 
@@ -1701,13 +2106,15 @@ module Sparse {
     // major axis
     var indPtr: [1..M+1] idxType;
 
-    pass1(A, B, indPtr);
+    const numTasks = _csrNumTasks(ADom.numIndices);
+
+    pass1(A, B, indPtr, numTasks);
 
     const nnz = indPtr[indPtr.domain.last];
     var indices: [1..nnz] idxType;
     var data: [1..nnz] eltType;
 
-    pass2(A, B, indPtr, indices, data);
+    pass2(A, B, indPtr, indices, data, numTasks);
 
     var C = CSRMatrix((M, N), data, indices, indPtr);
 
@@ -1720,11 +2127,14 @@ module Sparse {
 
 
   pragma "no doc"
-  /* Populate indPtr and total nnz (last element of indPtr) */
-  proc pass1(ref A: [?ADom] ?eltType, ref B: [?BDom] eltType, ref indPtr) {
-    // TODO: Parallelize - mask -> atomic ints,
-    //                   - Write a scan to compute idxPtr in O(log(n))
+  /* Populate indPtr and total nnz (last element of indPtr)
 
+     Each of ``numTasks`` tasks counts the non-zeros of a chunk of rows
+     holding about the same number of non-zeros of A, then turns its counts
+     into row pointers once the tasks before it have been accounted for.
+  */
+  proc pass1(ref A: [?ADom] ?eltType, ref B: [?BDom] eltType, ref indPtr,
+             numTasks = 1) {
     /* Aliases for readability */
     proc _array.indPtr ref return this.dom.startIdx;
     proc _array.indices ref return this.dom.idx;
@@ -1732,40 +2142,63 @@ module Sparse {
     const (M, K1) = A.shape,
           (K2, N) = B.shape;
     type idxType = ADom.idxType;
-    var mask: [1..N] idxType;
-    indPtr[1] = 1;
-    var nnz = 1: idxType;
 
-    // Rows of C
-    for i in 1..M {
-      var row_nnz = 0;
-      const Arange = A.indPtr[i]..A.indPtr[i+1]-1;
-      // Row pointers of A
-      for jj in Arange {
-        // Column index of A
-        const j = A.indices[jj];
-        const Brange = B.indPtr[j]..B.indPtr[j+1]-1;
-        // Row pointers of B
-        for kk in Brange {
-          // Column index of B
-          var k = B.indices[kk];
-          if mask[k] != i {
-            mask[k] = i;
-            row_nnz += 1;
+    // Non-zeros in the rows of C counted by each task
+    var taskNnz: [0..#numTasks] idxType;
+
+    forall tid in 0..#numTasks {
+      var mask: [1..N] idxType;
+
+      // Rows of C
+      for i in _csrRowChunk(A.indPtr, 1..M, numTasks, tid) {
+        var row_nnz = 0: idxType;
+        const Arange = A.indPtr[i]..A.indPtr[i+1]-1;
+        // Row pointers of A
+        for jj in Arange {
+          // Column index of A
+          const j = A.indices[jj];
+          const Brange = B.indPtr[j]..B.indPtr[j+1]-1;
+          // Row pointers of B
+          for kk in Brange {
+            // Column index of B
+            var k = B.indices[kk];
+            if mask[k] != i {
+              mask[k] = i;
+              row_nnz += 1;
+            }
           }
         }
+
+        // Stash the count until the row pointers are known
+        indPtr[i+1] = row_nnz;
+        taskNnz[tid] += row_nnz;
       }
+    }
+
+    // Offset of the first non-zero of each task's rows
+    var taskStart: [0..#numTasks] idxType;
+    for tid in 1..numTasks-1 do
+      taskStart[tid] = taskStart[tid-1] + taskNnz[tid-1];
+
+    indPtr[1] = 1;
 
-      nnz = nnz + row_nnz;
-      indPtr[i+1] = nnz;
+    forall tid in 0..#numTasks {
+      var nnz = taskStart[tid] + 1;
+      for i in _csrRowChunk(A.indPtr, 1..M, numTasks, tid) {
+        nnz = nnz + indPtr[i+1];
+        indPtr[i+1] = nnz;
+      }
     }
   }
 
   pragma "no doc"
-  /* Populate indices and data */
-  proc pass2(ref A: [?ADom] ?eltType, ref B: [?BDom] eltType, ref indPtr, ref indices, ref data) {
-    // TODO: Parallelize - next, sums -> task-private stacks
+  /* Populate indices and data
 
+     Each task computes the rows of C for the same chunk of rows as in
+     ``pass1``, with its own ``next`` and ``sums`` stacks.
+  */
+  proc pass2(ref A: [?ADom] ?eltType, ref B: [?BDom] eltType, ref indPtr,
+             ref indices, ref data, numTasks = 1) {
     /* Aliases for readability */
     proc _array.indPtr ref return this.dom.startIdx;
     proc _array.indices ref return this.dom.idx;
@@ -1777,53 +2210,54 @@ module Sparse {
 
     const cols = {1..N};
 
-    var next: [cols] idxType = -1,
-        sums: [cols] eltType;
-
-    var nnz = 1;
-
-    for i in 1..M {
-      var head = 0:idxType,
-          length = 0:idxType;
-
-      // Maps row index (i) -> nnz index of A
-      const Arange = A.indPtr[i]..A.indPtr[i+1]-1;
-      for jj in Arange {
-        // Non-zero column index of A for row i
-        const j = A.indices[jj];
-        const v = A.data[jj];
-
-        // Maps row index (j) -> nnz index of B
-        const Brange = B.indPtr[j]..B.indPtr[j+1]-1;
-        for kk in Brange {
-          // Non-zero column index of B for row j
-          const k = B.indices[kk];
-
-          sums[k] += v*B.data[kk];
-
-          // push k to stack
-          if next[k] == -1 {
-            next[k] = head;
-            head = k;
-            length += 1;
+    forall tid in 0..#numTasks {
+      var next: [cols] idxType = -1,
+          sums: [cols] eltType;
+
+      for i in _csrRowChunk(A.indPtr, 1..M, numTasks, tid) {
+        var head = 0:idxType,
+            length = 0:idxType;
+
+        // Maps row index (i) -> nnz index of A
+        const Arange = A.indPtr[i]..A.indPtr[i+1]-1;
+        for jj in Arange {
+          // Non-zero column index of A for row i
+          const j = A.indices[jj];
+          const v = A.data[jj];
+
+          // Maps row index (j) -> nnz index of B
+          const Brange = B.indPtr[j]..B.indPtr[j+1]-1;
+          for kk in Brange {
+            // Non-zero column index of B for row j
+            const k = B.indices[kk];
+
+            sums[k] += v*B.data[kk];
+
+            // push k to stack
+            if next[k] == -1 {
+              next[k] = head;
+              head = k;
+              length += 1;
+            }
           }
         }
-      }
 
-      // Recounting is faster than accessing 'nnz in indPtr[i]..indPtr[i+1]-1'
-      for 1..length {
-        indices[nnz] = head;
-        data[nnz] = sums[head];
+        // Recounting is faster than accessing 'nnz in indPtr[i]..indPtr[i+1]-1'
+        var nnz = indPtr[i];
+        for 1..length {
+          indices[nnz] = head;
+          data[nnz] = sums[head];
 
-        nnz += 1;
+          nnz += 1;
 
-        // pop next k off stack
-        const temp = head;
-        head = next[head];
+          // pop next k off stack
+          const temp = head;
+          head = next[head];
 
-        // clear stack as we traverse
-        next[temp] = -1;
-        sums[temp] = 0;
+          // clear stack as we traverse
+          next[temp] = -1;
+          sums[temp] = 0;
+        }
       }
     }
   }
@@ -1990,6 +2424,20 @@ module Sparse {
   /* Returns ``true`` if the domain is dmapped to ``CS`` layout. */
   proc isCSDom(D: domain) param { return isCSType(D.dist.type); }
 
+  /*
+    Returns ``true`` if the array is a ``SparseBlock`` array, i.e. a sparse
+    subdomain of a ``Block`` domain, whose local blocks use the ``CS``
+    layout.
+  */
+  private proc isSparseBlockCSArr(A: []) param {
+    use BlockDist;
+
+    if isSparseArr(A) && isSubtype(_to_borrowed(A.domain.dist._value.type), Block) then
+      return isCSType(A.domain.dist._value.sparseLayoutType);
+    else
+      return false;
+  }
+
 } // submodule LinearAlgebra.Sparse
 
 
@@ -418,14 +418,31 @@ proc radixSortOk(Data: [?Dom] ?eltType, comparator) param {
   return false;
 }
 
+// Below this many elements, the comparison sorts and their merge step
+// do not create tasks.
+private param PARALLEL_SORT_MIN = 8192;
+
+// Should the comparison sorts split a part of this size between tasks?
+private inline proc sortInParallel(size) {
+  return size >= PARALLEL_SORT_MIN &&
+         here.runningTasks() < here.maxTaskPar &&
+         dataParTasksPerLocale != 1;
+}
+
 /*
 
 Sort the elements in an array. It is up to the implementation to choose
 the sorting algorithm.
 
 .. note::
-  This function currently either uses a parallel radix sort or a serial
-  quickSort. The algorithms used will change over time.
+  This function currently uses a distributed sample sort, a parallel radix
+  sort or a parallel quickSort. The algorithms used will change over time.
+
+  It currently uses a distributed sample sort if the array is distributed
+  over more than one locale by a distribution that gives each locale a
+  single local subdomain, such as ``Block`` or ``Cyclic``, and its domain
+  is not strided.  Each locale then sorts the elements it receives with the
+  algorithms below.
 
   It currently uses parallel radix sort if the following conditions are met:
 
@@ -460,6 +477,14 @@ proc sort(Data: [?Dom] ?eltType, comparator:?rec=defaultComparator) {
   if Dom.low >= Dom.high then
     return;
 
+  if sampleSortOk(Data) {
+    // Arrays that are entirely local to this locale are sorted in place
+    if Dom.localSubdomain().size != Dom.size {
+      sampleSort(Data, comparator);
+      return;
+    }
+  }
+
   if radixSortOk(Data, comparator) {
     msbRadixSort(Data, comparator=comparator);
   } else {
@@ -662,9 +687,13 @@ proc heapSort(Data: [?Dom] ?eltType, comparator:?rec=defaultComparator)
  */
 proc insertionSort(Data: [?Dom] ?eltType, comparator:?rec=defaultComparator) {
   chpl_check_comparator(comparator, eltType);
-  const low = Dom.low,
-        high = Dom.high,
-        stride = abs(Dom.stride);
+  _InsertionSort(Data, Dom.dim(1).alignedLow, Dom.dim(1).alignedHigh,
+                 comparator);
+}
+
+// Insertion sort of the elements of Data with indices low..high
+private proc _InsertionSort(Data: [?Dom], low, high, comparator) {
+  const stride = abs(Dom.stride);
 
   for i in low..high by stride {
     var ithVal = Data[i];
@@ -780,47 +809,126 @@ proc mergeSort(Data: [?Dom] ?eltType, minlen=16, comparator:?rec=defaultComparat
 
 private proc _MergeSort(Data: [?Dom], minlen=16, comparator:?rec=defaultComparator)
   where Dom.rank == 1 {
-  const lo = Dom.dim(1).low;
-  const hi = Dom.dim(1).high;
-  if hi-lo < minlen {
-    insertionSort(Data, comparator);
+  var Scratch = Data;
+  _MergeSort(Data, Scratch, Dom.dim(1).alignedLow, Dom.dim(1).alignedHigh,
+             minlen, comparator);
+}
+
+// Sort Data[lo..hi], using the same elements of Scratch as temporary space
+private proc _MergeSort(Data: [?Dom], Scratch: [], lo, hi, minlen,
+                        comparator) {
+  const stride = abs(Dom.stride);
+  const size = (hi - lo) / stride + 1;
+
+  if size <= max(minlen, 1) {
+    _InsertionSort(Data, lo, hi, comparator);
     return;
   }
-  const mid = (hi-lo)/2+lo;
-  var A1 = Data[lo..mid];
-  var A2 = Data[mid+1..hi];
-  cobegin {
-    { _MergeSort(A1, minlen, comparator); }
-    { _MergeSort(A2, minlen, comparator); }
+
+  const mid = lo + (size / 2 - 1) * stride;
+
+  if sortInParallel(size) {
+    cobegin with (ref Data, ref Scratch) {
+      _MergeSort(Data, Scratch, lo, mid, minlen, comparator);
+      _MergeSort(Data, Scratch, mid+stride, hi, minlen, comparator);
+    }
+  } else {
+    _MergeSort(Data, Scratch, lo, mid, minlen, comparator);
+    _MergeSort(Data, Scratch, mid+stride, hi, minlen, comparator);
   }
 
-  // TODO -- This iterator causes unnecessary overhead - we can do without it
-  for (a, _a) in zip(Data[lo..hi], _MergeIterator(A1, A2, comparator=comparator)) do a = _a;
+  // Skip the merge when the halves are already in order
+  if chpl_compare(Data[mid], Data[mid+stride], comparator) <= 0 then
+    return;
+
+  Scratch[lo..hi by stride] = Data[lo..hi by stride];
+  _Merge(Data, Scratch, lo, mid, mid+stride, hi, lo, comparator);
 }
 
+// Merge the sorted runs Src[lo1..hi1] and Src[lo2..hi2] into Dst, starting
+// at index dst.  Elements of the first run come first among equal elements.
+// Large merges are split in two by the median of the longer run and the
+// halves are merged in parallel.
+private proc _Merge(Dst: [?Dom], Src: [], lo1, hi1, lo2, hi2, dst,
+                    comparator) {
+  const stride = abs(Dom.stride);
+  const size1 = if hi1 < lo1 then 0 else (hi1 - lo1) / stride + 1;
+  const size2 = if hi2 < lo2 then 0 else (hi2 - lo2) / stride + 1;
+
+  if !sortInParallel(size1 + size2) {
+    var i = lo1,
+        j = lo2,
+        k = dst;
+    while i <= hi1 && j <= hi2 {
+      if chpl_compare(Src[j], Src[i], comparator) < 0 {
+        Dst[k] = Src[j];
+        j += stride;
+      } else {
+        Dst[k] = Src[i];
+        i += stride;
+      }
+      k += stride;
+    }
+    while i <= hi1 {
+      Dst[k] = Src[i];
+      i += stride;
+      k += stride;
+    }
+    while j <= hi2 {
+      Dst[k] = Src[j];
+      j += stride;
+      k += stride;
+    }
+    return;
+  }
+
+  // Split the runs at m1 and m2 so that every element before them is
+  // placed before every element after them.  The element at the split
+  // point of the longer run goes between the two halves at dstMid.
+  var m1 = if size1 >= size2 then lo1 + (size1 / 2) * stride else lo1,
+      m2 = if size1 >= size2 then lo2 else lo2 + (size2 / 2) * stride;
+  const pivot = if size1 >= size2 then Src[m1] else Src[m2];
+
+  if size1 >= size2 {
+    // The elements of the second run less than the pivot come first
+    var n = size2;
+    while n > 0 {
+      const half = n / 2;
+      if chpl_compare(Src[m2 + half * stride], pivot, comparator) < 0 {
+        m2 += (half + 1) * stride;
+        n -= half + 1;
+      } else {
+        n = half;
+      }
+    }
+  } else {
+    // The elements of the first run not greater than the pivot come first
+    var n = size1;
+    while n > 0 {
+      const half = n / 2;
+      if chpl_compare(pivot, Src[m1 + half * stride], comparator) >= 0 {
+        m1 += (half + 1) * stride;
+        n -= half + 1;
+      } else {
+        n = half;
+      }
+    }
+  }
+
+  const dstMid = dst + (m1 - lo1) + (m2 - lo2);
+  Dst[dstMid] = pivot;
 
-private iter _MergeIterator(A1: [] ?eltType, A2: [] eltType, comparator:?rec=defaultComparator) {
-  var a1 = A1.domain.dim(1).low;
-  const a1hi = A1.domain.dim(1).high;
-  var a2 = A2.domain.dim(1).low;
-  const a2hi = A2.domain.dim(1).high;
-  while ((a1 <= a1hi) && (a2 <= a2hi)) {
-    while (chpl_compare(A1(a1), A2(a2), comparator) <= 0) {
-      yield A1(a1);
-      a1 += 1;
-      if a1 > a1hi then break;
+  if size1 >= size2 {
+    cobegin with (ref Dst) {
+      _Merge(Dst, Src, lo1, m1-stride, lo2, m2-stride, dst, comparator);
+      _Merge(Dst, Src, m1+stride, hi1, m2, hi2, dstMid+stride, comparator);
     }
-    if a1 > a1hi then break;
-    while (chpl_compare(A2(a2), A1(a1), comparator) <= 0) {
-      yield A2(a2);
-      a2 += 1;
-      if a2 > a2hi then break;
+  } else {
+    cobegin with (ref Dst) {
+      _Merge(Dst, Src, lo1, m1-stride, lo2, m2-stride, dst, comparator);
+      _Merge(Dst, Src, m1, hi1, m2+stride, hi2, dstMid+stride, comparator);
     }
   }
-  if a1 == a1hi then yield A1(a1);
-  else if a2 == a2hi then yield A2(a2);
-  if a1 < a1hi then for a in A1[a1..a1hi] do yield a;
-  else if a2 < a2hi then for a in A2[a2..a2hi] do yield a;
 }
 
 
@@ -833,7 +941,7 @@ proc mergeSort(Data: [?Dom] ?eltType, comparator:?rec=defaultComparator)
 
 
 /*
-   Sort the 1D array `Data` in-place using a sequential quick sort algorithm.
+   Sort the 1D array `Data` in-place using a parallel quick sort algorithm.
 
    :arg Data: The array to be sorted
    :type Data: [] `eltType`
@@ -845,105 +953,155 @@ proc mergeSort(Data: [?Dom] ?eltType, comparator:?rec=defaultComparator)
  */
 proc quickSort(Data: [?Dom] ?eltType, minlen=16, comparator:?rec=defaultComparator) {
   chpl_check_comparator(comparator, eltType);
-  // grab obvious indices
-  const stride = abs(Dom.stride),
-        lo = Dom.low,
-        hi = Dom.high,
-        size = Dom.size,
-        mid = if hi == lo then hi
-              else if size % 2 then lo + ((size - 1)/2) * stride
-              else lo + (size/2 - 1) * stride;
+  _QuickSort(Data, Dom.dim(1).alignedLow, Dom.dim(1).alignedHigh,
+             minlen, comparator);
+}
 
-  // base case -- use insertion sort
-  if (hi - lo < minlen) {
-    insertionSort(Data, comparator=comparator);
-    return;
-  }
+// Sort Data[lo..hi] in-place
+private proc _QuickSort(Data: [?Dom], in lo, in hi, minlen, comparator) {
+  const stride = abs(Dom.stride);
 
-  // find pivot using median-of-3 method
-  if (chpl_compare(Data(mid), Data(lo), comparator) < 0) then
-    Data(mid) <=> Data(lo);
-  if (chpl_compare(Data(hi), Data(lo), comparator) < 0) then
-    Data(hi) <=> Data(lo);
-  if (chpl_compare(Data(hi), Data(mid), comparator) < 0) then
-    Data(hi) <=> Data(mid);
-
-  const pivotVal = Data(mid);
-  Data(mid) = Data(hi-stride);
-  Data(hi-stride) = pivotVal;
-  // end median-of-3 partitioning
-
-  var loptr = lo,
-      hiptr = hi-stride;
-  while (loptr < hiptr) {
-    do { loptr += stride; } while (chpl_compare(Data(loptr), pivotVal, comparator) < 0);
-    do { hiptr -= stride; } while (chpl_compare(pivotVal, Data(hiptr), comparator) < 0);
-    if (loptr < hiptr) {
-      Data(loptr) <=> Data(hiptr);
+  // Sort the smaller partition by recursion and loop on the larger one,
+  // so that the recursion depth is logarithmic
+  while true {
+    const size = (hi - lo) / stride + 1,
+          mid = lo + ((size - 1) / 2) * stride;
+
+    // base case -- use insertion sort
+    if (hi - lo < minlen * stride) {
+      _InsertionSort(Data, lo, hi, comparator);
+      return;
     }
-  }
 
-  Data(hi-stride) = Data(loptr);
-  Data(loptr) = pivotVal;
+    // find pivot using median-of-3 method
+    if (chpl_compare(Data(mid), Data(lo), comparator) < 0) then
+      Data(mid) <=> Data(lo);
+    if (chpl_compare(Data(hi), Data(lo), comparator) < 0) then
+      Data(hi) <=> Data(lo);
+    if (chpl_compare(Data(hi), Data(mid), comparator) < 0) then
+      Data(hi) <=> Data(mid);
+
+    const pivotVal = Data(mid);
+
+    // Partition large parts in blocks, one per task.  This also takes the
+    // elements equal to the pivot out of both halves.
+    const numBlocks = if sortInParallel(size)
+                        then min(here.maxTaskPar - here.runningTasks() + 1,
+                                 size / PARALLEL_SORT_MIN)
+                        else 1;
+    if numBlocks > 1 {
+      const (eqLo, eqHi) = _ParallelPartition(Data, lo, hi, pivotVal,
+                                              numBlocks, comparator);
+      cobegin with (ref Data) {
+        _QuickSort(Data, lo, eqLo-stride, minlen, comparator);
+        _QuickSort(Data, eqHi+stride, hi, minlen, comparator);
+      }
+      return;
+    }
 
-  // TODO -- Get this cobegin working and tested
-  //  cobegin {
-    quickSort(Data[..loptr-stride], minlen, comparator);  // could use unbounded ranges here
-    quickSort(Data[loptr+stride..], minlen, comparator);
-  //  }
-}
+    Data(mid) = Data(hi-stride);
+    Data(hi-stride) = pivotVal;
+    // end median-of-3 partitioning
+
+    var loptr = lo,
+        hiptr = hi-stride;
+    while (loptr < hiptr) {
+      do { loptr += stride; } while (chpl_compare(Data(loptr), pivotVal, comparator) < 0);
+      do { hiptr -= stride; } while (chpl_compare(pivotVal, Data(hiptr), comparator) < 0);
+      if (loptr < hiptr) {
+        Data(loptr) <=> Data(hiptr);
+      }
+    }
 
-pragma "no doc"
-/* Non-stridable quickSort */
-proc quickSort(Data: [?Dom] ?eltType, minlen=16, comparator:?rec=defaultComparator)
-  where !Dom.stridable {
-  chpl_check_comparator(comparator, eltType);
+    Data(hi-stride) = Data(loptr);
+    Data(loptr) = pivotVal;
 
-  // grab obvious indices
-  const lo = Dom.low,
-        hi = Dom.high,
-        mid = lo + (hi-lo+1)/2;
+    if sortInParallel(size) {
+      cobegin with (ref Data) {
+        _QuickSort(Data, lo, loptr-stride, minlen, comparator);
+        _QuickSort(Data, loptr+stride, hi, minlen, comparator);
+      }
+      return;
+    }
 
-  // base case -- use insertion sort
-  if (hi - lo < minlen) {
-    insertionSort(Data, comparator=comparator);
-    return;
+    if loptr - lo < hi - loptr {
+      _QuickSort(Data, lo, loptr-stride, minlen, comparator);
+      lo = loptr+stride;
+    } else {
+      _QuickSort(Data, loptr+stride, hi, minlen, comparator);
+      hi = loptr-stride;
+    }
   }
+}
 
-  // find pivot using median-of-3 method
-  if (chpl_compare(Data(mid), Data(lo), comparator) < 0) then
-    Data(mid) <=> Data(lo);
-  if (chpl_compare(Data(hi), Data(lo), comparator) < 0) then
-    Data(hi) <=> Data(lo);
-  if (chpl_compare(Data(hi), Data(mid), comparator) < 0) then
-    Data(hi) <=> Data(mid);
-
-  const pivotVal = Data(mid);
-  Data(mid) = Data(hi-1);
-  Data(hi-1) = pivotVal;
-  // end median-of-3 partitioning
-
-  var loptr = lo,
-      hiptr = hi-1;
-  while (loptr < hiptr) {
-    do { loptr += 1; } while (chpl_compare(Data(loptr), pivotVal, comparator) < 0);
-    do { hiptr -= 1; } while (chpl_compare(pivotVal, Data(hiptr), comparator) < 0);
-    if (loptr < hiptr) {
-      Data(loptr) <=> Data(hiptr);
+// Partition Data[lo..hi] around pivotVal with numBlocks tasks.  Each task
+// counts the elements of its block that are less than, equal to and greater
+// than the pivot, then copies them to their places in a scratch array.
+// Returns the bounds of the elements equal to the pivot, which are then in
+// their final place.
+private proc _ParallelPartition(Data: [?Dom], lo, hi, pivotVal, numBlocks,
+                                comparator) {
+  const stride = abs(Dom.stride);
+  const size = (hi - lo) / stride + 1;
+  var NumLess, NumEqual, NumGreater: [0..#numBlocks] int;
+
+  coforall b in 0..#numBlocks with (ref NumLess, ref NumEqual,
+                                    ref NumGreater) {
+    const bLo = lo + (b * size / numBlocks) * stride,
+          bHi = lo + ((b + 1) * size / numBlocks - 1) * stride;
+    var nLess, nEqual = 0;
+    for i in bLo..bHi by stride {
+      const cmp = chpl_compare(Data(i), pivotVal, comparator);
+      if cmp < 0 then nLess += 1;
+      else if cmp == 0 then nEqual += 1;
+    }
+    NumLess[b] = nLess;
+    NumEqual[b] = nEqual;
+    NumGreater[b] = (bHi - bLo) / stride + 1 - nLess - nEqual;
+  }
+
+  // Where each block's elements of each kind go in Scratch
+  const totalLess = + reduce NumLess,
+        totalEqual = + reduce NumEqual;
+  var LessAt, EqualAt, GreaterAt: [0..#numBlocks] int;
+  var nextLess = 0,
+      nextEqual = totalLess,
+      nextGreater = totalLess + totalEqual;
+  for b in 0..#numBlocks {
+    LessAt[b] = nextLess;
+    EqualAt[b] = nextEqual;
+    GreaterAt[b] = nextGreater;
+    nextLess += NumLess[b];
+    nextEqual += NumEqual[b];
+    nextGreater += NumGreater[b];
+  }
+
+  var Scratch: [0..#size] Data.eltType;
+  coforall b in 0..#numBlocks with (ref Scratch) {
+    const bLo = lo + (b * size / numBlocks) * stride,
+          bHi = lo + ((b + 1) * size / numBlocks - 1) * stride;
+    var l = LessAt[b],
+        e = EqualAt[b],
+        g = GreaterAt[b];
+    for i in bLo..bHi by stride {
+      const cmp = chpl_compare(Data(i), pivotVal, comparator);
+      if cmp < 0 {
+        Scratch[l] = Data(i);
+        l += 1;
+      } else if cmp == 0 {
+        Scratch[e] = Data(i);
+        e += 1;
+      } else {
+        Scratch[g] = Data(i);
+        g += 1;
+      }
     }
   }
+  Data[lo..hi by stride] = Scratch;
 
-  Data(hi-1) = Data(loptr);
-  Data(loptr) = pivotVal;
-
-  // TODO -- Get this cobegin working and tested
-  //  cobegin {
-    quickSort(Data[..loptr-1], minlen, comparator);  // could use unbounded ranges here
-    quickSort(Data[loptr+1..], minlen, comparator);
-  //  }
+  return (lo + totalLess * stride, lo + (totalLess + totalEqual - 1) * stride);
 }
 
-
 pragma "no doc"
 /* Error message for multi-dimension arrays */
 proc quickSort(Data: [?Dom] ?eltType, minlen=16, comparator:?rec=defaultComparator)
@@ -1433,6 +1591,238 @@ proc checkSorted(start_n:int, end_n:int, A:[], criterion, startbit = 0)
   }
 }
 
+/* Distributed sample sort */
+
+// The number of samples each locale takes per target locale.  More samples
+// give buckets of more even sizes at the cost of sorting more samples.
+private param SAMPLE_SORT_OVERSAMPLE = 16;
+
+// Can Data be sorted by sampleSort?  It must be a 1-D distributed array
+// whose indices on each locale form a single (possibly strided) range.
+private
+proc sampleSortOk(Data: [?Dom]) param {
+  use Reflection;
+
+  if isRectangularDom(Dom) && Dom.rank == 1 && !Dom.stridable &&
+     !Dom._value.isDefaultRectangular() {
+    if canResolveMethod(Dom._value, "dsiHasSingleLocalSubdomain") then
+      return Dom.hasSingleLocalSubdomain();
+  }
+  return false;
+}
+
+// The per-locale state of a sampleSort.  Each locale sends the elements
+// in sendBuf[sendOffsets[j]..sendOffsets[j+1]-1] to the jth locale,
+// which stores those from all locales in its recvBuf.
+pragma "no doc"
+class SampleSortLocale {
+  type eltType;
+  const numBuckets: int;
+
+  var samplesDom: domain(1);
+  var samples: [samplesDom] eltType;
+
+  var sendOffsets: [0..numBuckets] int;
+  var sendDom: domain(1);
+  var sendBuf: [sendDom] eltType;
+
+  var recvDom: domain(1);
+  var recvBuf: [recvDom] eltType;
+}
+
+// Return the bucket for x, the element at index i: the index of the first
+// splitter that is not less than x, or splitters.size if there is none.
+// If x equals splitters lo..hi-1, it can go in any of buckets lo..hi
+// without putting the buckets out of order, so spread such elements over
+// those buckets by index.  Otherwise runs of an element that is chosen as
+// a splitter would all go to one locale.
+private inline
+proc sampleSortBucket(const ref splitters: [] ?t, x: t, i, comparator) {
+  var lo = 0;
+  var hi = splitters.size;
+
+  while lo < hi {
+    const mid = (lo + hi) / 2;
+    if chpl_compare(splitters[mid], x, comparator) < 0 then
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  if lo == splitters.size ||
+     chpl_compare(splitters[lo], x, comparator) != 0 then
+    return lo;
+
+  // Find hi, the index of the first splitter that is greater than x
+  const first = lo;
+  hi = splitters.size;
+  lo += 1;
+  while lo < hi {
+    const mid = (lo + hi) / 2;
+    if chpl_compare(splitters[mid], x, comparator) <= 0 then
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return first + mod(i:int, hi - first + 1);
+}
+
+// Sort a distributed array by sample sort.  Each locale samples its
+// elements, and the samples are sorted to choose one splitter per target
+// locale.  Each locale then partitions its elements by splitter and every
+// locale gets its bucket from every other in one bulk transfer per pair.
+// The buckets are sorted locally with sort() and the sorted data are
+// copied back into Data so that Data keeps its distribution.
+private
+proc sampleSort(Data: [?Dom] ?eltType, comparator) {
+  use RangeChunk;
+
+  const numLocs = Dom.targetLocales().size;
+  var locs: [0..#numLocs] locale;
+  for (l, t) in zip(locs, Dom.targetLocales()) do
+    l = t;
+
+  var buckets: [0..#numLocs] unmanaged SampleSortLocale(eltType);
+
+  // Step 1: sample the elements on each locale.
+  coforall (loc, locIdx) in zip(locs, 0..) do on loc {
+    const myInds = Dom.localSubdomain().dim(1);
+    const n = myInds.size;
+    const numSamples = min(n, SAMPLE_SORT_OVERSAMPLE * numLocs);
+    const myBucket = new unmanaged SampleSortLocale(eltType=eltType,
+                                                    numBuckets=numLocs);
+
+    // Take one sample from a pseudo-random position in each of numSamples
+    // equal strides, so that ordered or periodic input is sampled evenly.
+    myBucket.samplesDom = {0..#numSamples};
+    if numSamples > 0 {
+      const stride = n / numSamples;
+      forall (sample, s) in zip(myBucket.samples, 0..) {
+        const hash = ((s + 1):uint * 0x9E3779B97F4A7C15:uint) >> 17;
+        const pos = s * stride + (hash % stride:uint):int;
+        sample = Data[myInds.orderToIndex(pos)];
+      }
+    }
+
+    buckets[locIdx] = myBucket;
+  }
+
+  // Step 2: sort the samples and choose the splitters.
+  var numSamples = 0;
+  for b in buckets do
+    numSamples += b.samplesDom.size;
+
+  var allSamples: [0..#numSamples] eltType;
+  var sampleStart = 0;
+  for b in buckets {
+    const count = b.samplesDom.size;
+    if count > 0 then
+      allSamples[sampleStart..#count] = b.samples;
+    sampleStart += count;
+  }
+  sort(allSamples, comparator);
+
+  var splitters: [0..#numLocs-1] eltType;
+  for (splitter, j) in zip(splitters, 1..) do
+    splitter = allSamples[(j * numSamples) / numLocs];
+
+  // Step 3: partition the elements on each locale by destination locale.
+  coforall (b, loc) in zip(buckets, locs) do on loc {
+    const mySplitters = splitters;
+    const myInds = Dom.localSubdomain().dim(1);
+    const n = myInds.size;
+    const nTasks = max(1, min(here.maxTaskPar, n / 1024));
+    var taskOffsets: [0..#nTasks, 0..#numLocs] int;
+
+    b.samplesDom = {0..-1};
+    b.sendDom = {0..#n};
+
+    if n > 0 {
+      coforall tid in 0..#nTasks with (ref taskOffsets) {
+        for i in chunk(myInds, nTasks, tid) {
+          const bucket = sampleSortBucket(mySplitters, Data[i], i, comparator);
+          taskOffsets[tid, bucket] += 1;
+        }
+      }
+    }
+
+    // Turn the counts into the start of each task's part of each bucket
+    var sum = 0;
+    for bucket in 0..#numLocs {
+      b.sendOffsets[bucket] = sum;
+      for tid in 0..#nTasks {
+        const count = taskOffsets[tid, bucket];
+        taskOffsets[tid, bucket] = sum;
+        sum += count;
+      }
+    }
+    b.sendOffsets[numLocs] = sum;
+
+    if n > 0 {
+      coforall tid in 0..#nTasks with (ref taskOffsets) {
+        for i in chunk(myInds, nTasks, tid) {
+          const bucket = sampleSortBucket(mySplitters, Data[i], i, comparator);
+          b.sendBuf[taskOffsets[tid, bucket]] = Data[i];
+          taskOffsets[tid, bucket] += 1;
+        }
+      }
+    }
+  }
+
+  // Step 4: gather each locale's bucket from all locales and sort it.
+  coforall (b, loc, j) in zip(buckets, locs, 0..) do on loc {
+    const allBuckets = buckets;
+    var recvOffsets: [0..numLocs] int;
+
+    for (src, i) in zip(allBuckets, 0..) do
+      recvOffsets[i+1] = recvOffsets[i] +
+                         src.sendOffsets[j+1] - src.sendOffsets[j];
+
+    b.recvDom = {0..#recvOffsets[numLocs]};
+
+    forall (src, i) in zip(allBuckets, 0..) {
+      const count = recvOffsets[i+1] - recvOffsets[i];
+      if count > 0 then
+        b.recvBuf[recvOffsets[i]..#count] =
+          src.sendBuf[src.sendOffsets[j]..#count];
+    }
+
+    sort(b.recvBuf, comparator);
+  }
+
+  // Step 5: copy the sorted buckets back into Data.  Bucket j holds the
+  // elements in positions bucketStart[j]..bucketStart[j+1]-1 of Data.
+  var bucketStart: [0..numLocs] int;
+  for (b, j) in zip(buckets, 0..) do
+    bucketStart[j+1] = bucketStart[j] + b.recvDom.size;
+
+  coforall (b, loc) in zip(buckets, locs) do on loc {
+    const allBuckets = buckets;
+    const myBucketStart = bucketStart;
+    const myInds = Dom.localSubdomain().dim(1);
+
+    b.sendDom = {0..-1};
+
+    forall (src, j) in zip(allBuckets, 0..) {
+      const bucketInds = (Dom.low + myBucketStart[j])..#src.recvDom.size;
+      const inds = myInds[bucketInds];
+
+      if inds.size > 0 {
+        var tmp: [0..#inds.size] eltType;
+
+        tmp = src.recvBuf[inds - bucketInds.low];
+
+        forall (i, elt) in zip(inds, tmp) do
+          Data[i] = elt;
+      }
+    }
+  }
+
+  coforall (b, loc) in zip(buckets, locs) do on loc {
+    delete b;
+  }
+}
+
 /* Comparators */
 
 /* Default comparator used in sort functions.*/
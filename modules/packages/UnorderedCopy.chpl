@@ -66,15 +66,20 @@
    assignments to perform and the order of those operations doesn't matter.
 
    .. note::
-     Currently, this is only optimized for ``CHPL_COMM=ugni``. Other
-     communication layers fall back to regular operations. Under ugni, GETs are
-     internally buffered. When the buffers are flushed, the operations are
-     performed all at once. Cray Linux Environment (CLE) 5.2.UP04 or newer is
-     required for best performance. In our experience, buffered gets can
-     achieve up to a 5X performance improvement over non-buffered gets for CLE
-     5.2UP04 or newer.
+     Currently, this is only optimized for ``CHPL_COMM=ugni`` and ``gasnet``.
+     Other communication layers fall back to regular operations. Under ugni,
+     GETs are internally buffered. When the buffers are flushed, the
+     operations are performed all at once. Cray Linux Environment (CLE)
+     5.2.UP04 or newer is required for best performance. In our experience,
+     buffered gets can achieve up to a 5X performance improvement over
+     non-buffered gets for CLE 5.2UP04 or newer. Under gasnet, GETs are
+     buffered per target locale and each full buffer is retrieved with a
+     single active message.
  */
 module UnorderedCopy {
+  private param unorderedCopyAvailable = CHPL_COMM == 'ugni' ||
+                                         CHPL_COMM == 'gasnet';
+
   /*
      Unordered copy. Only supported for numeric types.
    */
@@ -86,7 +91,7 @@ module UnorderedCopy {
       compilerError("unorderedCopy is only supported between identical numeric types");
     }
 
-    if CHPL_COMM == 'ugni' {
+    if unorderedCopyAvailable {
       __primitive("unordered=", dst, src);
     } else {
       __primitive("=", dst, src);
@@ -98,7 +103,7 @@ module UnorderedCopy {
      across all locales.
    */
   inline proc unorderedCopyFence(): void {
-    if CHPL_COMM == 'ugni' {
+    if unorderedCopyAvailable {
       extern proc chpl_comm_get_unordered_fence();
       coforall loc in Locales do on loc {
         chpl_comm_get_unordered_fence();
@@ -137,6 +137,65 @@
   was executed on locale 0, and a remote get and a remote put were
   executed on locale 1.
 
+  **Detailed Counts, Communication Matrices and Latencies**
+
+  While counting is on, each locale also keeps some additional counts
+  that are retrieved separately, so that the output shown above stays
+  compact::
+
+    startCommDiagnostics();
+    // ... code that communicates ...
+    stopCommDiagnostics();
+    writeln(getCommDetailDiagnostics());
+    writeln(getCommMatrix());
+
+  :proc:`getCommDetailDiagnostics` returns, for each locale, the bytes
+  moved by its GETs and PUTs, how many of those GETs and PUTs were
+  strided, and how many remote atomic operations it initiated.
+  :proc:`getCommMatrix` returns a matrix whose element ``(i, j)`` counts
+  the operations locale ``i`` initiated with locale ``j`` as their
+  target and the bytes they moved, which makes communication imbalance
+  and hot spots easy to see.  GETs, PUTs, atomics and remote executions
+  are all included; the bytes for a remote execution are those of its
+  argument bundle.
+
+  Distributions of operation latencies can also be collected.  This is
+  done separately from counting because it reads a clock twice per
+  operation::
+
+    startCommLatencyHistograms();
+    // ... code that communicates ...
+    stopCommLatencyHistograms();
+    writeln(getCommLatencyHistograms());
+
+  Each locale keeps a histogram per kind of blocking operation it
+  initiates: GETs, PUTs, atomics and remote executions.  Bucket ``b``
+  counts operations that took at least ``2**b`` and less than
+  ``2**(b+1)`` nanoseconds.  Non-blocking operations are counted but
+  not timed.  :proc:`resetCommDiagnostics` and
+  :proc:`resetCommDiagnosticsHere` reset all of these along with the
+  basic counts.
+
+  **Remote Data Cache Statistics**
+
+  When a program is compiled with ``--cache-remote``, each locale also
+  keeps counts of how its remote data cache behaved.  These counts are
+  always collected, so there are no start/stop calls for them; they
+  can be reset and retrieved in the same way as the communication
+  counts::
+
+    resetCacheDiagnostics();
+    // ... code that does remote GETs and PUTs ...
+    writeln(getCacheDiagnostics());
+
+  Each element of the result counts GETs that hit or missed in the
+  cache, readahead prefetches and whether their pages were used,
+  write-behind flushes, evictions from each of the cache's queues, and
+  pages invalidated by memory fences.  When the remote data cache is
+  not in use, all of the counts are zero.  The counts are updated
+  without synchronization, so they are only exact when retrieved while
+  no other tasks are doing remote accesses.
+
   **Studying Communication During Module Initialization**
 
   It is hard for a programmer to determine exactly what happens during
@@ -238,6 +297,184 @@ module CommDiagnostics
    */
   type commDiagnostics = chpl_commDiagnostics;
 
+  /* Additional communication counts, collected whenever
+     :record:`chpl_commDiagnostics` counts are.  As with that type,
+     this duplicates the definition in the comm layer(s).
+   */
+  extern record chpl_commDetailDiagnostics {
+    /*
+      bytes read by GETs, blocking or not
+     */
+    var get_bytes: uint(64);
+    /*
+      bytes written by PUTs, blocking or not
+     */
+    var put_bytes: uint(64);
+    /*
+      strided GETs; each one is also counted among the GETs
+     */
+    var get_strd: uint(64);
+    /*
+      strided PUTs; each one is also counted among the PUTs
+     */
+    var put_strd: uint(64);
+    /*
+      remote atomic operations
+     */
+    var amo: uint(64);
+
+    proc writeThis(c) {
+      use Reflection;
+
+      var first = true;
+      c <~> "(";
+      for param i in 1..numFields(chpl_commDetailDiagnostics) {
+        const val = getField(this, i);
+        if val != 0 {
+          if first then first = false; else c <~> ", ";
+          c <~> getFieldName(chpl_commDetailDiagnostics, i) <~> " = " <~> val;
+        }
+      }
+      if first then c <~> "<no communication>";
+      c <~> ")";
+    }
+  };
+
+  /*
+    The Chapel record type inherits the comm layer definition of it.
+   */
+  type commDetailDiagnostics = chpl_commDetailDiagnostics;
+
+  /*
+    Communication from one locale to another: the number of operations
+    and the bytes they moved.  See :proc:`getCommMatrix`.
+   */
+  record commMatrixEntry {
+    var ops: uint(64);
+    var bytes: uint(64);
+  }
+
+  /*
+    Number of buckets in each latency histogram.  Bucket ``b`` counts
+    operations that took ``2**b`` up to ``2**(b+1)`` nanoseconds; the
+    last one also counts all slower operations.
+   */
+  param commLatencyBuckets = 32;
+
+  /*
+    Latency histograms for the blocking operations initiated on one
+    locale.  See :proc:`getCommLatencyHistograms`.
+   */
+  record commLatencyHistogram {
+    /* GETs */
+    var get: [0..#commLatencyBuckets] uint(64);
+    /* PUTs */
+    var put: [0..#commLatencyBuckets] uint(64);
+    /* remote atomic operations */
+    var amo: [0..#commLatencyBuckets] uint(64);
+    /* blocking remote executions */
+    var execute_on: [0..#commLatencyBuckets] uint(64);
+
+    proc writeThis(c) {
+      var first = true;
+      proc writeOne(name: string, const ref h) {
+        if + reduce h == 0 then return;
+        if first then first = false; else c <~> ", ";
+        c <~> name <~> " = [";
+        var firstBucket = true;
+        for b in h.domain do if h[b] != 0 {
+          if firstBucket then firstBucket = false; else c <~> ", ";
+          c <~> "2**" <~> b <~> "ns: " <~> h[b];
+        }
+        c <~> "]";
+      }
+
+      c <~> "(";
+      writeOne("get", get);
+      writeOne("put", put);
+      writeOne("amo", amo);
+      writeOne("execute_on", execute_on);
+      if first then c <~> "<no communication>";
+      c <~> ")";
+    }
+  }
+
+  /* Aggregated remote data cache event counts.  As with
+     :record:`chpl_commDiagnostics`, this duplicates the definition in
+     the runtime.
+   */
+  extern record chpl_cacheDiagnostics {
+    /*
+      GETs satisfied from data already in the cache
+     */
+    var get_hits: uint(64);
+    /*
+      GETs that had to wait for data from the remote locale
+     */
+    var get_misses: uint(64);
+    /*
+      readahead prefetches started
+     */
+    var readahead_triggered: uint(64);
+    /*
+      prefetched pages that were later read
+     */
+    var readahead_used: uint(64);
+    /*
+      prefetched pages that were discarded without being read
+     */
+    var readahead_wasted: uint(64);
+    /*
+      PUTs issued to write dirty cached data back to its home locale
+     */
+    var write_behind_flushes: uint(64);
+    /*
+      pages evicted from the queue of recently-added pages
+     */
+    var evictions_ain: uint(64);
+    /*
+      entries evicted from the queue of recently-evicted page addresses
+     */
+    var evictions_aout: uint(64);
+    /*
+      pages evicted from the queue of frequently-used pages
+     */
+    var evictions_am: uint(64);
+    /*
+      cached pages discarded because a memory fence made them stale
+     */
+    var fence_invalidations: uint(64);
+    /*
+      pages found in the per-locale shared read tier
+     */
+    var shared_hits: uint(64);
+    /*
+      pages looked for but not found in the per-locale shared read tier
+     */
+    var shared_misses: uint(64);
+
+    proc writeThis(c) {
+      use Reflection;
+
+      var first = true;
+      c <~> "(";
+      for param i in 1..numFields(chpl_cacheDiagnostics) {
+        const val = getField(this, i);
+        if val != 0 {
+          if first then first = false; else c <~> ", ";
+          c <~> getFieldName(chpl_cacheDiagnostics, i) <~> " = " <~> val;
+        }
+      }
+      if first then c <~> "<no cache activity>";
+      c <~> ")";
+    }
+  };
+
+  /*
+    The Chapel record type inherits the runtime definition of it.
+   */
+  type cacheDiagnostics = chpl_cacheDiagnostics;
+
   private extern proc chpl_startVerboseComm();
 
   private extern proc chpl_stopVerboseComm();
@@ -258,6 +495,31 @@ module CommDiagnostics
 
   private extern proc chpl_getCommDiagnosticsHere(out cd: commDiagnostics);
 
+  private extern proc chpl_getCommDetailDiagnosticsHere(
+                        out cd: commDetailDiagnostics);
+
+  private extern proc chpl_getCommMatrixRowHere(ops: c_ptr(uint(64)),
+                                                bytes: c_ptr(uint(64)));
+
+  private extern proc chpl_startCommLatencyHistogramsHere();
+
+  private extern proc chpl_stopCommLatencyHistogramsHere();
+
+  private extern proc chpl_getCommLatencyHistogramHere(
+                        latencyClass: c_int, buckets: c_ptr(uint(64)));
+
+  private extern const chpl_comm_diags_latency_get: c_int;
+
+  private extern const chpl_comm_diags_latency_put: c_int;
+
+  private extern const chpl_comm_diags_latency_amo: c_int;
+
+  private extern const chpl_comm_diags_latency_execute_on: c_int;
+
+  private extern proc chpl_cache_resetDiagnosticsHere();
+
+  private extern proc chpl_cache_getDiagnosticsHere(out cd: cacheDiagnostics);
+
   /*
     Start on-the-fly reporting of communication initiated on any locale.
    */
@@ -307,7 +569,9 @@ module CommDiagnostics
   }
 
   /*
-    Reset aggregate communication counts across the whole program.
+    Reset aggregate communication counts across the whole program,
+    along with the additional counts, communication matrix and latency
+    histograms.
    */
   proc resetCommDiagnostics() {
     for loc in Locales do on loc do
@@ -315,7 +579,9 @@ module CommDiagnostics
   }
 
   /*
-    Reset aggregate communication counts on the calling locale.
+    Reset aggregate communication counts on the calling locale, along
+    with its additional counts, communication matrix row and latency
+    histograms.
    */
   inline proc resetCommDiagnosticsHere() {
     chpl_resetCommDiagnosticsHere();
@@ -347,6 +613,172 @@ module CommDiagnostics
     return cd;
   }
 
+  /*
+    Retrieve the additional communication counts for the whole program.
+
+    :returns: array of additional counts of comm ops initiated on each
+              locale
+    :rtype: `[LocaleSpace] commDetailDiagnostics`
+   */
+  proc getCommDetailDiagnostics() {
+    var D: [LocaleSpace] commDetailDiagnostics;
+    for loc in Locales do on loc {
+      D(loc.id) = getCommDetailDiagnosticsHere();
+    }
+    return D;
+  }
+
+  /*
+    Retrieve the additional communication counts for this locale.
+
+    :returns: additional counts of comm ops initiated on this locale
+    :rtype: `commDetailDiagnostics`
+   */
+  proc getCommDetailDiagnosticsHere() {
+    var cd: commDetailDiagnostics;
+    chpl_getCommDetailDiagnosticsHere(cd);
+    return cd;
+  }
+
+  /*
+    Retrieve the communication matrix for the whole program.  Element
+    ``(i, j)`` counts the operations initiated on locale ``i`` that
+    targeted locale ``j``, and the bytes they moved.
+
+    :returns: matrix of communication between locales
+    :rtype: `[0..#numLocales, 0..#numLocales] commMatrixEntry`
+   */
+  proc getCommMatrix() {
+    var M: [0..#numLocales, 0..#numLocales] commMatrixEntry;
+    for loc in Locales do on loc {
+      const row = getCommMatrixRowHere();
+      M[loc.id, ..] = row;
+    }
+    return M;
+  }
+
+  /*
+    Retrieve this locale's row of the communication matrix: the
+    operations it initiated that targeted each locale, and the bytes
+    they moved.
+
+    :returns: communication from this locale to each locale
+    :rtype: `[LocaleSpace] commMatrixEntry`
+   */
+  proc getCommMatrixRowHere() {
+    var ops, bytes: [LocaleSpace] uint(64);
+    chpl_getCommMatrixRowHere(c_ptrTo(ops), c_ptrTo(bytes));
+    var row: [LocaleSpace] commMatrixEntry;
+    for i in LocaleSpace do
+      row[i] = new commMatrixEntry(ops[i], bytes[i]);
+    return row;
+  }
+
+  /*
+    Start collecting latency histograms on all locales.
+   */
+  proc startCommLatencyHistograms() {
+    for loc in Locales do on loc do
+      startCommLatencyHistogramsHere();
+  }
+
+  /*
+    Stop collecting latency histograms on all locales.
+   */
+  proc stopCommLatencyHistograms() {
+    for loc in Locales do on loc do
+      stopCommLatencyHistogramsHere();
+  }
+
+  /*
+    Start collecting latency histograms on the calling locale.
+   */
+  inline proc startCommLatencyHistogramsHere() {
+    chpl_startCommLatencyHistogramsHere();
+  }
+
+  /*
+    Stop collecting latency histograms on the calling locale.
+   */
+  inline proc stopCommLatencyHistogramsHere() {
+    chpl_stopCommLatencyHistogramsHere();
+  }
+
+  /*
+    Retrieve the latency histograms for the whole program.
+
+    :returns: array of latency histograms of comm ops initiated on each
+              locale
+    :rtype: `[LocaleSpace] commLatencyHistogram`
+   */
+  proc getCommLatencyHistograms() {
+    var D: [LocaleSpace] commLatencyHistogram;
+    for loc in Locales do on loc {
+      D(loc.id) = getCommLatencyHistogramsHere();
+    }
+    return D;
+  }
+
+  /*
+    Retrieve the latency histograms for this locale.
+
+    :returns: latency histograms of comm ops initiated on this locale
+    :rtype: `commLatencyHistogram`
+   */
+  proc getCommLatencyHistogramsHere() {
+    var h: commLatencyHistogram;
+    chpl_getCommLatencyHistogramHere(chpl_comm_diags_latency_get,
+                                     c_ptrTo(h.get));
+    chpl_getCommLatencyHistogramHere(chpl_comm_diags_latency_put,
+                                     c_ptrTo(h.put));
+    chpl_getCommLatencyHistogramHere(chpl_comm_diags_latency_amo,
+                                     c_ptrTo(h.amo));
+    chpl_getCommLatencyHistogramHere(chpl_comm_diags_latency_execute_on,
+                                     c_ptrTo(h.execute_on));
+    return h;
+  }
+
+  /*
+    Reset remote data cache counts across the whole program.
+   */
+  proc resetCacheDiagnostics() {
+    for loc in Locales do on loc do
+      resetCacheDiagnosticsHere();
+  }
+
+  /*
+    Reset remote data cache counts on the calling locale.
+   */
+  inline proc resetCacheDiagnosticsHere() {
+    chpl_cache_resetDiagnosticsHere();
+  }
+
+  /*
+    Retrieve remote data cache counts for the whole program.
+
+    :returns: array of cache event counts for each locale
+    :rtype: `[LocaleSpace] cacheDiagnostics`
+   */
+  proc getCacheDiagnostics() {
+    var D: [LocaleSpace] cacheDiagnostics;
+    for loc in Locales do on loc {
+      D(loc.id) = getCacheDiagnosticsHere();
+    }
+    return D;
+  }
+
+  /*
+    Retrieve remote data cache counts for this locale.
+
+    :returns: counts of cache events on this locale
+    :rtype: `cacheDiagnostics`
+   */
+  proc getCacheDiagnosticsHere() {
+    var cd: cacheDiagnostics;
+    chpl_cache_getDiagnosticsHere(cd);
+    return cd;
+  }
+
 
   /*
     If this is set, on-the-fly reporting of communication operations
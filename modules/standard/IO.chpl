@@ -660,6 +660,8 @@ extern const QIO_METHOD_FREADFWRITE:c_int;
 pragma "no doc"
 extern const QIO_METHOD_MMAP:c_int;
 pragma "no doc"
+extern const QIO_METHOD_IOURING:c_int;
+pragma "no doc"
 extern const QIO_METHODMASK:c_int;
 pragma "no doc"
 extern const QIO_HINT_RANDOM:c_int;
@@ -707,6 +709,14 @@ const IOHINT_CACHED = QIO_HINT_CACHED;
  */
 const IOHINT_PARALLEL = QIO_HINT_PARALLEL;
 
+/*  IOHINT_ASYNC means that reads and writes should be submitted
+    through Linux's io_uring interface, so that a task waiting for
+    I/O yields to other tasks instead of blocking its thread in a
+    system call. Where io_uring is not available, this behaves like
+    ordinary positioned reads and writes.
+ */
+const IOHINT_ASYNC = QIO_METHOD_IOURING;
+
 pragma "no doc"
 extern type qio_file_ptr_t;
 private extern const QIO_FILE_PTR_NULL:qio_file_ptr_t;
@@ -953,6 +963,7 @@ private extern proc qio_locales_for_region(fl:qio_file_ptr_t,
                                    ref loc_names:c_ptr(c_string),
                                    ref num_locs_out:c_int):syserr;
 private extern proc qio_get_chunk(fl:qio_file_ptr_t, ref len:int(64)):syserr;
+private extern proc qio_file_find_splits(fl:qio_file_ptr_t, start:int(64), end:int(64), nsplits:int(64), byte:c_int, offsets:c_ptr(int(64))):syserr;
 private extern proc qio_get_fs_type(fl:qio_file_ptr_t, ref tp:c_int):syserr;
 
 pragma "no prototype" // FIXME
@@ -4169,6 +4180,111 @@ proc file.localesForRegion(start:int(64), end:int(64)) {
   return ret;
 }
 
+/*
+   Divide the region of the file in start..end-1 into ``nChunks`` pieces
+   that can be read independently. Every piece begins just after a
+   ``sep`` byte (or at ``start``), so for a text file with the default
+   separator each piece holds whole lines. A piece can be empty if the
+   records are longer than the pieces.
+
+   :arg nChunks: how many pieces to divide the region into
+   :arg sep: the byte that ends each record. Defaults to newline.
+   :arg start: the file offset (starting from 0) where the region begins
+   :arg end: the file offset just after the region. Offsets past the
+             end of the file are treated as the end of the file.
+   :returns: an array of ``nChunks+1`` offsets such that piece ``i``
+             is ``offsets[i]..offsets[i+1]-1``
+   :rtype: `[0..nChunks] int(64)`
+
+   :throws SystemError: Thrown if the file could not be read.
+ */
+proc file.splitOffsets(nChunks:int, sep:uint(8) = ascii("\n"),
+                       start:int(64) = 0,
+                       end:int(64) = max(int(64))) throws {
+  if nChunks < 1 then
+    try ioerror(EINVAL:syserr, "in file.splitOffsets: nChunks must be positive");
+
+  var offsets: [0..nChunks] int(64);
+  var err:syserr = ENOERR;
+  on this.home {
+    var locOffsets: [0..nChunks] int(64);
+    err = qio_file_find_splits(this._file_internal, start, end, nChunks,
+                               sep:c_int, c_ptrTo(locOffsets[0]));
+    offsets = locOffsets;
+  }
+  if err then try ioerror(err, "in file.splitOffsets", this.tryGetPath());
+  return offsets;
+}
+
+/*
+   Iterate over reading channels for record-aligned pieces of the file,
+   as divided up by :proc:`file.splitOffsets`.
+
+   In a ``forall`` loop the pieces are divided among the locales in
+   ``targetLocales`` and then among the tasks on each locale, and each
+   channel is created on the locale that reads it. Locales other than
+   the file's home locale open the file again by its path, so the file
+   must be reachable by that path from each of them.
+
+   Errors creating the channels halt the program.
+
+   :arg nChunks: how many pieces to divide the file into. The default
+                 of 0 uses one piece per task that each target locale
+                 can run in parallel.
+   :arg sep: the byte that ends each record. Defaults to newline.
+   :arg start: the file offset (starting from 0) where the region begins
+   :arg end: the file offset just after the region
+   :arg hints: hints for the channels. See :type:`iohints`.
+   :arg targetLocales: the locales to read the file on in parallel
+   :yields: a reading channel for each piece of the file
+ */
+iter file.chunkReaders(nChunks:int = 0, sep:uint(8) = ascii("\n"),
+                       start:int(64) = 0, end:int(64) = max(int(64)),
+                       hints:iohints = IOHINT_NONE,
+                       targetLocales = Locales) {
+  const n = if nChunks > 0 then nChunks else here.maxTaskPar;
+  const offsets = try! this.splitOffsets(n, sep, start, end);
+  for i in 0..#n {
+    const r = try! this.reader(iokind.dynamic, true, offsets[i],
+                               offsets[i+1], hints, this._style);
+    yield r;
+  }
+}
+
+pragma "no doc"
+iter file.chunkReaders(nChunks:int = 0, sep:uint(8) = ascii("\n"),
+                       start:int(64) = 0, end:int(64) = max(int(64)),
+                       hints:iohints = IOHINT_NONE,
+                       targetLocales = Locales,
+                       param tag: iterKind)
+    where tag == iterKind.standalone {
+
+  const n = if nChunks > 0 then nChunks
+            else + reduce [loc in targetLocales] loc.maxTaskPar;
+  const offsets = try! this.splitOffsets(n, sep, start, end);
+  const numLocs = targetLocales.size;
+  const fileHome = this.home;
+  var filePath = "";
+  if numLocs > 1 then
+    filePath = try! this.path;
+
+  coforall (loc, locIdx) in zip(targetLocales, 0..) do on loc {
+    // Give each locale a contiguous block of the pieces.
+    const myLo = (n * locIdx) / numLocs;
+    const myHi = (n * (locIdx + 1)) / numLocs - 1;
+    const myOffsets = offsets[myLo..myHi+1];
+    var f = this;
+    if here != fileHome then
+      f = try! open(filePath, iomode.r, IOHINT_NONE, this._style, "");
+
+    forall i in myLo..myHi {
+      const r = try! f.reader(iokind.dynamic, true, myOffsets[i],
+                              myOffsets[i+1], hints, f._style);
+      yield r;
+    }
+  }
+}
+
 
 /*
 
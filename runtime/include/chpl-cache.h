@@ -92,6 +92,34 @@ void chpl_cache_assert_released(void);
 #endif
 // ifdef HAS_CHPL_CACHE_FNS
 
+//
+// Remote data cache diagnostics. These are counted per locale (summed
+// over the per-pthread caches) and are available, as all zeroes, even
+// when the comm layer has no cache.
+//
+#define CHPL_CACHE_DIAGS_VARS_ALL(MACRO) \
+  MACRO(get_hits) \
+  MACRO(get_misses) \
+  MACRO(readahead_triggered) \
+  MACRO(readahead_used) \
+  MACRO(readahead_wasted) \
+  MACRO(write_behind_flushes) \
+  MACRO(evictions_ain) \
+  MACRO(evictions_aout) \
+  MACRO(evictions_am) \
+  MACRO(fence_invalidations) \
+  MACRO(shared_hits) \
+  MACRO(shared_misses)
+
+typedef struct _chpl_cacheDiagnostics {
+#define _CACHE_DIAGS_DECL(cdv) uint64_t cdv;
+  CHPL_CACHE_DIAGS_VARS_ALL(_CACHE_DIAGS_DECL)
+#undef _CACHE_DIAGS_DECL
+} chpl_cacheDiagnostics;
+
+void chpl_cache_resetDiagnosticsHere(void);
+void chpl_cache_getDiagnosticsHere(chpl_cacheDiagnostics *cd);
+
 
 #endif
 
@@ -22,26 +22,54 @@
 
 #include <stdarg.h>
 #include <stdio.h>
+#include <time.h>
 
 #include "chpl-atomics.h"
+#include "chpl-bitops.h"
 #include "chpl-comm.h"
 
 typedef struct _chpl_atomic_commDiagnostics {
 #define _COMM_DIAGS_DECL_ATOMIC(cdv) atomic_uint_least64_t cdv;
   CHPL_COMM_DIAGS_VARS_ALL(_COMM_DIAGS_DECL_ATOMIC)
+  CHPL_COMM_DIAGS_DETAIL_VARS_ALL(_COMM_DIAGS_DECL_ATOMIC)
 #undef _COMM_DIAGS_DECL_ATOMIC
 } chpl_atomic_commDiagnostics;
 
 chpl_atomic_commDiagnostics chpl_comm_diags_counters;
 atomic_int_least16_t chpl_comm_diags_disable_flag;
 
+//
+// Per-destination counts of the operations this node initiated, and the
+// bytes they moved, indexed by target node.  This is NULL until the comm
+// layer calls chpl_comm_diags_init().
+//
+typedef struct {
+  atomic_uint_least64_t ops;
+  atomic_uint_least64_t bytes;
+} chpl_comm_diags_dest_t;
+
+extern chpl_comm_diags_dest_t* chpl_comm_diags_dests;
+
+//
+// Latency histograms, kept only while chpl_comm_diags_latency is set.
+//
+extern int chpl_comm_diags_latency;
+extern atomic_uint_least64_t
+       chpl_comm_diags_latency_hist[chpl_comm_diags_latency_num_classes]
+                                   [CHPL_COMM_DIAGS_LATENCY_BUCKETS];
+
+void chpl_comm_diags_init_detail(void);
+void chpl_comm_diags_reset_detail(void);
+
 static inline
 void chpl_comm_diags_init(void) {
 #define _COMM_DIAGS_INIT(cdv) \
         atomic_init_uint_least64_t(&chpl_comm_diags_counters.cdv, 0);
   CHPL_COMM_DIAGS_VARS_ALL(_COMM_DIAGS_INIT);
+  CHPL_COMM_DIAGS_DETAIL_VARS_ALL(_COMM_DIAGS_INIT);
 #undef _COMM_DIAGS_INIT
   atomic_init_int_least16_t(&chpl_comm_diags_disable_flag, 0);
+  chpl_comm_diags_init_detail();
 }
 
 static inline
@@ -49,7 +77,9 @@ void chpl_comm_diags_reset(void) {
 #define _COMM_DIAGS_RESET(cdv) \
         atomic_store_uint_least64_t(&chpl_comm_diags_counters.cdv, 0);
  CHPL_COMM_DIAGS_VARS_ALL(_COMM_DIAGS_RESET);
+ CHPL_COMM_DIAGS_DETAIL_VARS_ALL(_COMM_DIAGS_RESET);
 #undef _COMM_DIAGS_RESET
+ chpl_comm_diags_reset_detail();
 }
 
 static inline
@@ -60,6 +90,14 @@ void chpl_comm_diags_copy(chpl_commDiagnostics* cd) {
 #undef _COMM_DIAGS_COPY
 }
 
+static inline
+void chpl_comm_diags_copy_detail(chpl_commDetailDiagnostics* cd) {
+#define _COMM_DIAGS_COPY(cdv) \
+        cd->cdv = atomic_load_uint_least64_t(&chpl_comm_diags_counters.cdv);
+  CHPL_COMM_DIAGS_DETAIL_VARS_ALL(_COMM_DIAGS_COPY);
+#undef _COMM_DIAGS_COPY
+}
+
 static inline
 void chpl_comm_diags_disable(void) {
   (void) atomic_fetch_add_int_least16_t(&chpl_comm_diags_disable_flag, 1);
@@ -107,12 +145,105 @@ void chpl_comm_diags_verbose_printf(const char* format, ...) {
                                   + ((strlen(kind) == 0) ? 0 : 1)),     \
                                  kind, (int) node)
 
-#define chpl_comm_diags_incr(_ctr)                                      \
+#define chpl_comm_diags_add(_ctr, _n)                                   \
   do {                                                                  \
     if (chpl_comm_diagnostics && chpl_comm_diags_is_enabled()) {        \
       atomic_uint_least64_t* ctrAddr = &chpl_comm_diags_counters._ctr;  \
-      (void) atomic_fetch_add_uint_least64_t(ctrAddr, 1);               \
+      (void) atomic_fetch_add_uint_least64_t(ctrAddr, (_n));            \
+    }                                                                   \
+  } while(0)
+
+#define chpl_comm_diags_incr(_ctr) chpl_comm_diags_add(_ctr, 1)
+
+static inline
+void chpl_comm_diags_count_dest(c_nodeid_t node, size_t size) {
+  if (chpl_comm_diags_dests != NULL) {
+    chpl_comm_diags_dest_t* d = &chpl_comm_diags_dests[node];
+    (void) atomic_fetch_add_uint_least64_t(&d->ops, 1);
+    (void) atomic_fetch_add_uint_least64_t(&d->bytes, size);
+  }
+}
+
+//
+// Count a GET or PUT of 'size' bytes with 'node': the operation itself
+// in '_ctr', the bytes in '_bytesCtr', and both against the destination.
+//
+#define chpl_comm_diags_incr_xfer(_ctr, _bytesCtr, node, size)          \
+  do {                                                                  \
+    if (chpl_comm_diagnostics && chpl_comm_diags_is_enabled()) {        \
+      (void) atomic_fetch_add_uint_least64_t(                           \
+               &chpl_comm_diags_counters._ctr, 1);                      \
+      (void) atomic_fetch_add_uint_least64_t(                           \
+               &chpl_comm_diags_counters._bytesCtr, (size));            \
+      chpl_comm_diags_count_dest(node, size);                           \
     }                                                                   \
   } while(0)
 
+//
+// Total bytes moved by a strided GET or PUT, given the count[] and
+// stridelevels arguments of chpl_comm_{get,put}_strd(), in which only
+// count[0] is scaled by the element size.
+//
+static inline
+size_t chpl_comm_diags_strd_bytes(size_t* count, int32_t stridelevels,
+                                  size_t elemSize) {
+  size_t bytes = elemSize;
+  int i;
+
+  for (i = 0; i <= stridelevels; i++)
+    bytes *= count[i];
+  return bytes;
+}
+
+//
+// Count an executeOn of kind '_ctr' on 'node', whose argument bundle
+// is 'size' bytes.
+//
+#define chpl_comm_diags_incr_executeOn(_ctr, node, size)                \
+  do {                                                                  \
+    if (chpl_comm_diagnostics && chpl_comm_diags_is_enabled()) {        \
+      (void) atomic_fetch_add_uint_least64_t(                           \
+               &chpl_comm_diags_counters._ctr, 1);                      \
+      chpl_comm_diags_count_dest(node, size);                           \
+    }                                                                   \
+  } while(0)
+
+#define chpl_comm_diags_incr_amo(node, size)                            \
+  chpl_comm_diags_incr_executeOn(amo, node, size)
+
+//
+// Latency measurement.  Bracket a remote operation with these; the
+// start returns 0 (and the end then does nothing) when histograms are
+// not being kept, so the cost when they are off is one load.
+//
+static inline
+uint64_t chpl_comm_diags_latency_start(void) {
+  struct timespec ts;
+
+  if (!chpl_comm_diags_latency || !chpl_comm_diags_is_enabled())
+    return 0;
+  (void) clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * 1000000000 + (uint64_t) ts.tv_nsec + 1;
+}
+
+static inline
+void chpl_comm_diags_latency_end(chpl_comm_diags_latency_class_t cls,
+                                 uint64_t t0) {
+  struct timespec ts;
+  uint64_t t1;
+  uint64_t dt;
+  int bucket;
+
+  if (t0 == 0)
+    return;
+  (void) clock_gettime(CLOCK_MONOTONIC, &ts);
+  t1 = (uint64_t) ts.tv_sec * 1000000000 + (uint64_t) ts.tv_nsec + 1;
+  dt = (t1 > t0) ? t1 - t0 : 1;
+  bucket = 63 - (int) chpl_bitops_clz_64(dt);
+  if (bucket >= CHPL_COMM_DIAGS_LATENCY_BUCKETS)
+    bucket = CHPL_COMM_DIAGS_LATENCY_BUCKETS - 1;
+  (void) atomic_fetch_add_uint_least64_t(
+           &chpl_comm_diags_latency_hist[cls][bucket], 1);
+}
+
 #endif
@@ -0,0 +1,130 @@
+/*
+ * Copyright 2004-2019 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _chpl_comm_unordered_h_
+#define _chpl_comm_unordered_h_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "chpltypes.h"
+#include "chpl-comm.h"
+
+//
+// Common aggregation of unordered GETs and non-fetching atomics, for
+// comm layers that have no native support for them.
+//
+// Operations are buffered per thread and per target node.  A buffer
+// is shipped to its target as a single active message when it fills,
+// when chpl_comm_unordered_flush() (the global fence) or
+// chpl_comm_unordered_task_flush() (the task fence) is called.  The
+// comm layer supplies the function that does the shipping; on the
+// target it calls chpl_comm_unordered_apply() on the received batch
+// and returns the GET results to the initiator's result buffer.
+//
+// Atomic operations are applied on the target with processor atomics,
+// so they are not atomic with respect to concurrent NIC atomics on the
+// same object.  Unordered atomics are documented as inconsistent with
+// ordered ones until fenced, so that is acceptable.
+//
+
+typedef enum {
+  chpl_comm_unordered_op_get,
+  chpl_comm_unordered_op_add,
+  chpl_comm_unordered_op_sub,
+  chpl_comm_unordered_op_and,
+  chpl_comm_unordered_op_or,
+  chpl_comm_unordered_op_xor
+} chpl_comm_unordered_opKind_t;
+
+typedef enum {
+  chpl_comm_unordered_type_int32,
+  chpl_comm_unordered_type_int64,
+  chpl_comm_unordered_type_uint32,
+  chpl_comm_unordered_type_uint64,
+  chpl_comm_unordered_type_real32,
+  chpl_comm_unordered_type_real64
+} chpl_comm_unordered_type_t;
+
+//
+// One buffered operation, as shipped to the target.  For a GET, 'size'
+// bytes (at most 8) are read from 'obj' into the next result slot.
+// For an atomic, 'operand' holds the bits of the operand and 'type'
+// says how to interpret it and the object.
+//
+typedef struct {
+  void* obj;                    // object address on the target node
+  uint64_t operand;             // atomic operand
+  uint8_t op;                   // chpl_comm_unordered_opKind_t
+  uint8_t type;                 // chpl_comm_unordered_type_t
+  uint8_t size;                 // GET size in bytes
+} chpl_comm_unordered_op_t;
+
+//
+// Maximum size of a single unordered GET, and an upper bound on the
+// number of operations in one batch.
+//
+#define CHPL_COMM_UNORDERED_MAX_GET_SIZE sizeof(uint64_t)
+#define CHPL_COMM_UNORDERED_MAX_OPS 512
+
+//
+// Ship 'numOps' operations to 'node', have it apply them, and wait
+// until that is done and the 'numGets' results for the GETs among
+// them, in order, have been stored in 'results'.
+//
+typedef void (*chpl_comm_unordered_send_fn_t)(c_nodeid_t node,
+                                              chpl_comm_unordered_op_t* ops,
+                                              int numOps,
+                                              uint64_t* results,
+                                              int numGets);
+
+//
+// Set up the aggregation buffers.  'maxOps' limits the number of
+// operations in a batch, so that it fits in the comm layer's largest
+// active message.
+//
+void chpl_comm_unordered_init(chpl_comm_unordered_send_fn_t sendFn,
+                              int maxOps);
+
+//
+// Initiator side: buffer an operation.  Atomics on this node are
+// applied immediately rather than buffered.
+//
+void chpl_comm_unordered_get(void* addr, c_nodeid_t node, void* raddr,
+                             size_t size);
+void chpl_comm_unordered_amo(c_nodeid_t node, void* object,
+                             chpl_comm_unordered_opKind_t op,
+                             chpl_comm_unordered_type_t type,
+                             const void* operand);
+
+//
+// Flush the buffers of all threads on this node, or only the ones the
+// calling task could have filled.
+//
+void chpl_comm_unordered_flush(void);
+void chpl_comm_unordered_task_flush(void);
+
+//
+// Target side: apply a batch of operations, storing GET results, in
+// order, in 'results'.  Returns the number of results stored.
+//
+int chpl_comm_unordered_apply(const chpl_comm_unordered_op_t* ops,
+                              int numOps, uint64_t* results);
+
+#endif
@@ -517,6 +517,38 @@ typedef struct _chpl_commDiagnostics {
 #undef _COMM_DIAGS_DECL
 } chpl_commDiagnostics;
 
+//
+// Detailed counts, collected along with the ones above: bytes moved by
+// GETs and PUTs, and how many of those were strided or were AMOs.
+//
+#define CHPL_COMM_DIAGS_DETAIL_VARS_ALL(MACRO) \
+  MACRO(get_bytes) \
+  MACRO(put_bytes) \
+  MACRO(get_strd) \
+  MACRO(put_strd) \
+  MACRO(amo)
+
+typedef struct _chpl_commDetailDiagnostics {
+#define _COMM_DIAGS_DECL(cdv) uint64_t cdv;
+  CHPL_COMM_DIAGS_DETAIL_VARS_ALL(_COMM_DIAGS_DECL)
+#undef _COMM_DIAGS_DECL
+} chpl_commDetailDiagnostics;
+
+//
+// Operation classes for which latency histograms can be kept.  Bucket
+// b of a histogram counts operations that took [2**b, 2**(b+1))
+// nanoseconds; the last bucket also counts all slower ones.
+//
+typedef enum {
+  chpl_comm_diags_latency_get,
+  chpl_comm_diags_latency_put,
+  chpl_comm_diags_latency_amo,
+  chpl_comm_diags_latency_execute_on,
+  chpl_comm_diags_latency_num_classes
+} chpl_comm_diags_latency_class_t;
+
+#define CHPL_COMM_DIAGS_LATENCY_BUCKETS 32
+
 void chpl_startVerboseComm(void);
 void chpl_stopVerboseComm(void);
 void chpl_startVerboseCommHere(void);
@@ -532,6 +564,12 @@ void chpl_stopCommDiagnosticsHere(void);
 void chpl_gen_stopCommDiagnosticsHere(void);
 void chpl_resetCommDiagnosticsHere(void);
 void chpl_getCommDiagnosticsHere(chpl_commDiagnostics *cd);
+void chpl_getCommDetailDiagnosticsHere(chpl_commDetailDiagnostics *cd);
+void chpl_getCommMatrixRowHere(uint64_t* ops, uint64_t* bytes);
+void chpl_startCommLatencyHistogramsHere(void);
+void chpl_stopCommLatencyHistogramsHere(void);
+void chpl_getCommLatencyHistogramHere(int32_t latencyClass,
+                                      uint64_t* buckets);
 
 void* chpl_get_global_serialize_table(int64_t idx);
 
@@ -31,17 +31,40 @@ typedef struct chpl_privateObject_s {
   void* obj;
 } chpl_privateObject_t;
 
-// This is a dynamically-allocated array of chpl_privateObject_t.
-extern chpl_privateObject_t* chpl_privateObjects;
+// The privatized objects live in fixed-size chunks that are allocated
+// as needed and never move, so looking one up needs no lock and
+// growing the table doesn't copy (or leak) anything. The directory
+// holds up to 64M privatized objects at once; pids are reused after
+// they are released (see chpl_privatization_releasePid), so that is a
+// limit on the number alive at a time rather than the number ever made.
+#define CHPL_PRIVATIZATION_CHUNK_BITS 10
+#define CHPL_PRIVATIZATION_CHUNK_SIZE (1 << CHPL_PRIVATIZATION_CHUNK_BITS)
+#define CHPL_PRIVATIZATION_MAX_CHUNKS (1 << 16)
 
-// Compiler generates accesses like chpl_privateObjects[i];
-// see chpl_getPrivatizedCopy.
+// Each element is a dynamically-allocated chunk of chpl_privateObject_t,
+// or NULL if no pid in that chunk has been used yet.
+extern chpl_privateObject_t* chpl_privateObjects[CHPL_PRIVATIZATION_MAX_CHUNKS];
+
+// The module code calls this via chpl_getPrivatizedCopy.
 // This allows TBAA information for chpl_privateObjects to be used.
 // At the very least, inlining it would be important for performance.
+static inline
+void* chpl_getPrivatizedClass(int64_t pid) {
+  return chpl_privateObjects[pid >> CHPL_PRIVATIZATION_CHUNK_BITS]
+                            [pid & (CHPL_PRIVATIZATION_CHUNK_SIZE - 1)].obj;
+}
 
 void chpl_clearPrivatizedClass(int64_t);
 
 int64_t chpl_numPrivatizedClasses(void);
 
+// Choose a pid for a new privatized object, preferring ones that have
+// been released. Only called on locale 0, which hands out all pids.
+int64_t chpl_privatization_allocPid(void);
+
+// Make a pid available for reuse. Only called on locale 0, and only
+// once the pid has been cleared on every locale.
+void chpl_privatization_releasePid(int64_t);
+
 #endif // LAUNCHER
 #endif // _chpl_privatization_h_
@@ -28,4 +28,63 @@
     chpl_comm_impl_regMemHeapInfo(start_p, size_p)
 void chpl_comm_impl_regMemHeapInfo(void** start_p, size_t* size_p);
 
+//
+// Unordered ops, aggregated per target node (see chpl-comm-unordered.h)
+//
+void chpl_comm_get_unordered(void *addr, c_nodeid_t node, void* raddr,
+                             size_t size, int32_t typeIndex, int32_t commID,
+                             int ln, int32_t fn);
+
+void chpl_comm_getput_unordered(c_nodeid_t dst_locale, void* dst_addr,
+                                c_nodeid_t src_locale, void* src_addr,
+                                size_t size, int32_t typeIndex,
+                                int32_t commID, int ln, int32_t fn);
+
+void chpl_comm_get_unordered_fence(void);
+void chpl_comm_get_unordered_task_fence(void);
+
+//
+// Unordered non-fetching atomics on processor atomic objects.  These
+// have the same interface as the network atomic ones declared in
+// chpl-comm-native-atomics.h.
+//
+#define DECL_CHPL_COMM_ATOMIC_UNORDERED_BINARY(op, type)                \
+  void chpl_comm_atomic_ ## op ## _unordered_ ## type                   \
+         (void* operand, c_nodeid_t node, void* object,                 \
+          int ln, int32_t fn);
+
+DECL_CHPL_COMM_ATOMIC_UNORDERED_BINARY(and, int32)
+DECL_CHPL_COMM_ATOMIC_UNORDERED_BINARY(and, int64)
+DECL_CHPL_COMM_ATOMIC_UNORDERED_BINARY(and, uint32)
+DECL_CHPL_COMM_ATOMIC_UNORDERED_BINARY(and, uint64)
+
+DECL_CHPL_COMM_ATOMIC_UNORDERED_BINARY(or, int32)
+DECL_CHPL_COMM_ATOMIC_UNORDERED_BINARY(or, int64)
+DECL_CHPL_COMM_ATOMIC_UNORDERED_BINARY(or, uint32)
+DECL_CHPL_COMM_ATOMIC_UNORDERED_BINARY(or, uint64)
+
+DECL_CHPL_COMM_ATOMIC_UNORDERED_BINARY(xor, int32)
+DECL_CHPL_COMM_ATOMIC_UNORDERED_BINARY(xor, int64)
+DECL_CHPL_COMM_ATOMIC_UNORDERED_BINARY(xor, uint32)
+DECL_CHPL_COMM_ATOMIC_UNORDERED_BINARY(xor, uint64)
+
+DECL_CHPL_COMM_ATOMIC_UNORDERED_BINARY(add, int32)
+DECL_CHPL_COMM_ATOMIC_UNORDERED_BINARY(add, int64)
+DECL_CHPL_COMM_ATOMIC_UNORDERED_BINARY(add, uint32)
+DECL_CHPL_COMM_ATOMIC_UNORDERED_BINARY(add, uint64)
+DECL_CHPL_COMM_ATOMIC_UNORDERED_BINARY(add, real32)
+DECL_CHPL_COMM_ATOMIC_UNORDERED_BINARY(add, real64)
+
+DECL_CHPL_COMM_ATOMIC_UNORDERED_BINARY(sub, int32)
+DECL_CHPL_COMM_ATOMIC_UNORDERED_BINARY(sub, int64)
+DECL_CHPL_COMM_ATOMIC_UNORDERED_BINARY(sub, uint32)
+DECL_CHPL_COMM_ATOMIC_UNORDERED_BINARY(sub, uint64)
+DECL_CHPL_COMM_ATOMIC_UNORDERED_BINARY(sub, real32)
+DECL_CHPL_COMM_ATOMIC_UNORDERED_BINARY(sub, real64)
+
+#undef DECL_CHPL_COMM_ATOMIC_UNORDERED_BINARY
+
+void chpl_comm_atomic_unordered_fence(void);
+void chpl_comm_atomic_unordered_task_fence(void);
+
 #endif // _chpl_comm_impl_h_
@@ -37,4 +37,22 @@ size_t chpl_comm_impl_regMemHeapPageSize(void);
 //
 #include "chpl-comm-native-atomics.h"
 
+//
+// Unordered ops, aggregated per target node (see chpl-comm-unordered.h).
+// These are only built on request; see comm/ofi/Makefile.share.
+//
+#ifdef CHPL_COMM_OFI_UNORDERED_AGGREGATION
+void chpl_comm_get_unordered(void *addr, c_nodeid_t node, void* raddr,
+                             size_t size, int32_t typeIndex, int32_t commID,
+                             int ln, int32_t fn);
+
+void chpl_comm_getput_unordered(c_nodeid_t dst_locale, void* dst_addr,
+                                c_nodeid_t src_locale, void* src_addr,
+                                size_t size, int32_t typeIndex,
+                                int32_t commID, int ln, int32_t fn);
+
+void chpl_comm_get_unordered_fence(void);
+void chpl_comm_get_unordered_task_fence(void);
+#endif
+
 #endif // _chpl_comm_impl_h_
@@ -105,12 +105,22 @@ struct chpl_comm_bundleData_AMO_t {
   chpl_comm_amDone_t* pDone;    // initiator's 'done' flag; nonblocking if NULL
 };
 
+struct chpl_comm_bundleData_unordered_t {
+  struct chpl_comm_bundleData_base_t b;
+  void* ops;                    // address of op batch, on initiator
+  int32_t numOps;               // number of ops in batch
+  void* results;                // GET results address, on initiator
+  int32_t numGets;              // number of GETs in batch
+  chpl_comm_amDone_t* pDone;    // initiator's 'done' flag
+};
+
 typedef union {
   struct chpl_comm_bundleData_base_t b;
   struct chpl_comm_bundleData_execOn_t xo;
   struct chpl_comm_bundleData_execOnLrg_t xol;
   struct chpl_comm_bundleData_RMA_t rma;
   struct chpl_comm_bundleData_AMO_t amo;
+  struct chpl_comm_bundleData_unordered_t uo;
 } chpl_comm_bundleData_t;
 
 //
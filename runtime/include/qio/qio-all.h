@@ -31,4 +31,5 @@
 #include "qio_plugin_hdfs.h"
 #include "qio_plugin_curl.h"
 #include "qio_popen.h"
+#include "qio_uring.h"
 
@@ -287,6 +287,8 @@ static inline void qio_lock_destroy(qio_lock_t* x) { int rc = pthread_mutex_dest
 extern ssize_t qio_too_small_for_default_mmap;
 extern ssize_t qio_too_large_for_default_mmap;
 extern ssize_t qio_mmap_chunk_iobufs;
+extern ssize_t qio_mmap_sequential_chunk_iobufs;
+extern ssize_t qio_mmap_hugepage_min;
 
 #ifdef __cplusplus
 extern "C" {
@@ -338,6 +340,9 @@ char* qio_chtype_to_string(qio_chtype_t type);
      -- noreuse -- pread/pwrite
      -- cached -- mmap for reads and writes
      -- force_readwrite
+     -- iouring -- only when requested; like pread/pwrite, but the
+        I/O is submitted to an io_uring and the task yields while
+        it is in flight. See qio_uring.h.
  */
 
 #define QIO_HINT_AFTERCHTYPE 0x0010
@@ -348,13 +353,14 @@ typedef enum {
   QIO_METHOD_FREADFWRITE = 3*QIO_HINT_AFTERCHTYPE,
   QIO_METHOD_MMAP = 4*QIO_HINT_AFTERCHTYPE,
   QIO_METHOD_MEMORY = 5*QIO_HINT_AFTERCHTYPE,
+  QIO_METHOD_IOURING = 6*QIO_HINT_AFTERCHTYPE,
   //QIO_METHOD_LIBEVENT,
 } qio_method_t;
 #define QIO_METHODMASK 0x00f0
 #define QIO_HINT_AFTERMETHOD 0x0100
 #define QIO_METHOD_DEFAULT 0
 #define QIO_MIN_METHOD QIO_METHOD_READWRITE
-#define QIO_MAX_METHOD QIO_METHOD_MEMORY
+#define QIO_MAX_METHOD QIO_METHOD_IOURING
 
 enum {
   QIO_HINT_RANDOM       = QIO_HINT_AFTERMETHOD,
@@ -449,6 +455,9 @@ char* qio_hints_to_string(qio_hint_t hint)
       case QIO_METHOD_MEMORY:
         strcat(buf, " memory"); ok = 1;
         break;
+      case QIO_METHOD_IOURING:
+        strcat(buf, " iouring"); ok = 1;
+        break;
       // no default to get warned if any are added.
     }
   }
@@ -577,6 +586,7 @@ qioerr qio_file_open_access_usr(qio_file_t** file_out, const char* pathname,
 qioerr qio_get_fs_type(qio_file_t* fl, int* out);
 qioerr qio_get_chunk(qio_file_t* fl, int64_t* len_out);
 qioerr qio_locales_for_region(qio_file_t* fl, off_t start, off_t end, const char*** locale_names_out, int* num_locs_out);
+qioerr qio_file_find_splits(qio_file_t* file, int64_t start, int64_t end, int64_t nsplits, int byte, int64_t* offsets_out);
 
 // This can be called to run close and to check the return value.
 // That's important because some implementations (such as NFS)
@@ -0,0 +1,53 @@
+/*
+ * Copyright 2004-2019 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _QIO_URING_H_
+#define _QIO_URING_H_
+
+#include "sys_basic.h"
+#include "qio.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* These implement QIO_METHOD_IOURING. Reads and writes are submitted
+ * to a Linux io_uring shared by the calling thread and others, and the
+ * calling task yields while they are in flight instead of blocking its
+ * thread in a system call.
+ *
+ * When io_uring is not available (not Linux, headers too old, or the
+ * kernel refuses to create a ring), these fall back to the same
+ * system calls that QIO_METHOD_PREADPWRITE uses.
+ */
+
+// returns 1 if reads and writes will actually go through io_uring.
+int qio_uring_available(void);
+
+qioerr qio_uring_preadv(qio_file_t* file, qbuffer_t* buf, qbuffer_iter_t start, qbuffer_iter_t end, int64_t seek_to_offset, ssize_t* num_read);
+qioerr qio_uring_pwritev(qio_file_t* file, qbuffer_t* buf, qbuffer_iter_t start, qbuffer_iter_t end, int64_t seek_to_offset, ssize_t* num_written);
+
+qioerr qio_uring_pread(fd_t fd, void* buf, size_t count, off_t offset, ssize_t* num_read);
+qioerr qio_uring_pwrite(fd_t fd, const void* buf, size_t count, off_t offset, ssize_t* num_written);
+
+#ifdef __cplusplus
+} // end extern "C"
+#endif
+
+#endif
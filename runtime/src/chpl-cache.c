@@ -180,6 +180,16 @@ from an 8 byte request. We chose 1024 bytes for the cache page size because it
 is the smallest request size that allows close to peak bandwidth in our
 network.
 
+Other networks (and other workloads) call for other choices, so the page and
+line sizes can be changed at program startup with the CHPL_RT_CACHE_PAGE_SIZE
+and CHPL_RT_CACHE_LINE_SIZE environment variables. Since read ahead is the
+only way to aggregate GETs beyond a single page, the maximum readahead window
+can also be set (in pages) with CHPL_RT_CACHE_READAHEAD_PAGES. Setting
+CHPL_RT_CACHE_ADAPTIVE_READAHEAD instead lets each cache grow its readahead
+window while the pages it reads ahead are being used (as for streaming
+access) and shrink it while they are being discarded unread (as for random
+access).
+
 When processing a GET, we first check to see if the requested cache page is
 in the pointer tree. If not, we find an unused cache page and immediately start
 a nonblocking get into the appropriate portion of that page. While the get is
@@ -244,6 +254,22 @@ the sequence number of the last acquire barrier. If a task performs a GET but
 finds a cache entry with a minimum sequence number before its last acquire
 barrier, it must invalidate that cache line and do a new GET.
 
+Since there is one cache per pthread, a remote page read by many threads on
+the same locale is normally fetched once per thread. Setting
+CHPL_RT_CACHE_SHARED_PAGES to a nonzero number of pages enables a per-locale
+shared read tier that the per-thread caches consult before starting a GET for
+a page they do not have. The shared tier is a direct-mapped table of pages,
+each protected by a sequence lock (seqlock): readers copy a page out and then
+check that its version did not change, and writers only try-lock a slot,
+skipping publication if another thread is already writing it. Whole pages
+fetched by a per-thread cache miss are published there. To preserve the
+acquire/release rules above, every GET that fills the shared tier is stamped
+with a locale-wide counter before it is started, and each per-thread cache
+records the value of that counter at its latest acquire fence and whenever its
+own PUTs complete. A shared page may only be used if it was stamped after
+that point, so it cannot be older than an acquire barrier or one of this
+thread's own writes.
+
 Lastly, since the implementation uses thread-local storage for the cache, it
 requires that tasks not move between threads. Tasks could move between threads
 if we had a way to notify the cache that they were about to do so (in which
@@ -279,6 +305,7 @@ use.
 #include "chpl-atomics.h"
 #include "chpl-thread-local-storage.h" // CHPL_TLS_DECL etc
 #include "chpl-cache.h"
+#include "chpl-env.h"
 #include "chpl-linefile-support.h"
 #include "sys.h" // sys_page_size()
 #include "chpl-comm-compiler-macros.h"
@@ -310,8 +337,13 @@ use.
 // Reasonable values for CACHEPAGE_BITS are between 6 and 12
 // (64 bytes and 4k bytes. CACHEPAGE_BITS should not be larger than the
 // page size) and it must currently be even.
-// Here we set it to 1k bytes (ie 2^10).
-#define CACHEPAGE_BITS 10
+// By default we set it to 1k bytes (ie 2^10), but it can be changed
+// at program startup with CHPL_RT_CACHE_PAGE_SIZE (in bytes).
+#define MIN_CACHEPAGE_BITS 6
+#define MAX_CACHEPAGE_BITS 12
+#define DEFAULT_CACHEPAGE_BITS 10
+static int cachepage_bits = DEFAULT_CACHEPAGE_BITS;
+#define CACHEPAGE_BITS cachepage_bits
 #define CACHEPAGE_SIZE (1 << CACHEPAGE_BITS)
 #define CACHEPAGE_MASK (CACHEPAGE_SIZE-1)
 
@@ -320,27 +352,68 @@ use.
 // that are fetched for any 'get' operation.
 //
 // Reasonable values for CACHELINE_BITS are between 6 and CACHEPAGE_BITS.
-// Here we set it to 64 bytes (ie 2^6)
-#define CACHELINE_BITS 6
+// By default we set it to 64 bytes (ie 2^6), but it can be changed
+// at program startup with CHPL_RT_CACHE_LINE_SIZE (in bytes).
+#define MIN_CACHELINE_BITS 6
+#define DEFAULT_CACHELINE_BITS 6
+static int cacheline_bits = DEFAULT_CACHELINE_BITS;
+#define CACHELINE_BITS cacheline_bits
 #define CACHELINE_SIZE (1 << CACHELINE_BITS)
 #define CACHELINE_MASK (CACHELINE_SIZE-1)
 
 // What type can store the number of cache lines in a cache page?
 typedef int8_t line_per_page_t; 
-// What type for a number of lines to read ahead?
-typedef int16_t readahead_distance_t;
+// What type for a number of bytes to read ahead?
+typedef int32_t readahead_distance_t;
 
 // When prefetching, what is the maximum number of pages
-// we are willing to prefetch? This is also the maximum
-// readahead window size for sequential access.
+// we are willing to prefetch? This is also the default maximum
+// readahead window size for sequential access, which can be changed
+// at program startup with CHPL_RT_CACHE_READAHEAD_PAGES.
 #define MAX_PAGES_PER_PREFETCH 2
+static int readahead_pages = MAX_PAGES_PER_PREFETCH;
 
 // Should we enable sequential readahead?
 // For sequential access If we're reading  
 #define ENABLE_READAHEAD 1
 #define ENABLE_READAHEAD_TRIGGER_WITHIN_PAGE 1
 #define ENABLE_READAHEAD_TRIGGER_SEQUENTIAL 0
-#define MAX_SEQUENTIAL_READAHEAD_BYTES (MAX_PAGES_PER_PREFETCH*CACHEPAGE_SIZE)
+
+// Adaptive readahead (enabled with CHPL_RT_CACHE_ADAPTIVE_READAHEAD).
+// Each cache keeps track of how many pages brought in by readahead
+// were later read and how many were evicted or invalidated without
+// being read. After every READAHEAD_ADAPT_INTERVAL such outcomes,
+// the cache doubles its readahead window (up to
+// MAX_ADAPTIVE_READAHEAD_PAGES) if most readahead pages were used,
+// as happens for streaming access, or halves it (down to one page)
+// if most were wasted, as happens for random access.
+static int adaptive_readahead = 0;
+#define MAX_ADAPTIVE_READAHEAD_PAGES 32
+#define READAHEAD_ADAPT_INTERVAL 64
+#define READAHEAD_GROW_PCT 75
+#define READAHEAD_SHRINK_PCT 25
+
+// Per-locale shared read tier (enabled with CHPL_RT_CACHE_SHARED_PAGES).
+// shared_clock stamps GETs that fill the shared tier; see the
+// discussion at the top of this file.
+struct shared_page_s {
+  // Sequence lock; odd while a writer is updating this slot.
+  atomic_uint_least64_t version;
+  c_nodeid_t node;
+  uintptr_t raddr; // page-aligned remote address; 0 if the slot is empty
+  uint64_t stamp;  // shared_clock value taken before the GET was started
+  unsigned char* page;
+};
+
+static int shared_num_pages = 0;
+static struct shared_page_s* shared_pages = NULL;
+static atomic_uint_least64_t shared_clock;
+
+// Strided GETs/PUTs are broken into their contiguous chunks, and each
+// chunk that spans at most this many pages goes through the cache.
+// Larger chunks would just churn Ain, so for those we only flush and
+// invalidate the overlapping pages and then transfer directly.
+#define MAX_PAGES_PER_STRIDED_CHUNK 16
 
 //#define TIME
 //#define TRACE
@@ -443,6 +516,8 @@ struct rdcache_s;
 // How many uint64_t words do we need to create a bitmask for CACHEPAGE_SIZE?
 // Divide # bytes in cache by 64, rounding up.
 #define CACHEPAGE_BITMASK_WORDS ((CACHEPAGE_SIZE+63)/64)
+// ... and for the largest page size we support (for sizing arrays)
+#define MAX_CACHEPAGE_BITMASK_WORDS (((1 << MAX_CACHEPAGE_BITS)+63)/64)
 
 // How many cache lines per cache page?
 #define CACHE_LINES_PER_PAGE (CACHEPAGE_SIZE/CACHELINE_SIZE)
@@ -450,6 +525,9 @@ struct rdcache_s;
 // How many uint64_t words do we need to create a bitmask for CACHE_LINES_PER_PAGE
 // ie, a mask recording a bit per cache line?
 #define CACHE_LINES_PER_PAGE_BITMASK_WORDS (((CACHEPAGE_SIZE/CACHELINE_SIZE)+63)/64)
+// ... and for the most lines per page we support (for sizing arrays)
+#define MAX_CACHE_LINES_PER_PAGE_BITMASK_WORDS \
+  ((((1 << MAX_CACHEPAGE_BITS) >> MIN_CACHELINE_BITS)+63)/64)
 
 struct cache_entry_base_s {
   uint32_t index_bits;
@@ -472,7 +550,7 @@ struct dirty_entry_s {
   // which cache entry are we talking about here?
   struct cache_entry_s* entry;
   // Which of the page's bytes are dirty?
-  uint64_t dirty[CACHEPAGE_BITMASK_WORDS]; // ie we need to create a put for these bytes
+  uint64_t dirty[MAX_CACHEPAGE_BITMASK_WORDS]; // ie we need to create a put for these bytes
 };
 
 #define QUEUE_FREE 0
@@ -502,6 +580,8 @@ struct cache_entry_s {
   // Readahead information.
   readahead_distance_t readahead_skip;
   readahead_distance_t readahead_len; // == 0 if this page doesn't trigger readahead.
+  // Was this page brought in by readahead without being read since?
+  int readahead_unused;
   // These are the queue links. Am is LRU but Ain and Aout are FIFO
   struct cache_entry_s* next; // next entry in Ain/Aout/Am
   struct cache_entry_s* prev; // previous entry in An/Aout/Am
@@ -509,7 +589,7 @@ struct cache_entry_s {
   // This refers to CACHEPAGE_SIZE bytes of memory.
   unsigned char* page;
   // Which of the cache lines have we done 'get's for?
-  uint64_t valid_lines[CACHE_LINES_PER_PAGE_BITMASK_WORDS];
+  uint64_t valid_lines[MAX_CACHE_LINES_PER_PAGE_BITMASK_WORDS];
   // dirty info if this cache page is dirty, NULL otherwise.
   struct dirty_entry_s* dirty;
   // What is the minimum sequence number stored in this cache entry?
@@ -548,7 +628,7 @@ static int set_valid_lines(uint64_t* valid, uintptr_t skip, uintptr_t len)
 // Note skip/len are in line numbers, NOT byte offsets!
 static void unset_valid_lines(uint64_t* valid, uintptr_t skip, uintptr_t len)
 {
-  uint64_t myvalid[CACHE_LINES_PER_PAGE_BITMASK_WORDS];
+  uint64_t myvalid[MAX_CACHE_LINES_PER_PAGE_BITMASK_WORDS];
   unset_valids_for_skip_len(valid, myvalid, skip, len, CACHE_LINES_PER_PAGE_BITMASK_WORDS);  
 }
 /*
@@ -585,6 +665,22 @@ struct rdcache_s {
   c_nodeid_t last_cache_miss_read_node;
   raddr_t last_cache_miss_read_addr;
 
+  // The current maximum readahead window, in pages, along with how
+  // many readahead pages were used or wasted since it last changed.
+  int readahead_pages;
+  uint64_t readahead_window_used;
+  uint64_t readahead_window_wasted;
+
+  // Pages in the shared read tier stamped at or before this value
+  // might be older than our last acquire fence or our last PUT.
+  uint64_t shared_floor;
+
+  // Diagnostic counters for this cache, and links in the list of
+  // all of this locale's caches (used to sum them up).
+  chpl_cacheDiagnostics diags;
+  struct rdcache_s* next_cache;
+  struct rdcache_s* prev_cache;
+
   // The variable names Ain Aout and Am come from the 2Q paper
 
   // Ain is a FIFO queue storing entries initially as they go into
@@ -672,6 +768,38 @@ struct rdcache_s {
 
 static void validate_cache(struct rdcache_s* tree);
 
+#define CACHE_DIAGS_INCR(cache, cdv) ((cache)->diags.cdv++)
+
+// All of this locale's caches, so that their diagnostics can be summed.
+// Counts from caches that have been destroyed are kept in retired_diags.
+static chpl_thread_mutex_t all_caches_lock;
+static struct rdcache_s* all_caches_head = NULL;
+static chpl_cacheDiagnostics retired_diags;
+
+static
+void cache_register(struct rdcache_s* cache)
+{
+  chpl_thread_mutexLock(&all_caches_lock);
+  cache->prev_cache = NULL;
+  cache->next_cache = all_caches_head;
+  if( all_caches_head ) all_caches_head->prev_cache = cache;
+  all_caches_head = cache;
+  chpl_thread_mutexUnlock(&all_caches_lock);
+}
+
+static
+void cache_unregister(struct rdcache_s* cache)
+{
+  chpl_thread_mutexLock(&all_caches_lock);
+#define _CACHE_DIAGS_RETIRE(cdv) retired_diags.cdv += cache->diags.cdv;
+  CHPL_CACHE_DIAGS_VARS_ALL(_CACHE_DIAGS_RETIRE)
+#undef _CACHE_DIAGS_RETIRE
+  if( cache->prev_cache ) cache->prev_cache->next_cache = cache->next_cache;
+  else all_caches_head = cache->next_cache;
+  if( cache->next_cache ) cache->next_cache->prev_cache = cache->prev_cache;
+  chpl_thread_mutexUnlock(&all_caches_lock);
+}
+
 
 static
 struct rdcache_s* cache_create(void) {
@@ -767,6 +895,15 @@ struct rdcache_s* cache_create(void) {
   c->last_cache_miss_read_node = -1;
   c->last_cache_miss_read_addr = 0;
 
+  c->readahead_pages = readahead_pages;
+  c->readahead_window_used = 0;
+  c->readahead_window_wasted = 0;
+
+  c->shared_floor = 0;
+
+  memset(&c->diags, 0, sizeof(c->diags));
+  cache_register(c);
+
   c->max_pages = cache_pages;
   c->max_entries = n_entries;
   c->max_top_nodes = top_entries;
@@ -856,6 +993,7 @@ struct rdcache_s* cache_create(void) {
 
 static
 void cache_destroy(struct rdcache_s *cache) {
+  cache_unregister(cache);
   chpl_free(cache);
 }
 
@@ -1127,6 +1265,8 @@ void aout_evict(struct rdcache_s* cache)
 
   if( !z ) return;
 
+  CACHE_DIAGS_INCR(cache, evictions_aout);
+
   // Remove the tail element from Aout
   DOUBLE_REMOVE_TAIL(cache, aout);
   cache->aout_current--;
@@ -1164,6 +1304,8 @@ void ain_evict(struct rdcache_s* cache, struct cache_entry_s* dont_evict_me)
   rdcache_print(cache);
 #endif
 
+  CACHE_DIAGS_INCR(cache, evictions_ain);
+
   // If the entry in Ain has any pending/dirty requests, we must
   // immediately wait for them to complete, before we modify the contents
   // of Ain in any way (or reuse the associated page).
@@ -1202,6 +1344,8 @@ void am_evict(struct rdcache_s *cache, struct cache_entry_s* dont_evict_me) {
     DOUBLE_PUSH_TAIL(cache, dont_evict_me, am_lru);
   }
 
+  CACHE_DIAGS_INCR(cache, evictions_am);
+
   // If the entry in Am has any pending/dirty requests, we must
   // immediately wait for them to complete, before we modify the contents
   // of Ain in any way (or reuse the associated page).
@@ -1366,6 +1510,74 @@ static void use_dirty(struct rdcache_s* cache, struct dirty_entry_s* dirty)
 }
 
 
+static inline
+void shared_update_floor(struct rdcache_s* cache)
+{
+  if( shared_pages )
+    cache->shared_floor = atomic_load_uint_least64_t(&shared_clock);
+}
+
+static inline
+struct shared_page_s* shared_slot(c_nodeid_t node, raddr_t ra_page)
+{
+  uint64_t h = (ra_page >> CACHEPAGE_BITS) ^
+               ((uint64_t) node * 0x9e3779b97f4a7c15ULL);
+  return &shared_pages[h % shared_num_pages];
+}
+
+// Copy the page at node:ra_page from the shared read tier into page,
+// if it is there and new enough for this cache. Returns 1 on success.
+static
+int shared_lookup(struct rdcache_s* cache, c_nodeid_t node, raddr_t ra_page,
+                  unsigned char* page)
+{
+  struct shared_page_s* slot = shared_slot(node, ra_page);
+  uint64_t v;
+
+  v = atomic_load_explicit_uint_least64_t(&slot->version,
+                                           memory_order_acquire);
+  if( v & 1 ) return 0;
+  if( slot->raddr != ra_page || slot->node != node ||
+      slot->stamp <= cache->shared_floor ) return 0;
+
+  chpl_memcpy(page, slot->page, CACHEPAGE_SIZE);
+
+  chpl_atomic_thread_fence(memory_order_acquire);
+  if( atomic_load_explicit_uint_least64_t(&slot->version,
+                                          memory_order_relaxed) != v )
+    return 0;
+
+  return 1;
+}
+
+// Offer a whole page that was fetched with the given stamp to the
+// shared read tier. Gives up if another thread is writing the slot.
+static
+void shared_publish(c_nodeid_t node, raddr_t ra_page, unsigned char* page,
+                    uint64_t stamp)
+{
+  struct shared_page_s* slot = shared_slot(node, ra_page);
+  uint64_t v;
+
+  v = atomic_load_explicit_uint_least64_t(&slot->version,
+                                           memory_order_relaxed);
+  if( v & 1 ) return;
+  // Don't replace a newer copy of the same page.
+  if( slot->raddr == ra_page && slot->node == node && slot->stamp >= stamp )
+    return;
+  if( ! atomic_compare_exchange_strong_explicit_uint_least64_t(
+            &slot->version, v, v + 1, memory_order_acquire) )
+    return;
+
+  slot->node = node;
+  slot->raddr = ra_page;
+  slot->stamp = stamp;
+  chpl_memcpy(slot->page, page, CACHEPAGE_SIZE);
+
+  atomic_store_explicit_uint_least64_t(&slot->version, v + 2,
+                                       memory_order_release);
+}
+
 static
 void do_wait_for(struct rdcache_s* cache, cache_seqn_t sn);
 
@@ -1668,11 +1880,56 @@ void do_wait_for(struct rdcache_s* cache, cache_seqn_t sn)
     }
   }
 
+  if( max_completed != cache->completed_request_number ) {
+    // Our completed PUTs must be visible in any shared page we use.
+    shared_update_floor(cache);
+  }
+
   cache->completed_request_number = max_completed;
 }
 
 
 
+// Record whether a page brought in by readahead was read (used) or
+// dropped without being read, and with adaptive readahead, resize
+// this cache's readahead window accordingly.
+static
+void note_readahead_outcome(struct rdcache_s* cache,
+                            struct cache_entry_s* entry, int used)
+{
+  uint64_t total;
+
+  entry->readahead_unused = 0;
+
+  if( used ) {
+    cache->readahead_window_used++;
+    CACHE_DIAGS_INCR(cache, readahead_used);
+  } else {
+    cache->readahead_window_wasted++;
+    CACHE_DIAGS_INCR(cache, readahead_wasted);
+  }
+
+  if( ! adaptive_readahead ) return;
+
+  total = cache->readahead_window_used + cache->readahead_window_wasted;
+  if( total < READAHEAD_ADAPT_INTERVAL ) return;
+
+  if( 100 * cache->readahead_window_used >= READAHEAD_GROW_PCT * total ) {
+    if( cache->readahead_pages < MAX_ADAPTIVE_READAHEAD_PAGES )
+      cache->readahead_pages *= 2;
+  } else if( 100 * cache->readahead_window_used <=
+             READAHEAD_SHRINK_PCT * total ) {
+    if( cache->readahead_pages > 1 )
+      cache->readahead_pages /= 2;
+  }
+
+  INFO_PRINT(("%i readahead window now %i pages\n",
+              (int) chpl_nodeID, cache->readahead_pages));
+
+  cache->readahead_window_used = 0;
+  cache->readahead_window_wasted = 0;
+}
+
 // For the region of this page in raddr,len, we complete any pending/not
 // started operations that possibly overlap with that region.
 // If FLUSH_EVICT or FLUSH_INVALIDATE_PAGE is set, we will ignore the region.
@@ -1742,6 +1999,7 @@ void flush_entry(struct rdcache_s* cache, struct cache_entry_s* entry, int op,
 
           // Save the handle in the list of pending requests.
           entry->max_put_sequence_number = pending_push(cache, handle);
+          CACHE_DIAGS_INCR(cache, write_behind_flushes);
 
           // Move past this region of 1s in dirty bits.
           start = got_skip + got_len;
@@ -1775,6 +2033,7 @@ void flush_entry(struct rdcache_s* cache, struct cache_entry_s* entry, int op,
   // If invalidating, clear valid bits.
   if( op & FLUSH_DO_INVALIDATE ) {
     if( len == CACHEPAGE_SIZE ) {
+      if( entry->readahead_unused ) note_readahead_outcome(cache, entry, 0);
       entry->readahead_skip = 0;
       entry->readahead_len = 0;
       entry->min_sequence_number = NO_SEQUENCE_NUMBER;
@@ -1788,6 +2047,7 @@ void flush_entry(struct rdcache_s* cache, struct cache_entry_s* entry, int op,
 
   // If evicting, remove the page from the cache and put it on a free list.
   if( op & FLUSH_DO_EVICT ) {
+    if( entry->readahead_unused ) note_readahead_outcome(cache, entry, 0);
     // But, our entry no longer can have a page associated with it.
     page = entry->page;
     entry->page = NULL;
@@ -1879,6 +2139,7 @@ struct cache_entry_s* make_entry(struct rdcache_s* tree,
     bottom_match->queue = QUEUE_AM;
     bottom_match->readahead_skip = 0;
     bottom_match->readahead_len = 0;
+    bottom_match->readahead_unused = 0;
     // Set the page to the one the caller already allocated
     bottom_match->page = page;
     // Clear the valid lines
@@ -1905,6 +2166,7 @@ struct cache_entry_s* make_entry(struct rdcache_s* tree,
     bottom_tmp->queue = QUEUE_AIN;
     bottom_tmp->readahead_skip = 0;
     bottom_tmp->readahead_len = 0;
+    bottom_tmp->readahead_unused = 0;
 
     bottom_tmp->next = NULL;
     bottom_tmp->prev = NULL;
@@ -1994,6 +2256,8 @@ void cache_put(struct rdcache_s* cache,
       // Nonblocking GETs and PUTs must not have their buffers changed
       // during operation. And, we don't want an earlier prefetch to overwrite
       // our later write!
+      if( ! entry_after_acquire )
+        CACHE_DIAGS_INCR(cache, fence_invalidations);
       flush_entry(cache, entry,
                   entry_after_acquire?FLUSH_PREPARE_PUT:FLUSH_INVALIDATE_PAGE,
                   requested_start, requested_size);
@@ -2123,8 +2387,8 @@ void cache_get_trigger_readahead(struct rdcache_s* cache,
   if( ENABLE_READAHEAD && skip && ! is_congested(cache) ) {
     next_ra_length = 2 * len;
 
-    if( next_ra_length > MAX_SEQUENTIAL_READAHEAD_BYTES )
-      next_ra_length = MAX_SEQUENTIAL_READAHEAD_BYTES;
+    if( next_ra_length > cache->readahead_pages * CACHEPAGE_SIZE )
+      next_ra_length = cache->readahead_pages * CACHEPAGE_SIZE;
 
     if( skip < 0 )
       next_ra_length = - next_ra_length;
@@ -2178,6 +2442,7 @@ void cache_get_trigger_readahead(struct rdcache_s* cache,
     if( ok && prefetch_start < prefetch_end ) {
       INFO_PRINT(("%i starting readahead from %p to %p\n",
                   (int) chpl_nodeID, (void*) (prefetch_start), (void*) (prefetch_end)));
+      CACHE_DIAGS_INCR(cache, readahead_triggered);
       cache_get(cache, NULL /* prefetch */,
                 node,
                 prefetch_start, prefetch_end - prefetch_start,
@@ -2252,6 +2517,9 @@ void cache_get(struct rdcache_s* cache,
   chpl_comm_nb_handle_t handle;
   uintptr_t readahead_len, readahead_skip;
   int ra;
+  int max_prefetch_pages;
+  int share_page;
+  uint64_t shared_stamp = 0;
 #ifdef TIME
   struct timespec start_get1, start_get2, wait1, wait2;
 #endif
@@ -2278,8 +2546,11 @@ void cache_get(struct rdcache_s* cache,
 
   // If the request is too large to reasonably fit in the cache, limit
   // the amount of data prefetched. (or do nothing?)
-  if( isprefetch && (ra_last_page-ra_first_page)/CACHEPAGE_SIZE+1 > MAX_PAGES_PER_PREFETCH ) {
-    ra_last_page = ra_first_page + CACHEPAGE_SIZE*MAX_PAGES_PER_PREFETCH;
+  // Readahead is limited by this cache's readahead window instead.
+  max_prefetch_pages = sequential_readahead_length ? cache->readahead_pages
+                                                   : MAX_PAGES_PER_PREFETCH;
+  if( isprefetch && (ra_last_page-ra_first_page)/CACHEPAGE_SIZE+1 > max_prefetch_pages ) {
+    ra_last_page = ra_first_page + CACHEPAGE_SIZE*max_prefetch_pages;
   }
 
   // Try to find it in the cache. Go through one page at a time.
@@ -2405,6 +2676,9 @@ void cache_get(struct rdcache_s* cache,
         // If the cache line is in Am, move it to the front of Am.
         use_entry(cache, entry);
         if( ! isprefetch ) {
+          CACHE_DIAGS_INCR(cache, get_hits);
+          if( entry->readahead_unused )
+            note_readahead_outcome(cache, entry, 1);
       
           //printf("cache hit on page %i:%p %p ra_len %i\n", 
           //       node, (void*) ra_page, (void*) requested_start,
@@ -2449,6 +2723,8 @@ void cache_get(struct rdcache_s* cache,
       // Prefetches might not yet have filled in the data according
       // to the promised valid bits. GETs and PUTs must not have
       // their buffers changed during operation.
+      if( ! entry_after_acquire )
+        CACHE_DIAGS_INCR(cache, fence_invalidations);
       flush_entry(cache, entry,
                   entry_after_acquire?FLUSH_PREPARE_GET:FLUSH_INVALIDATE_PAGE,
                   ra_line, ra_line_end-ra_line);
@@ -2461,6 +2737,35 @@ void cache_get(struct rdcache_s* cache,
       page = allocate_page(cache);
     }
 
+    // For a page we don't have at all, another thread on this locale
+    // might have recently fetched it into the shared read tier.
+    share_page = 0;
+    if( shared_pages && ! isprefetch && ! entry ) {
+      if( shared_lookup(cache, node, ra_page, page) ) {
+        CACHE_DIAGS_INCR(cache, shared_hits);
+        entry = make_entry(cache, node, ra_page, page);
+        set_valid_lines(entry->valid_lines, 0, CACHE_LINES_PER_PAGE);
+        sn = cache->next_request_number;
+        cache->next_request_number++;
+        entry->min_sequence_number = seqn_min(entry->min_sequence_number, sn);
+        ensure_free_page(cache, entry);
+        chpl_memcpy(addr+(requested_start-raddr),
+                    page+(requested_start-ra_page),
+                    requested_size);
+        continue; // Move on to the next page.
+      }
+
+      CACHE_DIAGS_INCR(cache, shared_misses);
+
+      // Otherwise, fetch the whole page so that we can share it.
+      if( chpl_comm_addr_gettable(node, (void*) ra_page, CACHEPAGE_SIZE) ) {
+        ra_line = ra_page;
+        ra_line_end = ra_page + CACHEPAGE_SIZE;
+        share_page = 1;
+        shared_stamp = atomic_fetch_add_uint_least64_t(&shared_clock, 1) + 1;
+      }
+    }
+
     // Now we need to start a get into page.
     // If we don't have entry set, we will also need to plumb
     // it into the tree while we are awaiting our get.
@@ -2496,6 +2801,7 @@ void cache_get(struct rdcache_s* cache,
                     (ra_line_end - ra_line) >> CACHELINE_BITS);
 
     if( ! isprefetch ) {
+      CACHE_DIAGS_INCR(cache, get_misses);
       // This will increment next request number so cache events are recorded.
       sn = cache->next_request_number;
       cache->next_request_number++;
@@ -2510,6 +2816,14 @@ void cache_get(struct rdcache_s* cache,
     // Set the minimum sequence number
     entry->min_sequence_number = seqn_min(entry->min_sequence_number, sn);
 
+    // Keep track of whether pages brought in by readahead get used.
+    if( ! isprefetch ) {
+      if( entry->readahead_unused )
+        note_readahead_outcome(cache, entry, 1);
+    } else if( sequential_readahead_length != 0 ) {
+      entry->readahead_unused = 1;
+    }
+
     // Decide what to store in the readahead trigger for this page
     // if we are currently doing a readahead.
     if( ENABLE_READAHEAD ) {
@@ -2574,7 +2888,8 @@ void cache_get(struct rdcache_s* cache,
       chpl_memcpy(addr+(requested_start-raddr),
                   page+(requested_start-ra_page),
                   requested_size);
-  
+
+      if( share_page ) shared_publish(node, ra_page, page, shared_stamp);
     }
   }
 
@@ -2587,7 +2902,6 @@ void cache_get(struct rdcache_s* cache,
 }
 
 
-#if 0
 static
 void cache_invalidate(struct rdcache_s* cache,
                        c_nodeid_t node, raddr_t raddr, size_t size)
@@ -2601,7 +2915,7 @@ void cache_invalidate(struct rdcache_s* cache,
   raddr_t requested_start, requested_end, requested_size;
 
   DEBUG_PRINT(("shared_invalidate from %i:%p len %i\n",
-               (int) node, raddr, (int) size));
+               (int) node, (void*) raddr, (int) size));
 
   if (chpl_nodeID == node) {
     // Do nothing if we're on the same node.
@@ -2635,7 +2949,96 @@ void cache_invalidate(struct rdcache_s* cache,
     }
   }
 }
-#endif
+
+// Perform a strided GET (is_put == 0) or PUT (is_put != 0) one
+// contiguous chunk at a time. As with chpl_comm_get_strd and
+// chpl_comm_put_strd, addr/dststr describe the destination and
+// raddr/srcstr describe the source; count[0] is in elements and the
+// strides are in elements as well.
+//
+// Chunks small enough to be worth caching are handled by cache_get
+// and cache_put, so they benefit from (and do not disturb) any
+// readahead and write-behind state. Larger chunks only flush and
+// invalidate the pages that they overlap and then bypass the cache.
+static
+void cache_strd_xfer(struct rdcache_s* cache, int is_put,
+                     unsigned char* addr, size_t* dststr,
+                     c_nodeid_t node,
+                     unsigned char* raddr, size_t* srcstr,
+                     size_t* count, int32_t strlevels, size_t elemSize,
+                     cache_seqn_t last_acquire,
+                     int32_t typeIndex, int32_t commID, int ln, int32_t fn)
+{
+  const size_t strlvls = (size_t) strlevels;
+  size_t dst_bytes[strlvls+1];
+  size_t src_bytes[strlvls+1];
+  size_t idx[strlvls+1];
+  size_t chunk_size;
+  size_t dst_off, src_off;
+  size_t i, t;
+  unsigned char* local;
+  raddr_t remote;
+  int use_cache;
+
+  chunk_size = count[0] * elemSize;
+  if( chunk_size == 0 ) return;
+
+  for( i = 0; i < strlvls; i++ ) {
+    if( count[i+1] == 0 ) return;
+    dst_bytes[i] = dststr[i] * elemSize;
+    src_bytes[i] = srcstr[i] * elemSize;
+    idx[i] = 0;
+  }
+
+  dst_off = 0;
+  src_off = 0;
+  while( 1 ) {
+    if( is_put ) {
+      local = raddr + src_off;
+      remote = (raddr_t) (addr + dst_off);
+    } else {
+      local = addr + dst_off;
+      remote = (raddr_t) (raddr + src_off);
+    }
+
+    use_cache = ( (round_down_to_mask(remote+chunk_size-1, CACHEPAGE_MASK) -
+                   round_down_to_mask(remote, CACHEPAGE_MASK)) / CACHEPAGE_SIZE
+                  < MAX_PAGES_PER_STRIDED_CHUNK );
+
+    if( use_cache ) {
+      if( is_put )
+        cache_put(cache, local, node, remote, chunk_size, last_acquire,
+                  commID, ln, fn);
+      else
+        cache_get(cache, local, node, remote, chunk_size, last_acquire,
+                  0, commID, ln, fn);
+    } else {
+      // Write back any overlapping dirty data and drop overlapping
+      // cached lines so that neither an older put completes after this
+      // transfer nor a later get returns stale data.
+      cache_invalidate(cache, node, remote, chunk_size);
+      if( is_put ) {
+        chpl_comm_put(local, node, (void*) remote, chunk_size,
+                      typeIndex, commID, ln, fn);
+        shared_update_floor(cache);
+      } else
+        chpl_comm_get(local, node, (void*) remote, chunk_size,
+                      typeIndex, commID, ln, fn);
+    }
+
+    // Advance to the next chunk, odometer style.
+    for( t = 0; t < strlvls; t++ ) {
+      idx[t]++;
+      dst_off += dst_bytes[t];
+      src_off += src_bytes[t];
+      if( idx[t] < count[t+1] ) break;
+      dst_off -= dst_bytes[t] * count[t+1];
+      src_off -= src_bytes[t] * count[t+1];
+      idx[t] = 0;
+    }
+    if( t == strlvls ) break;
+  }
+}
 
 static
 void cache_clean_dirty(struct rdcache_s* cache)
@@ -2699,11 +3102,100 @@ void destroy_pthread_local_cache(void* arg)
   cache_destroy(s);
 }
 
+// Returns log2(size) if size is a power of 2, or -1 otherwise.
+static
+int cache_size_to_bits(size_t size)
+{
+  int bits = 0;
+  if( size == 0 || (size & (size - 1)) != 0 ) return -1;
+  while( ((size_t) 1 << bits) < size ) bits++;
+  return bits;
+}
+
+// Set the page and line sizes and the readahead window from
+// CHPL_RT_CACHE_* environment variables. This must be done before
+// any cache is created.
+static
+void cache_configure(void)
+{
+  size_t page_size, line_size;
+  int64_t ra_pages;
+  int bits;
+
+  page_size = chpl_env_rt_get_size("CACHE_PAGE_SIZE",
+                                   (size_t) 1 << DEFAULT_CACHEPAGE_BITS);
+  bits = cache_size_to_bits(page_size);
+  if( bits < MIN_CACHEPAGE_BITS || bits > MAX_CACHEPAGE_BITS ||
+      bits % 2 != 0 || page_size > sys_page_size() ) {
+    chpl_warning("CHPL_RT_CACHE_PAGE_SIZE must be one of 64, 256, 1024 or "
+                 "4096 and no larger than the system page size; "
+                 "using the default", 0, 0);
+    bits = DEFAULT_CACHEPAGE_BITS;
+  }
+  cachepage_bits = bits;
+
+  line_size = chpl_env_rt_get_size("CACHE_LINE_SIZE",
+                                   (size_t) 1 << DEFAULT_CACHELINE_BITS);
+  bits = cache_size_to_bits(line_size);
+  if( bits < MIN_CACHELINE_BITS || bits > cachepage_bits ) {
+    chpl_warning("CHPL_RT_CACHE_LINE_SIZE must be a power of 2 between 64 "
+                 "and the cache page size; using the default", 0, 0);
+    bits = DEFAULT_CACHELINE_BITS;
+  }
+  cacheline_bits = bits;
+
+  ra_pages = chpl_env_rt_get_int("CACHE_READAHEAD_PAGES",
+                                 MAX_PAGES_PER_PREFETCH);
+  if( ra_pages < 1 || ra_pages > MAX_ADAPTIVE_READAHEAD_PAGES ) {
+    chpl_warning("CHPL_RT_CACHE_READAHEAD_PAGES is out of range; "
+                 "using the default", 0, 0);
+    ra_pages = MAX_PAGES_PER_PREFETCH;
+  }
+  readahead_pages = (int) ra_pages;
+
+  adaptive_readahead = chpl_env_rt_get_bool("CACHE_ADAPTIVE_READAHEAD",
+                                            false);
+
+  shared_num_pages = (int) chpl_env_rt_get_int("CACHE_SHARED_PAGES", 0);
+  if( shared_num_pages < 0 ) {
+    chpl_warning("CHPL_RT_CACHE_SHARED_PAGES must not be negative; "
+                 "disabling the shared read tier", 0, 0);
+    shared_num_pages = 0;
+  }
+}
+
+// Allocate the per-locale shared read tier, if it is enabled.
+static
+void shared_create(void)
+{
+  unsigned char* data;
+  int i;
+
+  atomic_init_uint_least64_t(&shared_clock, 0);
+
+  if( shared_num_pages == 0 ) return;
+
+  shared_pages = chpl_malloc(sizeof(struct shared_page_s) * shared_num_pages);
+  data = chpl_malloc((size_t) CACHEPAGE_SIZE * shared_num_pages);
+  for( i = 0; i < shared_num_pages; i++ ) {
+    atomic_init_uint_least64_t(&shared_pages[i].version, 0);
+    shared_pages[i].node = -1;
+    shared_pages[i].raddr = 0;
+    shared_pages[i].stamp = 0;
+    shared_pages[i].page = data + (size_t) i * CACHEPAGE_SIZE;
+  }
+}
+
 static
 void chpl_cache_do_init(void)
 {
   static int inited = 0;
   if( ! inited ) {
+
+    cache_configure();
+    shared_create();
+    chpl_thread_mutexInit(&all_caches_lock);
+    memset(&retired_diags, 0, sizeof(retired_diags));
   
     // Quick configuration check...
     assert(OTHER_BITS+TOP_BITS+OTHER_BITS+BOTTOM_BITS+CACHEPAGE_BITS == 64);
@@ -2774,6 +3266,7 @@ void chpl_cache_fence(int acquire, int release, int ln, int32_t fn)
     if( acquire ) {
       task_local->last_acquire = cache->next_request_number;
       cache->next_request_number++;
+      shared_update_floor(cache);
     }
 
     if( release ) {
@@ -2854,46 +3347,47 @@ void chpl_cache_comm_get_strd(void *addr, void *dststr, c_nodeid_t node,
                               int32_t strlevels, size_t elemSize,
                               int32_t typeIndex, int32_t commID,
                               int ln, int32_t fn) {
+  struct rdcache_s* cache = tls_cache_remote_data();
+  chpl_cache_taskPrvData_t* task_local = task_private_cache_data();
   TRACE_PRINT(("%d: in chpl_cache_comm_get_strd\n", chpl_nodeID));
-  // do a full fence - so that:
-  // 1) any pending writes are completed (in case they were to the
-  //    same location handled by the strided get)
-  // 2) the cache does not have older values than what we're getting now
-  // Alternatively, we could invalidate the requested regions.
-  // Alternatively, the strided get could be done through the cache
-  // system. This is just the current (possibly temporary) solution.
-  chpl_cache_fence(1, 1, ln, fn);
-  // do the strided get.
-#ifdef CHPL_TASK_COMM_GET_STRD
-  chpl_task_comm_get_strd(addr, dststr, node, raddr, srcstr, count, strlevels,
-                          elemSize, typeIndex, commID, ln, fn);
-#else
-  chpl_comm_get_strd(addr, dststr, node, raddr, srcstr, count, strlevels,
-                     elemSize, typeIndex, commID, ln, fn);
+
+#ifdef DUMP
+  chpl_cache_print();
 #endif
+
+  // Rather than fencing and bypassing the cache, run each contiguous
+  // chunk through the cache. Pending writes that overlap the requested
+  // regions are completed first by cache_get (or by cache_invalidate
+  // for large chunks), and the data we return is at least as new as
+  // this task's last acquire fence.
+  cache_strd_xfer(cache, 0, (unsigned char*) addr, (size_t*) dststr, node,
+                  (unsigned char*) raddr, (size_t*) srcstr,
+                  (size_t*) count, strlevels, elemSize,
+                  task_local->last_acquire,
+                  typeIndex, commID, ln, fn);
 }
 void chpl_cache_comm_put_strd(void *addr, void *dststr, c_nodeid_t node,
                               void *raddr, void *srcstr, void *count,
                               int32_t strlevels, size_t elemSize,
                               int32_t typeIndex, int32_t commID,
                               int ln, int32_t fn) {
+  struct rdcache_s* cache = tls_cache_remote_data();
+  chpl_cache_taskPrvData_t* task_local = task_private_cache_data();
   TRACE_PRINT(("%d: in chpl_cache_comm_put_strd\n", chpl_nodeID));
-  // do a full fence - so that:
-  // 1) any pending writes are completed (in case they were to the
-  //    same location handled by the strided put and would
-  //    complete in the wrong order)
-  // 2) the cache does not keep older values from before the put.
-  // Alternatively, the strided put could be done through the cache
-  // system. This is just the current (possibly temporary) solution.
-  chpl_cache_fence(1, 1, ln, fn);
-  // do the strided put.
-#ifdef CHPL_TASK_COMM_PUT_STRD
-  chpl_task_comm_put_strd(addr, dststr, node, raddr, srcstr, count, strlevels,
-                          elemSize, typeIndex, commID, ln, fn);
-#else
-  chpl_comm_put_strd(addr, dststr, node, raddr, srcstr, count, strlevels,
-                     elemSize, typeIndex, commID, ln, fn);
+
+#ifdef DUMP
+  chpl_cache_print();
 #endif
+
+  // As with chpl_cache_comm_get_strd, go through the cache one
+  // contiguous chunk at a time. Small chunks become write-behind dirty
+  // data; large ones flush any overlapping dirty data (so that puts
+  // complete in program order) before being put directly.
+  cache_strd_xfer(cache, 1, (unsigned char*) addr, (size_t*) dststr, node,
+                  (unsigned char*) raddr, (size_t*) srcstr,
+                  (size_t*) count, strlevels, elemSize,
+                  task_local->last_acquire,
+                  typeIndex, commID, ln, fn);
 }
 
 // This is for debugging.
@@ -2936,6 +3430,51 @@ void chpl_cache_set_enabled(int enabled)
 }
 */
 
+void chpl_cache_resetDiagnosticsHere(void)
+{
+  struct rdcache_s* cache;
+
+  if( ! chpl_cache_enabled() ) return;
+
+  // Note that the per-pthread counters are updated without
+  // synchronization, so this is only exact when no remote
+  // accesses are in flight on this locale.
+  chpl_thread_mutexLock(&all_caches_lock);
+  memset(&retired_diags, 0, sizeof(retired_diags));
+  for( cache = all_caches_head; cache; cache = cache->next_cache )
+    memset(&cache->diags, 0, sizeof(cache->diags));
+  chpl_thread_mutexUnlock(&all_caches_lock);
+}
+
+void chpl_cache_getDiagnosticsHere(chpl_cacheDiagnostics *cd)
+{
+  struct rdcache_s* cache;
+
+  memset(cd, 0, sizeof(*cd));
+
+  if( ! chpl_cache_enabled() ) return;
+
+  chpl_thread_mutexLock(&all_caches_lock);
+  *cd = retired_diags;
+  for( cache = all_caches_head; cache; cache = cache->next_cache ) {
+#define _CACHE_DIAGS_SUM(cdv) cd->cdv += cache->diags.cdv;
+    CHPL_CACHE_DIAGS_VARS_ALL(_CACHE_DIAGS_SUM)
+#undef _CACHE_DIAGS_SUM
+  }
+  chpl_thread_mutexUnlock(&all_caches_lock);
+}
+
+#else
+// ifdef HAS_CHPL_CACHE_FNS
+
+// Without a remote data cache, there is nothing to count.
+void chpl_cache_resetDiagnosticsHere(void) { }
+
+void chpl_cache_getDiagnosticsHere(chpl_cacheDiagnostics *cd)
+{
+  memset(cd, 0, sizeof(*cd));
+}
+
 #endif
 // end ifdef HAS_CHPL_CACHE_FNS
 
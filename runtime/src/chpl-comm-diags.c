@@ -26,12 +26,58 @@
 
 #include "chpl-comm.h"
 #include "chpl-comm-diags.h"
+#include "chpl-mem-sys.h"
+#include "error.h"
 
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 
 
+chpl_comm_diags_dest_t* chpl_comm_diags_dests = NULL;
+
+int chpl_comm_diags_latency = 0;
+atomic_uint_least64_t
+       chpl_comm_diags_latency_hist[chpl_comm_diags_latency_num_classes]
+                                   [CHPL_COMM_DIAGS_LATENCY_BUCKETS];
+
+
+void chpl_comm_diags_init_detail(void) {
+  int i, j;
+
+  if (chpl_comm_diags_dests == NULL) {
+    chpl_comm_diags_dests = sys_calloc(chpl_numNodes,
+                                       sizeof(chpl_comm_diags_dests[0]));
+    if (chpl_comm_diags_dests == NULL)
+      chpl_internal_error("cannot allocate comm diagnostics matrix row");
+  }
+  for (i = 0; i < chpl_numNodes; i++) {
+    atomic_init_uint_least64_t(&chpl_comm_diags_dests[i].ops, 0);
+    atomic_init_uint_least64_t(&chpl_comm_diags_dests[i].bytes, 0);
+  }
+
+  for (i = 0; i < chpl_comm_diags_latency_num_classes; i++)
+    for (j = 0; j < CHPL_COMM_DIAGS_LATENCY_BUCKETS; j++)
+      atomic_init_uint_least64_t(&chpl_comm_diags_latency_hist[i][j], 0);
+}
+
+
+void chpl_comm_diags_reset_detail(void) {
+  int i, j;
+
+  if (chpl_comm_diags_dests != NULL) {
+    for (i = 0; i < chpl_numNodes; i++) {
+      atomic_store_uint_least64_t(&chpl_comm_diags_dests[i].ops, 0);
+      atomic_store_uint_least64_t(&chpl_comm_diags_dests[i].bytes, 0);
+    }
+  }
+
+  for (i = 0; i < chpl_comm_diags_latency_num_classes; i++)
+    for (j = 0; j < CHPL_COMM_DIAGS_LATENCY_BUCKETS; j++)
+      atomic_store_uint_least64_t(&chpl_comm_diags_latency_hist[i][j], 0);
+}
+
+
 void chpl_startVerboseComm() {
   chpl_verbose_comm = 1;
   chpl_comm_diags_disable();
@@ -96,3 +142,43 @@ void chpl_resetCommDiagnosticsHere() {
 void chpl_getCommDiagnosticsHere(chpl_commDiagnostics *cd) {
   chpl_comm_diags_copy(cd);
 }
+
+
+void chpl_getCommDetailDiagnosticsHere(chpl_commDetailDiagnostics *cd) {
+  chpl_comm_diags_copy_detail(cd);
+}
+
+
+void chpl_getCommMatrixRowHere(uint64_t* ops, uint64_t* bytes) {
+  int i;
+
+  for (i = 0; i < chpl_numNodes; i++) {
+    if (chpl_comm_diags_dests == NULL) {
+      ops[i] = 0;
+      bytes[i] = 0;
+    } else {
+      ops[i] = atomic_load_uint_least64_t(&chpl_comm_diags_dests[i].ops);
+      bytes[i] = atomic_load_uint_least64_t(&chpl_comm_diags_dests[i].bytes);
+    }
+  }
+}
+
+
+void chpl_startCommLatencyHistogramsHere() {
+  chpl_comm_diags_latency = 1;
+}
+
+
+void chpl_stopCommLatencyHistogramsHere() {
+  chpl_comm_diags_latency = 0;
+}
+
+
+void chpl_getCommLatencyHistogramHere(int32_t latencyClass,
+                                      uint64_t* buckets) {
+  int i;
+
+  for (i = 0; i < CHPL_COMM_DIAGS_LATENCY_BUCKETS; i++)
+    buckets[i] =
+      atomic_load_uint_least64_t(&chpl_comm_diags_latency_hist[latencyClass][i]);
+}
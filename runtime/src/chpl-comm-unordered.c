@@ -0,0 +1,488 @@
+/*
+ * Copyright 2004-2019 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//
+// Common aggregation of unordered GETs and atomics.  See
+// chpl-comm-unordered.h for the interface.
+//
+
+#include <assert.h>
+#include <errno.h>
+#include <pthread.h>
+#include <string.h>
+
+#include "chplrt.h"
+#include "chpl-atomics.h"
+#include "chpl-comm.h"
+#include "chpl-comm-diags.h"
+#include "chpl-comm-unordered.h"
+#include "chpl-mem.h"
+#include "chpl-mem-desc.h"
+#include "chpl-tasks.h"
+#include "chpl-thread-local-storage.h"
+#include "error.h"
+
+//
+// The buffered operations for one target node.  The GET destinations
+// stay here; only the operations themselves are shipped.
+//
+typedef struct {
+  int numOps;
+  int numGets;
+  chpl_comm_unordered_op_t* ops;
+  void** getAddrs;
+  uint8_t* getSizes;
+  uint64_t* results;
+} unordered_buff_t;
+
+//
+// Per-thread buffers.  Only the owning thread adds operations, but any
+// thread may flush them (for a global fence), so the buffer table is
+// protected by a spinlock.  A full buffer is detached from the table
+// under the lock and shipped without it, so that a task which yields
+// while waiting for the target cannot block others on this thread.
+//
+typedef struct unordered_thread_info_t {
+  atomic_bool lock;
+  unordered_buff_t** buffs;     // [chpl_numNodes], created on demand
+  unordered_buff_t* spare;      // a shipped buffer, kept for reuse
+  c_nodeid_t* dirty;            // nodes that may have buffered ops
+  uint8_t* isDirty;             // [chpl_numNodes], node is in 'dirty'
+  int numDirty;
+  atomic_int_least32_t inFlight; // buffers detached but not yet done
+  struct unordered_thread_info_t* next;
+} unordered_thread_info_t;
+
+static chpl_comm_unordered_send_fn_t send_fn = NULL;
+static int max_ops;
+
+static unordered_thread_info_t* thread_info_list = NULL;
+static pthread_rwlock_t thread_info_list_lock;
+
+CHPL_TLS_DECL(unordered_thread_info_t*, thread_info);
+static pthread_key_t thread_info_key;  // only for its destructor
+
+
+static inline
+void info_lock(unordered_thread_info_t* info) {
+  while (atomic_exchange_explicit_bool(&info->lock, true,
+                                       memory_order_acquire)) {
+    chpl_task_yield();
+  }
+}
+
+static inline
+void info_unlock(unordered_thread_info_t* info) {
+  atomic_store_explicit_bool(&info->lock, false, memory_order_release);
+}
+
+static inline
+void list_reader_lock(void) {
+  while (pthread_rwlock_tryrdlock(&thread_info_list_lock) == EBUSY) {
+    chpl_task_yield();
+  }
+}
+
+static inline
+void list_writer_lock(void) {
+  while (pthread_rwlock_trywrlock(&thread_info_list_lock) == EBUSY) {
+    chpl_task_yield();
+  }
+}
+
+static inline
+void list_unlock(void) {
+  pthread_rwlock_unlock(&thread_info_list_lock);
+}
+
+
+static
+unordered_buff_t* buff_create(void) {
+  unordered_buff_t* b;
+  b = chpl_mem_alloc(sizeof(*b), CHPL_RT_MD_COMM_XMIT_RCV_BUF, 0, 0);
+  b->numOps = 0;
+  b->numGets = 0;
+  b->ops = chpl_mem_allocMany(max_ops, sizeof(b->ops[0]),
+                              CHPL_RT_MD_COMM_XMIT_RCV_BUF, 0, 0);
+  b->getAddrs = chpl_mem_allocMany(max_ops, sizeof(b->getAddrs[0]),
+                                   CHPL_RT_MD_COMM_XMIT_RCV_BUF, 0, 0);
+  b->getSizes = chpl_mem_allocMany(max_ops, sizeof(b->getSizes[0]),
+                                   CHPL_RT_MD_COMM_XMIT_RCV_BUF, 0, 0);
+  b->results = chpl_mem_allocMany(max_ops, sizeof(b->results[0]),
+                                  CHPL_RT_MD_COMM_XMIT_RCV_BUF, 0, 0);
+  return b;
+}
+
+static
+void buff_destroy(unordered_buff_t* b) {
+  chpl_mem_free(b->ops, 0, 0);
+  chpl_mem_free(b->getAddrs, 0, 0);
+  chpl_mem_free(b->getSizes, 0, 0);
+  chpl_mem_free(b->results, 0, 0);
+  chpl_mem_free(b, 0, 0);
+}
+
+
+//
+// Ship a detached buffer, scatter its GET results and give it back to
+// the thread for reuse.
+//
+static
+void buff_ship(unordered_thread_info_t* info, c_nodeid_t node,
+               unordered_buff_t* b) {
+  (*send_fn)(node, b->ops, b->numOps, b->results, b->numGets);
+
+  for (int i = 0; i < b->numGets; i++) {
+    memcpy(b->getAddrs[i], &b->results[i], b->getSizes[i]);
+  }
+  b->numOps = 0;
+  b->numGets = 0;
+
+  info_lock(info);
+  if (info->spare == NULL) {
+    info->spare = b;
+    b = NULL;
+  }
+  info_unlock(info);
+  if (b != NULL) {
+    buff_destroy(b);
+  }
+
+  (void) atomic_fetch_add_int_least32_t(&info->inFlight, -1);
+}
+
+//
+// Detach the buffer for 'node' from the table.  Call with the lock held.
+//
+static inline
+unordered_buff_t* buff_detach(unordered_thread_info_t* info,
+                              c_nodeid_t node) {
+  unordered_buff_t* b = info->buffs[node];
+  info->buffs[node] = info->spare;
+  info->spare = NULL;
+  (void) atomic_fetch_add_int_least32_t(&info->inFlight, 1);
+  return b;
+}
+
+
+static
+void thread_info_flush(unordered_thread_info_t* info) {
+  while (true) {
+    c_nodeid_t node = 0;
+    unordered_buff_t* b = NULL;
+
+    info_lock(info);
+    while (info->numDirty > 0 && b == NULL) {
+      node = info->dirty[--info->numDirty];
+      info->isDirty[node] = 0;
+      if (info->buffs[node] != NULL && info->buffs[node]->numOps > 0) {
+        b = buff_detach(info, node);
+      }
+    }
+    info_unlock(info);
+
+    if (b == NULL) {
+      break;
+    }
+    buff_ship(info, node, b);
+  }
+
+  //
+  // Buffers someone else detached before we got here were filled
+  // before the fence too, so wait for them as well.
+  //
+  while (atomic_load_int_least32_t(&info->inFlight) > 0) {
+    chpl_task_yield();
+    chpl_comm_make_progress();
+  }
+}
+
+static
+void thread_info_destroy(void* p) {
+  unordered_thread_info_t* info = (unordered_thread_info_t*) p;
+
+  list_writer_lock();
+  if (thread_info_list == info) {
+    thread_info_list = info->next;
+  } else {
+    for (unordered_thread_info_t* i = thread_info_list;
+         i != NULL;
+         i = i->next) {
+      if (i->next == info) {
+        i->next = info->next;
+        break;
+      }
+    }
+  }
+  list_unlock();
+
+  thread_info_flush(info);
+
+  for (c_nodeid_t node = 0; node < chpl_numNodes; node++) {
+    if (info->buffs[node] != NULL) {
+      buff_destroy(info->buffs[node]);
+    }
+  }
+  if (info->spare != NULL) {
+    buff_destroy(info->spare);
+  }
+  chpl_mem_free(info->buffs, 0, 0);
+  chpl_mem_free(info->dirty, 0, 0);
+  chpl_mem_free(info->isDirty, 0, 0);
+  atomic_destroy_bool(&info->lock);
+  atomic_destroy_int_least32_t(&info->inFlight);
+  chpl_mem_free(info, 0, 0);
+}
+
+static
+unordered_thread_info_t* thread_info_get(void) {
+  unordered_thread_info_t* info = CHPL_TLS_GET(thread_info);
+  if (info == NULL) {
+    info = chpl_mem_alloc(sizeof(*info), CHPL_RT_MD_COMM_PER_LOC_INFO, 0, 0);
+    atomic_init_bool(&info->lock, false);
+    info->buffs = chpl_mem_calloc(chpl_numNodes, sizeof(info->buffs[0]),
+                                  CHPL_RT_MD_COMM_PER_LOC_INFO, 0, 0);
+    info->spare = NULL;
+    info->dirty = chpl_mem_allocMany(chpl_numNodes, sizeof(info->dirty[0]),
+                                     CHPL_RT_MD_COMM_PER_LOC_INFO, 0, 0);
+    info->isDirty = chpl_mem_calloc(chpl_numNodes, sizeof(info->isDirty[0]),
+                                    CHPL_RT_MD_COMM_PER_LOC_INFO, 0, 0);
+    info->numDirty = 0;
+    atomic_init_int_least32_t(&info->inFlight, 0);
+
+    list_writer_lock();
+    info->next = thread_info_list;
+    thread_info_list = info;
+    list_unlock();
+
+    CHPL_TLS_SET(thread_info, info);
+    pthread_setspecific(thread_info_key, info);
+  }
+  return info;
+}
+
+
+void chpl_comm_unordered_init(chpl_comm_unordered_send_fn_t sendFn,
+                              int maxOps) {
+  send_fn = sendFn;
+  max_ops = (maxOps < CHPL_COMM_UNORDERED_MAX_OPS)
+            ? maxOps : CHPL_COMM_UNORDERED_MAX_OPS;
+  if (max_ops < 1) {
+    chpl_internal_error("unordered operation buffers cannot hold anything");
+  }
+
+  pthread_rwlock_init(&thread_info_list_lock, NULL);
+  CHPL_TLS_INIT(thread_info);
+  pthread_key_create(&thread_info_key, thread_info_destroy);
+}
+
+
+//
+// Add an operation to the buffer for 'node', shipping the buffer if
+// that fills it.  'getAddr' is the local destination of a GET.
+//
+static inline
+void buff_add(c_nodeid_t node, const chpl_comm_unordered_op_t* op,
+              void* getAddr) {
+  unordered_thread_info_t* info = thread_info_get();
+  unordered_buff_t* full = NULL;
+
+  info_lock(info);
+
+  unordered_buff_t* b = info->buffs[node];
+  if (b == NULL) {
+    b = info->buffs[node] = buff_create();
+  }
+  if (!info->isDirty[node]) {
+    info->isDirty[node] = 1;
+    info->dirty[info->numDirty++] = node;
+  }
+
+  b->ops[b->numOps++] = *op;
+  if (getAddr != NULL) {
+    b->getAddrs[b->numGets] = getAddr;
+    b->getSizes[b->numGets] = op->size;
+    b->numGets++;
+  }
+
+  if (b->numOps == max_ops) {
+    //
+    // The node stays in the dirty list; flushing skips empty buffers.
+    //
+    full = buff_detach(info, node);
+  }
+
+  info_unlock(info);
+
+  if (full != NULL) {
+    buff_ship(info, node, full);
+  }
+}
+
+
+void chpl_comm_unordered_get(void* addr, c_nodeid_t node, void* raddr,
+                             size_t size) {
+  assert(size <= CHPL_COMM_UNORDERED_MAX_GET_SIZE);
+
+  chpl_comm_unordered_op_t op = { .obj = raddr,
+                                  .operand = 0,
+                                  .op = chpl_comm_unordered_op_get,
+                                  .type = 0,
+                                  .size = (uint8_t) size };
+  buff_add(node, &op, addr);
+}
+
+
+static inline
+size_t type_size(chpl_comm_unordered_type_t type) {
+  switch (type) {
+  case chpl_comm_unordered_type_int32:
+  case chpl_comm_unordered_type_uint32:
+  case chpl_comm_unordered_type_real32:
+    return 4;
+  default:
+    return 8;
+  }
+}
+
+void chpl_comm_unordered_amo(c_nodeid_t node, void* object,
+                             chpl_comm_unordered_opKind_t op,
+                             chpl_comm_unordered_type_t type,
+                             const void* operand) {
+  chpl_comm_unordered_op_t o = { .obj = object,
+                                 .operand = 0,
+                                 .op = op,
+                                 .type = type,
+                                 .size = 0 };
+  memcpy(&o.operand, operand, type_size(type));
+  if (node == chpl_nodeID) {
+    (void) chpl_comm_unordered_apply(&o, 1, NULL);
+  } else {
+    chpl_comm_diags_incr_amo(node, type_size(type));
+    buff_add(node, &o, NULL);
+  }
+}
+
+
+void chpl_comm_unordered_flush(void) {
+  list_reader_lock();
+  for (unordered_thread_info_t* info = thread_info_list;
+       info != NULL;
+       info = info->next) {
+    thread_info_flush(info);
+  }
+  list_unlock();
+}
+
+void chpl_comm_unordered_task_flush(void) {
+  if (send_fn == NULL) {
+    return;
+  }
+
+  if (chpl_task_canMigrateThreads()) {
+    chpl_comm_unordered_flush();
+  } else {
+    //
+    // Only this thread adds to its buffers, so if it sees no dirty
+    // ones there is nothing of ours to flush.
+    //
+    unordered_thread_info_t* info = CHPL_TLS_GET(thread_info);
+    if (info != NULL &&
+        (info->numDirty > 0
+         || atomic_load_int_least32_t(&info->inFlight) > 0)) {
+      thread_info_flush(info);
+    }
+  }
+}
+
+
+#define APPLY_INT_AMO(o, T)                                             \
+  do {                                                                  \
+    T v;                                                                \
+    atomic_ ## T* obj = (atomic_ ## T*) (o)->obj;                       \
+    memcpy(&v, &(o)->operand, sizeof(v));                               \
+    switch ((o)->op) {                                                  \
+    case chpl_comm_unordered_op_add:                                    \
+      (void) atomic_fetch_add_ ## T(obj, v); break;                     \
+    case chpl_comm_unordered_op_sub:                                    \
+      (void) atomic_fetch_sub_ ## T(obj, v); break;                     \
+    case chpl_comm_unordered_op_and:                                    \
+      (void) atomic_fetch_and_ ## T(obj, v); break;                     \
+    case chpl_comm_unordered_op_or:                                     \
+      (void) atomic_fetch_or_ ## T(obj, v); break;                      \
+    case chpl_comm_unordered_op_xor:                                    \
+      (void) atomic_fetch_xor_ ## T(obj, v); break;                     \
+    default:                                                            \
+      chpl_internal_error("unexpected unordered atomic op");            \
+    }                                                                   \
+  } while (0)
+
+#define APPLY_REAL_AMO(o, T)                                            \
+  do {                                                                  \
+    T v;                                                                \
+    atomic_ ## T* obj = (atomic_ ## T*) (o)->obj;                       \
+    memcpy(&v, &(o)->operand, sizeof(v));                               \
+    switch ((o)->op) {                                                  \
+    case chpl_comm_unordered_op_add:                                    \
+      (void) atomic_fetch_add_ ## T(obj, v); break;                     \
+    case chpl_comm_unordered_op_sub:                                    \
+      (void) atomic_fetch_sub_ ## T(obj, v); break;                     \
+    default:                                                            \
+      chpl_internal_error("unexpected unordered atomic op");            \
+    }                                                                   \
+  } while (0)
+
+int chpl_comm_unordered_apply(const chpl_comm_unordered_op_t* ops,
+                              int numOps, uint64_t* results) {
+  int numGets = 0;
+
+  for (int i = 0; i < numOps; i++) {
+    const chpl_comm_unordered_op_t* o = &ops[i];
+
+    if (o->op == chpl_comm_unordered_op_get) {
+      results[numGets] = 0;
+      memcpy(&results[numGets], o->obj, o->size);
+      numGets++;
+      continue;
+    }
+
+    switch ((chpl_comm_unordered_type_t) o->type) {
+    case chpl_comm_unordered_type_int32:
+      APPLY_INT_AMO(o, int_least32_t);
+      break;
+    case chpl_comm_unordered_type_int64:
+      APPLY_INT_AMO(o, int_least64_t);
+      break;
+    case chpl_comm_unordered_type_uint32:
+      APPLY_INT_AMO(o, uint_least32_t);
+      break;
+    case chpl_comm_unordered_type_uint64:
+      APPLY_INT_AMO(o, uint_least64_t);
+      break;
+    case chpl_comm_unordered_type_real32:
+      APPLY_REAL_AMO(o, _real32);
+      break;
+    case chpl_comm_unordered_type_real64:
+      APPLY_REAL_AMO(o, _real64);
+      break;
+    }
+  }
+
+  return numGets;
+}
@@ -19,74 +19,145 @@
 
 #include "chplrt.h"
 #include "chpl-privatization.h"
+#include "chpl-atomics.h"
 #include "chpl-mem.h"
 #include "chpl-tasks.h"
+#include "error.h"
 
-static int64_t chpl_capPrivateObjects = 0;
+// Only held to allocate chunks, which happens once per
+// CHPL_PRIVATIZATION_CHUNK_SIZE pids.
 static chpl_sync_aux_t privatizationSync;
 
-chpl_privateObject_t* chpl_privateObjects = NULL;
+chpl_privateObject_t* chpl_privateObjects[CHPL_PRIVATIZATION_MAX_CHUNKS];
+
+// Number of entries in chpl_privateObjects that might be non-NULL.
+static atomic_int_least64_t numChunks;
+
+// pid allocation, only used on locale 0. Released pids are kept on a
+// lock-free stack threaded through freeNext (which is chunked the same
+// way as chpl_privateObjects). The stack head packs a tag that changes
+// on every update into the high 32 bits, to avoid ABA problems, and
+// pid+1 into the low 32 bits, with 0 meaning the stack is empty.
+static atomic_int_least64_t nextFreshPid;
+static atomic_uint_least64_t freeHead;
+static atomic_uint_least32_t* freeNext[CHPL_PRIVATIZATION_MAX_CHUNKS];
 
 void chpl_privatization_init(void) {
-    chpl_sync_initAux(&privatizationSync);
+  chpl_sync_initAux(&privatizationSync);
+  atomic_init_int_least64_t(&numChunks, 0);
+  atomic_init_int_least64_t(&nextFreshPid, 0);
+  atomic_init_uint_least64_t(&freeHead, 0);
 }
 
-static inline int64_t max(int64_t a, int64_t b) {
-  return a > b ? a : b;
+static inline int64_t chunkFor(int64_t pid) {
+  int64_t chunk = pid >> CHPL_PRIVATIZATION_CHUNK_BITS;
+  if (pid < 0 || chunk >= CHPL_PRIVATIZATION_MAX_CHUNKS)
+    chpl_internal_error("too many privatized objects");
+  return chunk;
+}
+
+static void allocChunk(int64_t chunk) {
+  chpl_sync_lock(&privatizationSync);
+  if (chpl_privateObjects[chunk] == NULL) {
+    chpl_privateObject_t* tmp;
+    tmp = chpl_mem_allocManyZero(CHPL_PRIVATIZATION_CHUNK_SIZE,
+                                 sizeof(chpl_privateObject_t),
+                                 CHPL_RT_MD_COMM_PRV_OBJ_ARRAY, 0, 0);
+    // Make sure the zeroed chunk is visible before the pointer to it.
+    chpl_atomic_thread_fence(memory_order_release);
+    chpl_privateObjects[chunk] = tmp;
+    if (atomic_load_int_least64_t(&numChunks) <= chunk)
+      atomic_store_int_least64_t(&numChunks, chunk + 1);
+  }
+  chpl_sync_unlock(&privatizationSync);
 }
 
 // Note that this function can be called in parallel and more notably it can be
 // called with non-monotonic pid's. e.g. this may be called with pid 27, and
-// then pid 2, so it has to ensure that the privatized array has at least pid+1
-// elements. Be __very__ careful if you have to update it.
+// then pid 2. Each chunk is allocated once, under the lock, and is never
+// moved, so readers don't need to synchronize with this.
 void chpl_newPrivatizedClass(void* v, int64_t pid) {
-  chpl_sync_lock(&privatizationSync);
+  int64_t chunk = chunkFor(pid);
 
-  // initialize array to a default size
-  if (chpl_privateObjects == NULL) {
-    chpl_capPrivateObjects = 2*max(pid, 4);
-    chpl_privateObjects =
-        chpl_mem_allocManyZero(chpl_capPrivateObjects,
-                               sizeof(chpl_privateObject_t),
-                               CHPL_RT_MD_COMM_PRV_OBJ_ARRAY, 0, 0);
-  } else {
-    // if we're out of space, double (or more) the array size
-    if (pid >= chpl_capPrivateObjects) {
-      chpl_privateObject_t* tmp;
-      int64_t oldCap;
-
-      oldCap = chpl_capPrivateObjects;
-      chpl_capPrivateObjects = 2*max(pid, oldCap);
-
-      tmp = chpl_mem_allocManyZero(chpl_capPrivateObjects,
-                                   sizeof(chpl_privateObject_t),
-                                   CHPL_RT_MD_COMM_PRV_OBJ_ARRAY, 0, 0);
-      chpl_memcpy((void*)tmp, (void*)chpl_privateObjects,
-                  (oldCap)*sizeof(chpl_privateObject_t));
-      chpl_privateObjects = tmp;
-      // purposely leak old copies of chpl_privateObject to avoid the need to
-      // lock chpl_getPrivatizedClass; TODO: fix with lock free data structure
-    }
-  }
-  chpl_privateObjects[pid].obj = v;
+  if (chpl_privateObjects[chunk] == NULL)
+    allocChunk(chunk);
 
-  chpl_sync_unlock(&privatizationSync);
+  chpl_privateObjects[chunk][pid & (CHPL_PRIVATIZATION_CHUNK_SIZE - 1)].obj = v;
 }
 
 void chpl_clearPrivatizedClass(int64_t i) {
-  chpl_sync_lock(&privatizationSync);
-  chpl_privateObjects[i].obj = NULL;
-  chpl_sync_unlock(&privatizationSync);
+  chpl_privateObjects[chunkFor(i)]
+                     [i & (CHPL_PRIVATIZATION_CHUNK_SIZE - 1)].obj = NULL;
 }
 
 // Used to check for leaks of privatized classes
 int64_t chpl_numPrivatizedClasses(void) {
   int64_t ret = 0;
-  chpl_sync_lock(&privatizationSync);
-  for (int64_t i = 0; i < chpl_capPrivateObjects; i++) {
-    if (chpl_privateObjects[i].obj)
-      ret++;
+  int64_t n = atomic_load_int_least64_t(&numChunks);
+  for (int64_t c = 0; c < n; c++) {
+    chpl_privateObject_t* chunk = chpl_privateObjects[c];
+    if (chunk == NULL)
+      continue;
+    for (int64_t i = 0; i < CHPL_PRIVATIZATION_CHUNK_SIZE; i++) {
+      if (chunk[i].obj)
+        ret++;
+    }
   }
-  chpl_sync_unlock(&privatizationSync);
   return ret;
 }
+
+static atomic_uint_least32_t* freeNextFor(int64_t pid) {
+  int64_t chunk = chunkFor(pid);
+
+  if (freeNext[chunk] == NULL) {
+    chpl_sync_lock(&privatizationSync);
+    if (freeNext[chunk] == NULL) {
+      atomic_uint_least32_t* tmp;
+      tmp = chpl_mem_allocMany(CHPL_PRIVATIZATION_CHUNK_SIZE,
+                               sizeof(atomic_uint_least32_t),
+                               CHPL_RT_MD_COMM_PRV_OBJ_ARRAY, 0, 0);
+      for (int i = 0; i < CHPL_PRIVATIZATION_CHUNK_SIZE; i++)
+        atomic_init_uint_least32_t(&tmp[i], 0);
+      chpl_atomic_thread_fence(memory_order_release);
+      freeNext[chunk] = tmp;
+    }
+    chpl_sync_unlock(&privatizationSync);
+  }
+
+  return &freeNext[chunk][pid & (CHPL_PRIVATIZATION_CHUNK_SIZE - 1)];
+}
+
+int64_t chpl_privatization_allocPid(void) {
+  uint_least64_t head = atomic_load_uint_least64_t(&freeHead);
+
+  while ((uint32_t) head != 0) {
+    int64_t pid = (int64_t) (uint32_t) head - 1;
+    uint_least64_t next =
+      atomic_load_uint_least32_t(freeNextFor(pid));
+    uint_least64_t newHead = ((head >> 32) + 1) << 32 | next;
+
+    if (atomic_compare_exchange_strong_uint_least64_t(&freeHead,
+                                                      head, newHead))
+      return pid;
+
+    head = atomic_load_uint_least64_t(&freeHead);
+  }
+
+  return atomic_fetch_add_int_least64_t(&nextFreshPid, 1);
+}
+
+void chpl_privatization_releasePid(int64_t pid) {
+  atomic_uint_least32_t* next = freeNextFor(pid);
+  uint_least64_t head = atomic_load_uint_least64_t(&freeHead);
+
+  while (1) {
+    uint_least64_t newHead = ((head >> 32) + 1) << 32 | (uint64_t) (pid + 1);
+
+    atomic_store_uint_least32_t(next, (uint32_t) head);
+    if (atomic_compare_exchange_strong_uint_least64_t(&freeHead,
+                                                      head, newHead))
+      return;
+
+    head = atomic_load_uint_least64_t(&freeHead);
+  }
+}
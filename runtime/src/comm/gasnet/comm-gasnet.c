@@ -25,6 +25,7 @@
 #include "gasnet_tools.h"
 #include "chpl-comm.h"
 #include "chpl-comm-diags.h"
+#include "chpl-comm-unordered.h"
 #include "chpl-comm-callbacks.h"
 #include "chpl-comm-callbacks-internal.h"
 #include "chpl-mem.h"
@@ -250,7 +251,9 @@ typedef enum {
   SHUTDOWN,             // tell nodes to get ready for shutdown
   BCAST_SEGINFO,        // broadcast for segment info table
   DO_REPLY_PUT,         // do a PUT here from another locale
-  DO_COPY_PAYLOAD       // copy AM payload to another address
+  DO_COPY_PAYLOAD,      // copy AM payload to another address
+  UNORDERED_OPS,        // apply a batch of unordered GETs and atomics
+  UNORDERED_REPLY       // return the GET results of such a batch
 } AM_handler_function_idx_t;
 
 static void AM_fork_fast(gasnet_token_t token, void* buf, size_t nbytes) {
@@ -586,6 +589,41 @@ void AM_copy_payload(gasnet_token_t token, void* buf, size_t nbytes,
   GASNET_Safe(gasnet_AMReplyShort2(token, SIGNAL, ack0, ack1));
 }
 
+// Apply the batch of unordered operations in the payload, and send
+// back any GET results.  The reply fits because the initiator limits
+// the batch size to what a medium reply can carry (see
+// chpl_comm_init()).
+static
+void AM_unordered_ops(gasnet_token_t token, void* buf, size_t nbytes,
+                      gasnet_handlerarg_t ack0, gasnet_handlerarg_t ack1,
+                      gasnet_handlerarg_t res0, gasnet_handlerarg_t res1)
+{
+  uint64_t results[CHPL_COMM_UNORDERED_MAX_OPS];
+  int numOps = nbytes / sizeof(chpl_comm_unordered_op_t);
+  int numGets;
+
+  numGets = chpl_comm_unordered_apply((chpl_comm_unordered_op_t*) buf,
+                                      numOps, results);
+  if (numGets == 0) {
+    GASNET_Safe(gasnet_AMReplyShort2(token, SIGNAL, ack0, ack1));
+  } else {
+    GASNET_Safe(gasnet_AMReplyMedium4(token, UNORDERED_REPLY,
+                                      results, numGets * sizeof(results[0]),
+                                      ack0, ack1, res0, res1));
+  }
+}
+
+// Copy the GET results of an unordered batch to the initiator's
+// result buffer, and signal it.
+static
+void AM_unordered_reply(gasnet_token_t token, void* buf, size_t nbytes,
+                        gasnet_handlerarg_t ack0, gasnet_handlerarg_t ack1,
+                        gasnet_handlerarg_t res0, gasnet_handlerarg_t res1)
+{
+  memcpy(get_ptr_from_args(res0, res1), buf, nbytes);
+  AM_signal(token, ack0, ack1);
+}
+
 static gasnet_handlerentry_t ftable[] = {
   {FORK,          AM_fork},
   {FORK_SMALL,    AM_fork_small},
@@ -604,7 +642,9 @@ static gasnet_handlerentry_t ftable[] = {
   {SHUTDOWN,      AM_shutdown},
   {BCAST_SEGINFO, AM_bcast_seginfo},
   {DO_REPLY_PUT,  AM_reply_put},
-  {DO_COPY_PAYLOAD, AM_copy_payload}
+  {DO_COPY_PAYLOAD, AM_copy_payload},
+  {UNORDERED_OPS, AM_unordered_ops},
+  {UNORDERED_REPLY, AM_unordered_reply}
 };
 
 //
@@ -639,7 +679,7 @@ chpl_comm_nb_handle_t chpl_comm_put_nb(void *addr, c_nodeid_t node, void* raddr,
 
   ret = gasnet_put_nb_bulk(node, raddr, addr, size);
 
-  chpl_comm_diags_incr(put_nb);
+  chpl_comm_diags_incr_xfer(put_nb, put_bytes, node, size);
 
   return (chpl_comm_nb_handle_t) ret;
 }
@@ -673,7 +713,7 @@ chpl_comm_nb_handle_t chpl_comm_get_nb(void* addr, c_nodeid_t node, void* raddr,
 
   ret = gasnet_get_nb_bulk(addr, node, raddr, size);
 
-  chpl_comm_diags_incr(get_nb);
+  chpl_comm_diags_incr_xfer(get_nb, get_bytes, node, size);
 
   return (chpl_comm_nb_handle_t) ret;
 }
@@ -794,6 +834,23 @@ static void set_num_comm_domains() {
 #endif
 }
 
+//
+// Ship a batch of unordered operations to the node that owns them and
+// wait for it to apply them.  (See chpl-comm-unordered.h.)
+//
+static
+void unordered_send(c_nodeid_t node, chpl_comm_unordered_op_t* ops,
+                    int numOps, uint64_t* results, int numGets) {
+  done_t done;
+
+  init_done_obj(&done, 1);
+  GASNET_Safe(gasnet_AMRequestMedium4(node, UNORDERED_OPS,
+                                      ops, numOps * sizeof(ops[0]),
+                                      Arg0(&done), Arg1(&done),
+                                      Arg0(results), Arg1(results)));
+  wait_done_obj(&done);
+}
+
 void chpl_comm_init(int *argc_p, char ***argv_p) {
 //  int status; // Some compilers complain about unused variable 'status'.
 
@@ -808,6 +865,9 @@ void chpl_comm_init(int *argc_p, char ***argv_p) {
                             sizeof(ftable)/sizeof(gasnet_handlerentry_t),
                             gasnet_getMaxLocalSegmentSize(),
                             0));
+  chpl_comm_unordered_init(unordered_send,
+                           gasnet_AMMaxMedium()
+                           / sizeof(chpl_comm_unordered_op_t));
   // TODO (EJR: 03/03/16): we currently "leak" seginfo_table. We should
   // probably free it on exit (but only for "clean" exits.)
   seginfo_table = (gasnet_seginfo_t*)sys_malloc(chpl_numNodes*sizeof(gasnet_seginfo_t));
@@ -1129,7 +1189,8 @@ void  chpl_comm_put(void* addr, c_nodeid_t node, void* raddr,
     }
 
     chpl_comm_diags_verbose_rdma("put", node, size, ln, fn);
-    chpl_comm_diags_incr(put);
+    chpl_comm_diags_incr_xfer(put, put_bytes, node, size);
+    uint64_t t0 = chpl_comm_diags_latency_start();
 
     // Handle remote address not in remote segment.
 #ifdef GASNET_SEGMENT_EVERYTHING
@@ -1182,6 +1243,8 @@ void  chpl_comm_put(void* addr, c_nodeid_t node, void* raddr,
         wait_done_obj(&done);
       }
     }
+
+    chpl_comm_diags_latency_end(chpl_comm_diags_latency_put, t0);
   }
 }
 
@@ -1205,7 +1268,8 @@ void  chpl_comm_get(void* addr, c_nodeid_t node, void* raddr,
     }
 
     chpl_comm_diags_verbose_rdma("get", node, size, ln, fn);
-    chpl_comm_diags_incr(get);
+    chpl_comm_diags_incr_xfer(get, get_bytes, node, size);
+    uint64_t t0 = chpl_comm_diags_latency_start();
 
     // Handle remote address not in remote segment.
 
@@ -1302,9 +1366,134 @@ void  chpl_comm_get(void* addr, c_nodeid_t node, void* raddr,
         chpl_mem_free(local_buf, 0, 0);
       }
     }
+
+    chpl_comm_diags_latency_end(chpl_comm_diags_latency_get, t0);
   }
 }
 
+//
+// Unordered GETs are aggregated per target node and shipped as a batch
+// once the buffer fills or a fence is reached.  Only GETs small enough
+// to be carried back in a batch reply are aggregated; the compiler
+// only generates unordered GETs of those sizes.
+//
+void chpl_comm_get_unordered(void* addr, c_nodeid_t node, void* raddr,
+                             size_t size, int32_t typeIndex,
+                             int32_t commID, int ln, int32_t fn) {
+  if (chpl_nodeID == node) {
+    memmove(addr, raddr, size);
+    return;
+  }
+
+  if (size > CHPL_COMM_UNORDERED_MAX_GET_SIZE) {
+    chpl_comm_get(addr, node, raddr, size, typeIndex, commID, ln, fn);
+    return;
+  }
+
+  // Communications callback support
+  if (chpl_comm_have_callbacks(chpl_comm_cb_event_kind_get)) {
+    chpl_comm_cb_info_t cb_data =
+      {chpl_comm_cb_event_kind_get, chpl_nodeID, node,
+       .iu.comm={addr, raddr, size, typeIndex, commID, ln, fn}};
+    chpl_comm_do_callbacks (&cb_data);
+  }
+
+  chpl_comm_diags_verbose_rdma("unordered get", node, size, ln, fn);
+  chpl_comm_diags_incr_xfer(get, get_bytes, node, size);
+
+  chpl_comm_unordered_get(addr, node, raddr, size);
+}
+
+void chpl_comm_getput_unordered(c_nodeid_t dst_locale, void* dst_addr,
+                                c_nodeid_t src_locale, void* src_addr,
+                                size_t size, int32_t typeIndex,
+                                int32_t commID, int ln, int32_t fn) {
+  assert(dst_addr != NULL);
+  assert(src_addr != NULL);
+
+  if (size == 0)
+    return;
+
+  if (dst_locale == chpl_nodeID) {
+    chpl_comm_get_unordered(dst_addr, src_locale, src_addr, size,
+                            typeIndex, commID, ln, fn);
+  } else if (src_locale == chpl_nodeID) {
+    chpl_comm_put(src_addr, dst_locale, dst_addr, size,
+                  typeIndex, commID, ln, fn);
+  } else {
+    char buf[CHPL_COMM_UNORDERED_MAX_GET_SIZE];
+    void* tmp = (size <= sizeof(buf))
+                ? buf
+                : chpl_mem_alloc(size, CHPL_RT_MD_COMM_XMIT_RCV_BUF, 0, 0);
+    chpl_comm_get(tmp, src_locale, src_addr, size,
+                  typeIndex, commID, ln, fn);
+    chpl_comm_put(tmp, dst_locale, dst_addr, size,
+                  typeIndex, commID, ln, fn);
+    if (tmp != buf)
+      chpl_mem_free(tmp, 0, 0);
+  }
+}
+
+void chpl_comm_get_unordered_fence(void) {
+  chpl_comm_unordered_flush();
+}
+
+void chpl_comm_get_unordered_task_fence(void) {
+  chpl_comm_unordered_task_flush();
+}
+
+//
+// Unordered non-fetching atomics on processor atomic objects.  These
+// share the GET aggregation buffers, so either fence completes both
+// kinds of operation.
+//
+#define DEFN_CHPL_COMM_ATOMIC_UNORDERED_BINARY(op, type)                \
+  void chpl_comm_atomic_ ## op ## _unordered_ ## type                   \
+         (void* operand, c_nodeid_t node, void* object,                 \
+          int ln, int32_t fn) {                                         \
+    chpl_comm_unordered_amo(node, object, chpl_comm_unordered_op_ ## op, \
+                            chpl_comm_unordered_type_ ## type, operand); \
+  }
+
+DEFN_CHPL_COMM_ATOMIC_UNORDERED_BINARY(and, int32)
+DEFN_CHPL_COMM_ATOMIC_UNORDERED_BINARY(and, int64)
+DEFN_CHPL_COMM_ATOMIC_UNORDERED_BINARY(and, uint32)
+DEFN_CHPL_COMM_ATOMIC_UNORDERED_BINARY(and, uint64)
+
+DEFN_CHPL_COMM_ATOMIC_UNORDERED_BINARY(or, int32)
+DEFN_CHPL_COMM_ATOMIC_UNORDERED_BINARY(or, int64)
+DEFN_CHPL_COMM_ATOMIC_UNORDERED_BINARY(or, uint32)
+DEFN_CHPL_COMM_ATOMIC_UNORDERED_BINARY(or, uint64)
+
+DEFN_CHPL_COMM_ATOMIC_UNORDERED_BINARY(xor, int32)
+DEFN_CHPL_COMM_ATOMIC_UNORDERED_BINARY(xor, int64)
+DEFN_CHPL_COMM_ATOMIC_UNORDERED_BINARY(xor, uint32)
+DEFN_CHPL_COMM_ATOMIC_UNORDERED_BINARY(xor, uint64)
+
+DEFN_CHPL_COMM_ATOMIC_UNORDERED_BINARY(add, int32)
+DEFN_CHPL_COMM_ATOMIC_UNORDERED_BINARY(add, int64)
+DEFN_CHPL_COMM_ATOMIC_UNORDERED_BINARY(add, uint32)
+DEFN_CHPL_COMM_ATOMIC_UNORDERED_BINARY(add, uint64)
+DEFN_CHPL_COMM_ATOMIC_UNORDERED_BINARY(add, real32)
+DEFN_CHPL_COMM_ATOMIC_UNORDERED_BINARY(add, real64)
+
+DEFN_CHPL_COMM_ATOMIC_UNORDERED_BINARY(sub, int32)
+DEFN_CHPL_COMM_ATOMIC_UNORDERED_BINARY(sub, int64)
+DEFN_CHPL_COMM_ATOMIC_UNORDERED_BINARY(sub, uint32)
+DEFN_CHPL_COMM_ATOMIC_UNORDERED_BINARY(sub, uint64)
+DEFN_CHPL_COMM_ATOMIC_UNORDERED_BINARY(sub, real32)
+DEFN_CHPL_COMM_ATOMIC_UNORDERED_BINARY(sub, real64)
+
+#undef DEFN_CHPL_COMM_ATOMIC_UNORDERED_BINARY
+
+void chpl_comm_atomic_unordered_fence(void) {
+  chpl_comm_unordered_flush();
+}
+
+void chpl_comm_atomic_unordered_task_fence(void) {
+  chpl_comm_unordered_task_flush();
+}
+
 //
 // This is an adapter from Chapel code to GASNet's gasnet_gets_bulk. It does:
 // * convert count[0] and all of 'srcstr' and 'dststr' from counts of element
@@ -1347,10 +1536,15 @@ void  chpl_comm_get_strd(void* dstaddr, size_t* dststrides, c_nodeid_t srcnode_i
   
   // the case (chpl_nodeID == srcnode) is internally managed inside gasnet
   chpl_comm_diags_verbose_rdmaStrd("get", srcnode, ln, fn);
-  chpl_comm_diags_incr(get);
+  chpl_comm_diags_incr_xfer(get, get_bytes, srcnode,
+                            chpl_comm_diags_strd_bytes(count, stridelevels,
+                                                       elemSize));
+  chpl_comm_diags_incr(get_strd);
 
+  uint64_t t0 = chpl_comm_diags_latency_start();
   // TODO -- handle strided get for non-registered memory
-  gasnet_gets_bulk(dstaddr, dststr, srcnode, srcaddr, srcstr, cnt, strlvls); 
+  gasnet_gets_bulk(dstaddr, dststr, srcnode, srcaddr, srcstr, cnt, strlvls);
+  chpl_comm_diags_latency_end(chpl_comm_diags_latency_get, t0);
 }
 
 // See the comment for chpl_comm_gets().
@@ -1390,10 +1584,15 @@ void  chpl_comm_put_strd(void* dstaddr, size_t* dststrides, c_nodeid_t dstnode_i
 
   // the case (chpl_nodeID == dstnode) is internally managed inside gasnet
   chpl_comm_diags_verbose_rdmaStrd("put", dstnode, ln, fn);
-  chpl_comm_diags_incr(put);
+  chpl_comm_diags_incr_xfer(put, put_bytes, dstnode,
+                            chpl_comm_diags_strd_bytes(count, stridelevels,
+                                                       elemSize));
+  chpl_comm_diags_incr(put_strd);
 
+  uint64_t t0 = chpl_comm_diags_latency_start();
   // TODO -- handle strided put for non-registered memory
-  gasnet_puts_bulk(dstnode, dstaddr, dststr, srcaddr, srcstr, cnt, strlvls); 
+  gasnet_puts_bulk(dstnode, dstaddr, dststr, srcaddr, srcstr, cnt, strlvls);
+  chpl_comm_diags_latency_end(chpl_comm_diags_latency_put, t0);
 }
 
 static inline
@@ -1527,10 +1726,12 @@ void  chpl_comm_execute_on(c_nodeid_t node, c_sublocid_t subloc,
     }
 
     chpl_comm_diags_verbose_executeOn("", node);
-    chpl_comm_diags_incr(execute_on);
+    chpl_comm_diags_incr_executeOn(execute_on, node, arg_size);
 
+    uint64_t t0 = chpl_comm_diags_latency_start();
     execute_on_common(node, subloc, fid, arg, arg_size,
                      /*fast*/ false, /*blocking*/ true);
+    chpl_comm_diags_latency_end(chpl_comm_diags_latency_execute_on, t0);
   }
 }
 
@@ -1550,7 +1751,7 @@ void  chpl_comm_execute_on_nb(c_nodeid_t node, c_sublocid_t subloc,
     }
 
     chpl_comm_diags_verbose_executeOn("non-blocking", node);
-    chpl_comm_diags_incr(execute_on_nb);
+    chpl_comm_diags_incr_executeOn(execute_on_nb, node, arg_size);
   
     execute_on_common(node, subloc, fid, arg, arg_size,
                       /*fast*/ false, /*blocking*/ false);
@@ -1574,10 +1775,12 @@ void  chpl_comm_execute_on_fast(c_nodeid_t node, c_sublocid_t subloc,
     }
 
     chpl_comm_diags_verbose_executeOn("fast", node);
-    chpl_comm_diags_incr(execute_on_fast);
+    chpl_comm_diags_incr_executeOn(execute_on_fast, node, arg_size);
 
+    uint64_t t0 = chpl_comm_diags_latency_start();
     execute_on_common(node, subloc, fid, arg, arg_size,
                       /*fast*/ true, /*blocking*/ true);
+    chpl_comm_diags_latency_end(chpl_comm_diags_latency_execute_on, t0);
   }
 }
 
@@ -1586,7 +1789,9 @@ void chpl_comm_make_progress(void)
   gasnet_AMPoll();
 }
 
-void chpl_comm_task_end(void) { }
+void chpl_comm_task_end(void) {
+  chpl_comm_unordered_task_flush();
+}
 
 void chpl_comm_gasnet_help_register_global_var(int i, wide_ptr_t wide_addr) {
   if (chpl_nodeID == 0) {
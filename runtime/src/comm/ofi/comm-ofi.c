@@ -30,6 +30,7 @@
 #include "chpl-comm-callbacks-internal.h"
 #include "chpl-comm-diags.h"
 #include "chpl-comm-strd-xfer.h"
+#include "chpl-comm-unordered.h"
 #include "chpl-env.h"
 #include "chplexit.h"
 #include "chpl-format.h"
@@ -238,6 +239,9 @@ static void init_ofiEpNumCtxs(void);
 static void init_ofiExchangeAvInfo(void);
 static void init_ofiForMem(void);
 static void init_ofiForRma(void);
+#ifdef CHPL_COMM_OFI_UNORDERED_AGGREGATION
+static void init_ofiForAmos(void);
+#endif
 static void init_ofiForAms(void);
 
 static void init_bar(void);
@@ -282,6 +286,9 @@ void init_ofi(void) {
   init_ofiExchangeAvInfo();
   init_ofiForMem();
   init_ofiForRma();
+#ifdef CHPL_COMM_OFI_UNORDERED_AGGREGATION
+  init_ofiForAmos();
+#endif
   init_ofiForAms();
 }
 
@@ -831,6 +838,9 @@ void init_ofiForAms(void) {
              ofi_msg_reqs.msg_iov->iov_len);
 
   init_amHandling();
+#ifdef CHPL_COMM_OFI_UNORDERED_AGGREGATION
+  chpl_comm_unordered_init(amRequestUnordered, CHPL_COMM_UNORDERED_MAX_OPS);
+#endif
 }
 
 
@@ -1316,6 +1326,7 @@ typedef enum {
   am_opGet,                             // do an RMA GET
   am_opPut,                             // do an RMA PUT
   am_opAMO,                             // do an AMO
+  am_opUnordered,                       // do a batch of unordered ops
 } amOp_t;
 
 #ifdef CHPL_COMM_DEBUG
@@ -1328,6 +1339,10 @@ static void amRequestExecOn(c_nodeid_t, c_sublocid_t, chpl_fn_int_t,
 static void amRequestRMA(c_nodeid_t, amOp_t, void*, void*, size_t);
 static void amRequestAMO(c_nodeid_t, void*, const void*, const void*, void*,
                          int, enum fi_datatype, size_t);
+#ifdef CHPL_COMM_OFI_UNORDERED_AGGREGATION
+static void amRequestUnordered(c_nodeid_t, chpl_comm_unordered_op_t*, int,
+                               uint64_t*, int);
+#endif
 static void amRequestCommon(c_nodeid_t, chpl_comm_on_bundle_t*, size_t,
                             chpl_comm_amDone_t**);
 
@@ -1356,7 +1371,11 @@ void chpl_comm_make_progress(void) {
 }
 
 
-void chpl_comm_task_end(void) { }
+void chpl_comm_task_end(void) {
+#ifdef CHPL_COMM_OFI_UNORDERED_AGGREGATION
+  chpl_comm_unordered_task_flush();
+#endif
+}
 
 
 void chpl_comm_execute_on(c_nodeid_t node, c_sublocid_t subloc,
@@ -1376,9 +1395,11 @@ void chpl_comm_execute_on(c_nodeid_t node, c_sublocid_t subloc,
   }
 
   chpl_comm_diags_verbose_executeOn("", node);
-  chpl_comm_diags_incr(execute_on);
+  chpl_comm_diags_incr_executeOn(execute_on, node, argSize);
 
+  uint64_t t0 = chpl_comm_diags_latency_start();
   amRequestExecOn(node, subloc, fid, arg, argSize, false, true);
+  chpl_comm_diags_latency_end(chpl_comm_diags_latency_execute_on, t0);
 }
 
 
@@ -1406,7 +1427,7 @@ void chpl_comm_execute_on_nb(c_nodeid_t node, c_sublocid_t subloc,
   }
 
   chpl_comm_diags_verbose_executeOn("non-blocking", node);
-  chpl_comm_diags_incr(execute_on_nb);
+  chpl_comm_diags_incr_executeOn(execute_on_nb, node, argSize);
 
   amRequestExecOn(node, subloc, fid, arg, argSize, false, false);
 }
@@ -1429,9 +1450,11 @@ void chpl_comm_execute_on_fast(c_nodeid_t node, c_sublocid_t subloc,
   }
 
   chpl_comm_diags_verbose_executeOn("fast", node);
-  chpl_comm_diags_incr(execute_on_fast);
+  chpl_comm_diags_incr_executeOn(execute_on_fast, node, argSize);
 
+  uint64_t t0 = chpl_comm_diags_latency_start();
   amRequestExecOn(node, subloc, fid, arg, argSize, true, true);
+  chpl_comm_diags_latency_end(chpl_comm_diags_latency_execute_on, t0);
 }
 
 
@@ -1547,6 +1570,59 @@ void amRequestAMO(c_nodeid_t node, void* object,
 }
 
 
+#ifdef CHPL_COMM_OFI_UNORDERED_AGGREGATION
+//
+// Ship a batch of unordered operations (see chpl-comm-unordered.h).
+// The target retrieves the batch and returns any GET results by RMA,
+// so both have to be in registered memory here.
+//
+static
+void amRequestUnordered(c_nodeid_t node,
+                        chpl_comm_unordered_op_t* ops, int numOps,
+                        uint64_t* results, int numGets) {
+  const size_t opsSize = numOps * sizeof(ops[0]);
+  const size_t resSize = numGets * sizeof(results[0]);
+
+  chpl_comm_unordered_op_t* myOps = ops;
+  if (mrGetLocalKey(NULL, myOps, opsSize) != 0) {
+    myOps = allocBounceBuf(opsSize);
+    DBG_PRINTF(DBG_AM, "unordered ops BB: %p", myOps);
+    CHK_TRUE(mrGetLocalKey(NULL, myOps, opsSize) == 0);
+    memcpy(myOps, ops, opsSize);
+  }
+
+  uint64_t* myResults = results;
+  if (numGets > 0 && mrGetLocalKey(NULL, myResults, resSize) != 0) {
+    myResults = allocBounceBuf(resSize);
+    DBG_PRINTF(DBG_AM, "unordered results BB: %p", myResults);
+    CHK_TRUE(mrGetLocalKey(NULL, myResults, resSize) == 0);
+  }
+
+  chpl_comm_on_bundle_t arg;
+  arg.comm.uo = (struct chpl_comm_bundleData_unordered_t)
+                  { .b = (struct chpl_comm_bundleData_base_t)
+                         { .op = am_opUnordered, .node = chpl_nodeID },
+                    .ops = myOps,
+                    .numOps = numOps,
+                    .results = myResults,
+                    .numGets = numGets,
+                    .pDone = NULL };
+  amRequestCommon(node, &arg,
+                  (offsetof(chpl_comm_on_bundle_t, comm)
+                   + sizeof(arg.comm.uo)),
+                  &arg.comm.uo.pDone);
+
+  if (myResults != results) {
+    memcpy(results, myResults, resSize);
+    freeBounceBuf(myResults);
+  }
+  if (myOps != ops) {
+    freeBounceBuf(myOps);
+  }
+}
+#endif
+
+
 static inline
 void amRequestCommon(c_nodeid_t node,
                      chpl_comm_on_bundle_t* arg, size_t argSize,
@@ -1659,6 +1735,9 @@ static void amWrapExecOnLrgBody(void*);
 static void amWrapGet(void*);
 static void amWrapPut(void*);
 static void amHandleAMO(chpl_comm_on_bundle_t*);
+#ifdef CHPL_COMM_OFI_UNORDERED_AGGREGATION
+static void amWrapUnordered(void*);
+#endif
 static inline void amSendDone(struct chpl_comm_bundleData_base_t*,
                               chpl_comm_amDone_t*);
 
@@ -1848,6 +1927,19 @@ void processRxAmReq(struct perTxCtxInfo_t* tcip) {
         amHandleAMO(req);
         break;
 
+#ifdef CHPL_COMM_OFI_UNORDERED_AGGREGATION
+      case am_opUnordered:
+        //
+        // As for GET and PUT, the task lets us be sure the RMA that
+        // returns any results has completed before we say we're done.
+        //
+        chpl_task_startMovedTask(FID_NONE, (chpl_fn_p) amWrapUnordered,
+                                 chpl_comm_on_bundle_task_bundle(req),
+                                 sizeof(*req), c_sublocid_any,
+                                 chpl_nullTaskID);
+        break;
+#endif
+
       default:
         INTERNAL_ERROR_V("unexpected AM op %d", req->comm.b.op);
         break;
@@ -2092,6 +2184,48 @@ void amHandleAMO(chpl_comm_on_bundle_t* req) {
 }
 
 
+#ifdef CHPL_COMM_OFI_UNORDERED_AGGREGATION
+static
+void amWrapUnordered(void* p) {
+  chpl_comm_on_bundle_t* req = (chpl_comm_on_bundle_t*) p;
+  struct chpl_comm_bundleData_unordered_t* uo = &req->comm.uo;
+  c_nodeid_t node = uo->b.node;
+  DBG_PRINTF(DBG_AM | DBG_AMRECV,
+             "amWrapUnordered(seqId %d:%" PRIu64 "): "
+             "%d ops @ %p, %d gets to %p",
+             (int) node, uo->b.seq,
+             (int) uo->numOps, uo->ops, (int) uo->numGets, uo->results);
+
+  //
+  // Retrieve the batch from the initiator, apply it, and send back the
+  // GET results, if any.
+  //
+  const size_t opsSize = uo->numOps * sizeof(chpl_comm_unordered_op_t);
+  chpl_comm_unordered_op_t* ops = allocBounceBuf(opsSize);
+  CHK_TRUE(mrGetKey(NULL, node, uo->ops, opsSize) == 0);
+  (void) ofi_get(ops, node, uo->ops, opsSize);
+
+  uint64_t* results = NULL;
+  if (uo->numGets > 0) {
+    results = allocBounceBuf(uo->numGets * sizeof(results[0]));
+  }
+
+  int numGets = chpl_comm_unordered_apply(ops, uo->numOps, results);
+  CHK_TRUE(numGets == uo->numGets);
+
+  if (numGets > 0) {
+    const size_t resSize = numGets * sizeof(results[0]);
+    CHK_TRUE(mrGetKey(NULL, node, uo->results, resSize) == 0);
+    (void) ofi_put(results, node, uo->results, resSize);
+    freeBounceBuf(results);
+  }
+  freeBounceBuf(ops);
+
+  amSendDone(&uo->b, uo->pDone);
+}
+#endif
+
+
 static inline
 void amSendDone(struct chpl_comm_bundleData_base_t* b,
                 chpl_comm_amDone_t* pDone) {
@@ -2186,9 +2320,11 @@ void chpl_comm_put(void* addr, c_nodeid_t node, void* raddr,
   }
 
   chpl_comm_diags_verbose_rdma("put", node, size, ln, fn);
-  chpl_comm_diags_incr(put);
+  chpl_comm_diags_incr_xfer(put, put_bytes, node, size);
 
+  uint64_t t0 = chpl_comm_diags_latency_start();
   (void) ofi_put(addr, node, raddr, size);
+  chpl_comm_diags_latency_end(chpl_comm_diags_latency_put, t0);
 }
 
 
@@ -2215,10 +2351,90 @@ void chpl_comm_get(void* addr, int32_t node, void* raddr,
   }
 
   chpl_comm_diags_verbose_rdma("get", node, size, ln, fn);
-  chpl_comm_diags_incr(get);
+  chpl_comm_diags_incr_xfer(get, get_bytes, node, size);
 
+  uint64_t t0 = chpl_comm_diags_latency_start();
   (void) ofi_get(addr, node, raddr, size);
+  chpl_comm_diags_latency_end(chpl_comm_diags_latency_get, t0);
+}
+
+
+#ifdef CHPL_COMM_OFI_UNORDERED_AGGREGATION
+//
+// Unordered GETs small enough to be returned in a batch are aggregated
+// per target node and retrieved all at once, by the first fence or
+// when the buffer fills.  Larger ones are just done directly.
+//
+void chpl_comm_get_unordered(void* addr, c_nodeid_t node, void* raddr,
+                             size_t size, int32_t typeIndex,
+                             int32_t commID, int ln, int32_t fn) {
+  DBG_PRINTF(DBG_INTERFACE,
+             "chpl_comm_get_unordered(%p, %d, %p, %zd, %d, %d, %d, %s)",
+             addr, (int) node, raddr, size, (int) typeIndex, (int) commID,
+             ln, chpl_lookupFilename(fn));
+
+  CHK_TRUE(addr != NULL);
+  CHK_TRUE(raddr != NULL);
+
+  if (node == chpl_nodeID) {
+    memmove(addr, raddr, size);
+    return;
+  }
+
+  if (size > CHPL_COMM_UNORDERED_MAX_GET_SIZE) {
+    chpl_comm_get(addr, node, raddr, size, typeIndex, commID, ln, fn);
+    return;
+  }
+
+  // Communications callback support
+  if (chpl_comm_have_callbacks(chpl_comm_cb_event_kind_get)) {
+      chpl_comm_cb_info_t cb_data =
+        {chpl_comm_cb_event_kind_get, chpl_nodeID, node,
+         .iu.comm={addr, raddr, size, typeIndex, commID, ln, fn}};
+      chpl_comm_do_callbacks (&cb_data);
+  }
+
+  chpl_comm_diags_verbose_rdma("unordered get", node, size, ln, fn);
+  chpl_comm_diags_incr_xfer(get, get_bytes, node, size);
+
+  chpl_comm_unordered_get(addr, node, raddr, size);
+}
+
+
+void chpl_comm_getput_unordered(c_nodeid_t dstnode, void* dstaddr,
+                                c_nodeid_t srcnode, void* srcaddr,
+                                size_t size, int32_t typeIndex,
+                                int32_t commID, int ln, int32_t fn) {
+  CHK_TRUE(dstaddr != NULL);
+  CHK_TRUE(srcaddr != NULL);
+
+  if (size == 0)
+    return;
+
+  if (dstnode == chpl_nodeID) {
+    chpl_comm_get_unordered(dstaddr, srcnode, srcaddr, size,
+                            typeIndex, commID, ln, fn);
+  } else if (srcnode == chpl_nodeID) {
+    chpl_comm_put(srcaddr, dstnode, dstaddr, size,
+                  typeIndex, commID, ln, fn);
+  } else {
+    void* tmp = allocBounceBuf(size);
+    chpl_comm_get(tmp, srcnode, srcaddr, size, typeIndex, commID, ln, fn);
+    chpl_comm_put(tmp, dstnode, dstaddr, size, typeIndex, commID, ln, fn);
+    freeBounceBuf(tmp);
+  }
+}
+
+
+void chpl_comm_get_unordered_fence(void) {
+  chpl_comm_unordered_flush();
+}
+
+
+void chpl_comm_get_unordered_task_fence(void) {
+  chpl_comm_unordered_task_flush();
 }
+#endif
 
 
 void chpl_comm_put_strd(void* dstaddr_arg, size_t* dststrides,
@@ -2227,6 +2443,8 @@ void chpl_comm_put_strd(void* dstaddr_arg, size_t* dststrides,
                         size_t* count, int32_t stridelevels, size_t elemSize,
                         int32_t typeIndex, int32_t commID,
                         int ln, int32_t fn) {
+  if (dstnode != chpl_nodeID)
+    chpl_comm_diags_incr(put_strd);
   put_strd_common(dstaddr_arg, dststrides,
                   dstnode,
                   srcaddr_arg, srcstrides,
@@ -2242,6 +2460,8 @@ void chpl_comm_get_strd(void* dstaddr_arg, size_t* dststrides,
                         int32_t stridelevels, size_t elemSize,
                         int32_t typeIndex, int32_t commID,
                         int ln, int32_t fn) {
+  if (srcnode != chpl_nodeID)
+    chpl_comm_diags_incr(get_strd);
   get_strd_common(dstaddr_arg, dststrides,
                   srcnode,
                   srcaddr_arg, srcstrides,
@@ -2705,8 +2925,32 @@ void local_yield(void) {
 // Interface: network atomics
 //
 
+#ifdef CHPL_COMM_OFI_UNORDERED_AGGREGATION
+//
+// Which non-fetching AMOs can the network do, by op and type?  Asking
+// the provider costs enough that we only do it once, at startup.
+//
+static chpl_bool ofiAmoOk[FI_ATOMIC_OP_LAST][FI_DATATYPE_LAST];
+
+static
+void init_ofiForAmos(void) {
+  struct fid_ep* txCtx = tciTab[0].txCtx;
+
+  for (int op = 0; op < FI_ATOMIC_OP_LAST; op++) {
+    for (int type = 0; type < FI_DATATYPE_LAST; type++) {
+      size_t count;
+      ofiAmoOk[op][type] =
+        (fi_atomicvalid(txCtx, type, op, &count) == 0 && count > 0);
+    }
+  }
+}
+
+
+#endif
 static inline void doAMO(c_nodeid_t, void*, const void*, const void*, void*,
                          int, enum fi_datatype, size_t);
+static inline chpl_bool amoViaAm(c_nodeid_t, void*,
+                                 int, enum fi_datatype, size_t);
 
 
 //
@@ -2816,8 +3060,14 @@ DEFN_CHPL_COMM_ATOMIC_CMPXCHG(real64, FI_DOUBLE, double)
                "chpl_comm_atomic_%s_unordered_%s(<%s>, %d, %p, %d, %s)",\
                #fnOp, #fnType, DBG_VAL(operand, ofiType), (int) node,   \
                object, ln, chpl_lookupFilename(fn));                    \
-    chpl_comm_atomic_##fnOp##_##fnType(operand, node, object,           \
-                                       memory_order_seq_cst, ln, fn);   \
+    if (amoViaAm(node, object, ofiOp, ofiType, sizeof(Type))) {         \
+      chpl_comm_unordered_amo(node, object, chpl_comm_unordered_op_##fnOp,\
+                              chpl_comm_unordered_type_##fnType,        \
+                              operand);                                 \
+    } else {                                                            \
+      chpl_comm_atomic_##fnOp##_##fnType(operand, node, object,         \
+                                         memory_order_seq_cst, ln, fn); \
+    }                                                                   \
   }                                                                     \
                                                                         \
   void chpl_comm_atomic_fetch_##fnOp##_##fnType                         \
@@ -2876,8 +3126,14 @@ DEFN_IFACE_AMO_SIMPLE_OP(add, FI_SUM, real64, FI_DOUBLE, double)
                "%d, %s)",                                               \
                #fnType, DBG_VAL(operand, ofiType), (int) node, object,  \
                ln, chpl_lookupFilename(fn));                            \
-    chpl_comm_atomic_sub_##fnType(operand, node, object,                \
-                                  memory_order_seq_cst, ln, fn);        \
+    if (amoViaAm(node, object, FI_SUM, ofiType, sizeof(Type))) {        \
+      chpl_comm_unordered_amo(node, object, chpl_comm_unordered_op_sub, \
+                              chpl_comm_unordered_type_##fnType,        \
+                              operand);                                 \
+    } else {                                                            \
+      chpl_comm_atomic_sub_##fnType(operand, node, object,              \
+                                    memory_order_seq_cst, ln, fn);      \
+    }                                                                   \
   }                                                                     \
                                                                         \
   void chpl_comm_atomic_fetch_sub_##fnType                              \
@@ -2906,11 +3162,15 @@ DEFN_IFACE_AMO_SUB(real64, FI_DOUBLE, double, NEGATE_U_OR_R)
 
 
 void chpl_comm_atomic_unordered_fence(void) {
-  return;
+#ifdef CHPL_COMM_OFI_UNORDERED_AGGREGATION
+  chpl_comm_unordered_flush();
+#endif
 }
 
 void chpl_comm_atomic_unordered_task_fence(void) {
-  return;
+#ifdef CHPL_COMM_OFI_UNORDERED_AGGREGATION
+  chpl_comm_unordered_task_flush();
+#endif
 }
 
 
@@ -2950,8 +3210,14 @@ void doAMO(c_nodeid_t node, void* object,
       // The object address is remotely-accessible and the atomic op
       // and type are supported in the network.  Do the AMO natively.
       //
+      uint64_t t0 = 0;
+      if (node != chpl_nodeID) {
+        chpl_comm_diags_incr_amo(node, size);
+        t0 = chpl_comm_diags_latency_start();
+      }
       ofi_amo(tcip, node, object, mrKey, operand1, operand2, result,
               ofiOp, ofiType, size);
+      chpl_comm_diags_latency_end(chpl_comm_diags_latency_amo, t0);
       tciFree(tcip);
       return;
     }
@@ -2969,8 +3235,35 @@ void doAMO(c_nodeid_t node, void* object,
     return;
   }
 
+  chpl_comm_diags_incr_amo(node, size);
+  uint64_t t0 = chpl_comm_diags_latency_start();
   amRequestAMO(node, object, operand1, operand2, result,
                ofiOp, ofiType, size);
+  chpl_comm_diags_latency_end(chpl_comm_diags_latency_amo, t0);
+}
+
+
+//
+// Would a non-fetching AMO have to be done by AM on a remote node?
+// Unordered AMOs are aggregated only in that case: the CPU on the
+// target will be doing them anyway, and aggregating ones the network
+// could do would make them non-atomic with respect to ordered ones.
+// Without CHPL_COMM_OFI_UNORDERED_AGGREGATION (see Makefile.share)
+// they are never aggregated.
+//
+static inline
+chpl_bool amoViaAm(c_nodeid_t node, void* object,
+                   int ofiOp, enum fi_datatype ofiType, size_t size) {
+  if (node == chpl_nodeID) {
+    return false;
+  }
+
+#ifdef CHPL_COMM_OFI_UNORDERED_AGGREGATION
+  return !(ofiAmoOk[ofiOp][ofiType]
+           && mrGetKey(NULL, node, object, size) == 0);
+#else
+  return false;
+#endif
 }
 
 
@@ -3543,6 +3836,7 @@ const char* am_op2name(amOp_t op) {
   case am_opGet: return "opGet";
   case am_opPut: return "opPut";
   case am_opAMO: return "opAMO";
+  case am_opUnordered: return "opUnordered";
   }
   return "op???";
 }
@@ -5225,9 +5225,11 @@ void chpl_comm_put(void* addr, c_nodeid_t locale, void* raddr,
   }
 
   chpl_comm_diags_verbose_rdma("put", locale, size, ln, fn);
-  chpl_comm_diags_incr(put);
+  chpl_comm_diags_incr_xfer(put, put_bytes, locale, size);
 
+  uint64_t t0 = chpl_comm_diags_latency_start();
   do_remote_put(addr, locale, raddr, size, NULL, may_proxy_true);
+  chpl_comm_diags_latency_end(chpl_comm_diags_latency_put, t0);
 }
 
 
@@ -5748,7 +5750,7 @@ void chpl_comm_get_unordered(void* addr, c_nodeid_t locale, void* raddr,
   }
 
   chpl_comm_diags_verbose_rdma("unordered get", locale, size, ln, fn);
-  chpl_comm_diags_incr(get);
+  chpl_comm_diags_incr_xfer(get, get_bytes, locale, size);
 
   do_remote_get_buff(addr, locale, raddr, size, may_proxy_true);
 }
@@ -5788,9 +5790,11 @@ void chpl_comm_get(void* addr, c_nodeid_t locale, void* raddr,
   }
 
   chpl_comm_diags_verbose_rdma("get", locale, size, ln, fn);
-  chpl_comm_diags_incr(get);
+  chpl_comm_diags_incr_xfer(get, get_bytes, locale, size);
 
+  uint64_t t0 = chpl_comm_diags_latency_start();
   do_remote_get(addr, locale, raddr, size, may_proxy_true);
+  chpl_comm_diags_latency_end(chpl_comm_diags_latency_get, t0);
 }
 
 
@@ -6252,6 +6256,8 @@ void chpl_comm_put_strd(void* dstaddr_arg, size_t* dststrides,
                         int32_t typeIndex, int32_t commID, int ln, int32_t fn)
 {
   PERFSTATS_INC(put_strd_cnt);
+  if (dstlocale != chpl_nodeID)
+    chpl_comm_diags_incr(put_strd);
   put_strd_common(dstaddr_arg, dststrides,
                   dstlocale,
                   srcaddr_arg, srcstrides,
@@ -6268,6 +6274,8 @@ void chpl_comm_get_strd(void* dstaddr_arg, size_t* dststrides,
                         int32_t typeIndex, int32_t commID, int ln, int32_t fn)
 {
   PERFSTATS_INC(get_strd_cnt);
+  if (srclocale != chpl_nodeID)
+    chpl_comm_diags_incr(get_strd);
   get_strd_common(dstaddr_arg, dststrides,
                   srclocale,
                   srcaddr_arg, srcstrides,
@@ -6317,7 +6325,7 @@ chpl_comm_nb_handle_t chpl_comm_get_nb(void* addr, c_nodeid_t locale,
   }
 
   chpl_comm_diags_verbose_rdma("non-blocking get", locale, size, ln, fn);
-  chpl_comm_diags_incr(get_nb);
+  chpl_comm_diags_incr_xfer(get_nb, get_bytes, locale, size);
 
   //
   // For now, if the local address isn't in a memory region known to the
@@ -7364,6 +7372,8 @@ void do_nic_amo_nf_buff(void* opnd1, c_nodeid_t locale,
 
   check_nic_amo(size, object, remote_mr);
   PERFSTATS_INC(amo_cnt);
+  if (locale != chpl_nodeID)
+    chpl_comm_diags_incr_amo(locale, size);
 
   // grab lock for this thread
   spinlock_lock(&info->lock);
@@ -7401,6 +7411,8 @@ void do_nic_amo_nf(void* opnd1, c_nodeid_t locale,
 
   check_nic_amo(size, object, remote_mr);
   PERFSTATS_INC(amo_cnt);
+  if (locale != chpl_nodeID)
+    chpl_comm_diags_incr_amo(locale, size);
 
   //
   // Fill in the POST descriptor.
@@ -7420,7 +7432,9 @@ void do_nic_amo_nf(void* opnd1, c_nodeid_t locale,
   //
   // Initiate the transaction and wait for it to complete.
   //
+  uint64_t t0 = (locale != chpl_nodeID) ? chpl_comm_diags_latency_start() : 0;
   post_fma_and_wait(locale, &post_desc, true);
+  chpl_comm_diags_latency_end(chpl_comm_diags_latency_amo, t0);
 }
 
 
@@ -7437,6 +7451,8 @@ void do_nic_amo(void* opnd1, void* opnd2, c_nodeid_t locale,
 
   check_nic_amo(size, object, remote_mr);
   PERFSTATS_INC(amo_cnt);
+  if (locale != chpl_nodeID)
+    chpl_comm_diags_incr_amo(locale, size);
 
   //
   // Make sure that, if we need a result, it is in memory known to the
@@ -7481,7 +7497,9 @@ void do_nic_amo(void* opnd1, void* opnd2, c_nodeid_t locale,
   //
   // Initiate the transaction and wait for it to complete.
   //
+  uint64_t t0 = (locale != chpl_nodeID) ? chpl_comm_diags_latency_start() : 0;
   post_fma_and_wait(locale, &post_desc, true);
+  chpl_comm_diags_latency_end(chpl_comm_diags_latency_amo, t0);
 
   //
   // If the result wasn't registered, copy the trampoline memory to it
@@ -7563,10 +7581,12 @@ void chpl_comm_execute_on(c_nodeid_t locale, c_sublocid_t subloc,
   }
 
   chpl_comm_diags_verbose_executeOn("", locale);
-  chpl_comm_diags_incr(execute_on);
+  chpl_comm_diags_incr_executeOn(execute_on, locale, arg_size);
 
   PERFSTATS_INC(fork_call_cnt);
+  uint64_t t0 = chpl_comm_diags_latency_start();
   fork_call_common(locale, subloc, fid, arg, arg_size, false, true);
+  chpl_comm_diags_latency_end(chpl_comm_diags_latency_execute_on, t0);
 }
 
 
@@ -7589,7 +7609,7 @@ void chpl_comm_execute_on_nb(c_nodeid_t locale, c_sublocid_t subloc,
   }
 
   chpl_comm_diags_verbose_executeOn("non-blocking", locale);
-  chpl_comm_diags_incr(execute_on_nb);
+  chpl_comm_diags_incr_executeOn(execute_on_nb, locale, arg_size);
 
   PERFSTATS_INC(fork_call_nb_cnt);
   fork_call_common(locale, subloc, fid, arg, arg_size, false, false);
@@ -7615,14 +7635,16 @@ void chpl_comm_execute_on_fast(c_nodeid_t locale, c_sublocid_t subloc,
   }
 
   chpl_comm_diags_verbose_executeOn("fast", locale);
-  chpl_comm_diags_incr(execute_on_fast);
+  chpl_comm_diags_incr_executeOn(execute_on_fast, locale, arg_size);
 
   //
   // Note: the rf_handler() logic assumes that fast implies blocking.
   //       We enforce that here.
   //
   PERFSTATS_INC(fork_call_fast_cnt);
+  uint64_t t0 = chpl_comm_diags_latency_start();
   fork_call_common(locale, subloc, fid, arg, arg_size, true, true);
+  chpl_comm_diags_latency_end(chpl_comm_diags_latency_execute_on, t0);
 }
 
 
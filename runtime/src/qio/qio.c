@@ -37,6 +37,7 @@
 
 #include "qio.h"
 #include "qbuffer.h"
+#include "qio_uring.h"
 
 #include "error.h"
 
@@ -54,6 +55,7 @@
 #include <sys/select.h>
 //#include <sys/fcntl.h> no sys/fcntl.h on AIX, fcntl.h should cover it.
 #include <sys/stat.h>
+#include <sys/mman.h>
 
 #include <assert.h>
 
@@ -87,6 +89,11 @@
 // when rounding up to 4k pages.
 ssize_t qio_too_small_for_default_mmap = 16*1024;
 ssize_t qio_mmap_chunk_iobufs = 128; // mmap 128 iobufs at a time (8M)
+// With QIO_HINT_SEQUENTIAL, map bigger windows so that large
+// files are walked with fewer mmap/munmap calls.
+ssize_t qio_mmap_sequential_chunk_iobufs = 1024; // 64M
+// Only ask for huge pages on mappings at least this big.
+ssize_t qio_mmap_hugepage_min = 2*1024*1024;
 
 // Future - possibly set this based on ulimit?
 ssize_t qio_initial_mmap_max = 8*1024*1024;
@@ -654,26 +661,63 @@ qioerr qio_fadvise_for_hints(qio_file_t* file)
   return 0;
 }
 
+// window is set when data is one of the windows that a channel maps
+// as it moves through a file (vs. the file's initial mapping).
 static
-qioerr qio_madvise_for_hints(void* data, int64_t len, qio_hint_t hints)
+qioerr qio_madvise_for_hints(void* data, int64_t len, qio_hint_t hints, int window)
 {
-  int advice = 0;
+  int access = 0;
+  int willneed = 0;
   qioerr err;
 
+  // The advice values are not bit flags, so each is a separate call.
+#ifdef POSIX_MADV_SEQUENTIAL
+  if( hints & QIO_HINT_SEQUENTIAL ) access = POSIX_MADV_SEQUENTIAL;
+#endif
 #ifdef POSIX_MADV_RANDOM
-  if( hints & QIO_HINT_RANDOM ) advice |= POSIX_MADV_RANDOM;
+  if( hints & QIO_HINT_RANDOM ) access = POSIX_MADV_RANDOM;
 #endif
-#ifdef POSIX_MADV_SEQUENTIAL
-  if( hints & QIO_HINT_SEQUENTIAL ) advice |= POSIX_MADV_SEQUENTIAL;
+#ifdef POSIX_MADV_WILLNEED
+  // A sequential reader will touch all of a window soon,
+  // so start reading it in now.
+  if( (hints & QIO_HINT_CACHED) ||
+      (window && access == POSIX_MADV_SEQUENTIAL) ) willneed = 1;
 #endif
+
+  if( access ) {
+    err = qio_int_to_err(sys_posix_madvise(data, len, access));
+    if( err ) return err;
+  }
+
 #ifdef POSIX_MADV_WILLNEED
-  if( hints & QIO_HINT_CACHED ) advice |= POSIX_MADV_WILLNEED;
+  if( willneed ) {
+    err = qio_int_to_err(sys_posix_madvise(data, len, POSIX_MADV_WILLNEED));
+    if( err ) return err;
+  }
+#endif
+
+#ifdef MADV_HUGEPAGE
+  // Huge pages cut TLB misses when streaming through big mappings.
+  // Not every kernel or file system supports them for file mappings,
+  // and this is only advice, so ignore any error.
+  if( (hints & (QIO_HINT_SEQUENTIAL|QIO_HINT_CACHED)) &&
+      !(hints & QIO_HINT_RANDOM) &&
+      len >= qio_mmap_hugepage_min ) {
+    (void) madvise(data, len, MADV_HUGEPAGE);
+  }
 #endif
 
-  if( advice == 0 ) err = 0; // do nothing.
-  else err = qio_int_to_err(sys_posix_madvise(data, len, advice));
+  return 0;
+}
 
-  return err;
+// How much of the file a channel maps at a time.
+static
+size_t qio_mmap_window_size(qio_hint_t hints)
+{
+  if( (hints & QIO_HINT_SEQUENTIAL) && !(hints & QIO_HINT_RANDOM) )
+    return qio_mmap_sequential_chunk_iobufs * qbytes_iobuf_size;
+  else
+    return qio_mmap_chunk_iobufs * qbytes_iobuf_size;
 }
 
 static
@@ -715,7 +759,7 @@ qioerr qio_mmap_initial(qio_file_t* file)
     err = qio_int_to_err(sys_mmap(NULL, len, prot, MAP_SHARED|populate, file->fd, 0, &data));
     if( err ) return err;
 
-    err = qio_madvise_for_hints(data, len, file->hints);
+    err = qio_madvise_for_hints(data, len, file->hints, 0);
     if( err ) {
       sys_munmap(data, len);
       return err;
@@ -2170,7 +2214,7 @@ qioerr _buffered_get_mmap(qio_channel_t* ch, int64_t amt_in, int writing)
 {
   qbuffer_iter_t start;
   qioerr err;
-  size_t mmap_chunk = qio_mmap_chunk_iobufs * qbytes_iobuf_size;
+  size_t mmap_chunk = qio_mmap_window_size(ch->hints);
   struct stat stats;
   int prot;
   void* data;
@@ -2195,6 +2239,22 @@ qioerr _buffered_get_mmap(qio_channel_t* ch, int64_t amt_in, int writing)
 
   start = qbuffer_end(&ch->buf);
 
+  // If the file's initial mapping already covers what we need,
+  // share it instead of mapping the same pages again. Writing
+  // channels map their own windows since closing one can
+  // truncate the file.
+  if( ch->file->mmap && !(ch->flags & QIO_FDFLAG_WRITEABLE) ) {
+    int64_t mapped_end = ch->file->mmap->len;
+    if( ch->end_pos < mapped_end ) mapped_end = ch->end_pos;
+
+    if( start.offset + amt <= mapped_end ) {
+      err = qbuffer_append(&ch->buf, ch->file->mmap, start.offset,
+                           mapped_end - start.offset);
+      ch->av_end = qbuffer_end_offset(&ch->buf);
+      return err;
+    }
+  }
+
   pages_in = start.offset / pagesize;
   map_start = pages_in * pagesize;
   skip = start.offset - map_start;
@@ -2270,6 +2330,9 @@ qioerr _buffered_get_mmap(qio_channel_t* ch, int64_t amt_in, int writing)
     err = qio_int_to_err(sys_mmap(NULL, len, prot, MAP_SHARED, ch->file->fd, map_start, &data));
     if( err ) return err;
 
+    // The advice only affects performance, so ignore any error.
+    (void) qio_madvise_for_hints(data, len, ch->hints, 1);
+
     err = qbytes_create_generic(&bytes, data, len, qbytes_free_munmap);
     if( err ) {
       sys_munmap(data, len);
@@ -2341,6 +2404,9 @@ qioerr _buffered_read_atleast(qio_channel_t* ch, int64_t amt)
       case QIO_METHOD_PREADPWRITE:
         err = qio_preadv(ch->file, &ch->buf, read_start, read_end, read_start.offset, &num_read);
         break;
+      case QIO_METHOD_IOURING:
+        err = qio_uring_preadv(ch->file, &ch->buf, read_start, read_end, read_start.offset, &num_read);
+        break;
       case QIO_METHOD_FREADFWRITE:
         err = qio_freadv(ch->file->fp, &ch->buf, read_start, read_end, &num_read);
         break;
@@ -2571,6 +2637,9 @@ qioerr _qio_buffered_behind(qio_channel_t* ch, int flushall)
         case QIO_METHOD_PREADPWRITE:
           err = qio_pwritev(ch->file, &ch->buf, write_start, write_end, write_start.offset, &num_written);
           break;
+        case QIO_METHOD_IOURING:
+          err = qio_uring_pwritev(ch->file, &ch->buf, write_start, write_end, write_start.offset, &num_written);
+          break;
         case QIO_METHOD_FREADFWRITE:
           err = qio_fwritev(ch->file->fp, &ch->buf, write_start, write_end, &num_written);
           break;
@@ -2798,6 +2867,9 @@ qioerr _qio_unbuffered_write(qio_channel_t* ch, const void* ptr, ssize_t len_in,
         case QIO_METHOD_PREADPWRITE:
           err = qio_int_to_err(sys_pwrite(ch->file->fd, ptr, len, _right_mark_start(ch), &num_written));
           break;
+        case QIO_METHOD_IOURING:
+          err = qio_uring_pwrite(ch->file->fd, ptr, len, _right_mark_start(ch), &num_written);
+          break;
         case QIO_METHOD_FREADFWRITE:
           if( ch->file->fp ) {
             num_written_u = fwrite(ptr, 1, len, ch->file->fp);
@@ -2870,7 +2942,8 @@ qioerr _qio_unbuffered_read(qio_channel_t* ch, void* ptr, ssize_t len_in, ssize_
   len = len_in;
 
   if( ch->file->mmap &&
-      (method == QIO_METHOD_PREADPWRITE || method == QIO_METHOD_MMAP) &&
+      (method == QIO_METHOD_PREADPWRITE || method == QIO_METHOD_IOURING ||
+       method == QIO_METHOD_MMAP) &&
       _right_mark_start(ch) + len <= ch->file->mmap->len) {
     // As long as we're using an I/O method that seeks on every read,
     // copy the data out of the mmap.
@@ -2888,6 +2961,9 @@ qioerr _qio_unbuffered_read(qio_channel_t* ch, void* ptr, ssize_t len_in, ssize_
         case QIO_METHOD_PREADPWRITE:
           err = qio_int_to_err(sys_pread(ch->file->fd, ptr, len, _right_mark_start(ch), &num_read));
           break;
+        case QIO_METHOD_IOURING:
+          err = qio_uring_pread(ch->file->fd, ptr, len, _right_mark_start(ch), &num_read);
+          break;
         case QIO_METHOD_FREADFWRITE:
           if( ch->file->fp ) {
             num_read_u = fread(ptr, 1, len, ch->file->fp);
@@ -4229,3 +4305,62 @@ qioerr qio_locales_for_region(qio_file_t* fl, off_t start, off_t end, const char
   }
 }
 
+// Divide start..end-1 into nsplits pieces that begin just after a
+// 'byte' (e.g. at the start of a line), so that each piece can be
+// read by a different channel. offsets_out must have room for
+// nsplits+1 values; piece i is offsets_out[i]..offsets_out[i+1]-1.
+// offsets_out[0] is start, and offsets_out[nsplits] is end or the
+// file length, whichever is smaller. A piece can be empty if the
+// records are longer than the pieces.
+qioerr qio_file_find_splits(qio_file_t* file, int64_t start, int64_t end, int64_t nsplits, int byte, int64_t* offsets_out)
+{
+  qio_channel_t* ch = NULL;
+  int64_t len;
+  int64_t per_split;
+  int64_t i;
+  qioerr err;
+
+  if( nsplits < 1 || start < 0 || end < start ) {
+    QIO_RETURN_CONSTANT_ERROR(EINVAL, "invalid split request");
+  }
+
+  err = qio_file_length(file, &len);
+  if( err ) return err;
+  if( end > len ) end = len;
+  if( start > end ) start = end;
+
+  per_split = (end - start) / nsplits;
+
+  offsets_out[0] = start;
+  for( i = 1; i < nsplits; i++ ) {
+    int64_t guess = start + i * per_split;
+
+    offsets_out[i] = offsets_out[i-1];
+    if( guess <= offsets_out[i-1] ) continue;
+
+    // A piece starts at guess if the byte before it is the separator,
+    // so start looking there.
+    err = qio_channel_create(&ch, file, QIO_CH_BUFFERED, 1, 0,
+                             guess - 1, end, NULL);
+    if( err ) return err;
+
+    err = qio_channel_advance_past_byte(false, ch, byte);
+    if( err == 0 ) {
+      offsets_out[i] = qio_channel_offset_unlocked(ch);
+    } else if( qio_err_to_int(err) == EEOF ||
+               qio_err_to_int(err) == ESHORT ) {
+      // No separator in the rest of the region.
+      offsets_out[i] = end;
+      err = 0;
+    }
+
+    qio_channel_release(ch);
+    ch = NULL;
+
+    if( err ) return err;
+  }
+  offsets_out[nsplits] = end;
+
+  return 0;
+}
+
@@ -65,6 +65,132 @@ static int wcwidth(int wc) {
 }
 #endif
 
+// Bulk byte scanning for the text fast paths below. These look at a
+// block of bytes at a time in the cached buffer window (see
+// qio_channel_begin_peek_cached) and use SSE2 or AVX2 when the compiler
+// targets them, with a scalar loop for the tail and other targets.
+//
+// The fast paths only ever consume ASCII through these; any byte with
+// the high bit set stops a scan so that character decoding (and its
+// errors) still happen in the per-character code.
+#if defined(__GNUC__) && defined(__AVX2__)
+#include <immintrin.h>
+#define QIO_SCAN_AVX2 1
+#elif defined(__GNUC__) && defined(__SSE2__)
+#include <emmintrin.h>
+#define QIO_SCAN_SSE2 1
+#endif
+
+// Returns the first byte in [p,end) that is not a decimal digit, or end.
+static inline
+const uint8_t* _qio_scan_skip_digits(const uint8_t* p, const uint8_t* end)
+{
+#if defined(QIO_SCAN_AVX2)
+  const __m256i zero = _mm256_set1_epi8('0');
+  const __m256i nine = _mm256_set1_epi8(9);
+  for( ; end - p >= 32; p += 32 ) {
+    __m256i v = _mm256_sub_epi8(_mm256_loadu_si256((const __m256i*) p), zero);
+    __m256i ok = _mm256_cmpeq_epi8(_mm256_min_epu8(v, nine), v);
+    uint32_t mask = ~(uint32_t) _mm256_movemask_epi8(ok);
+    if( mask ) return p + __builtin_ctz(mask);
+  }
+#elif defined(QIO_SCAN_SSE2)
+  const __m128i zero = _mm_set1_epi8('0');
+  const __m128i nine = _mm_set1_epi8(9);
+  for( ; end - p >= 16; p += 16 ) {
+    __m128i v = _mm_sub_epi8(_mm_loadu_si128((const __m128i*) p), zero);
+    __m128i ok = _mm_cmpeq_epi8(_mm_min_epu8(v, nine), v);
+    uint32_t mask = 0xffff & ~(uint32_t) _mm_movemask_epi8(ok);
+    if( mask ) return p + __builtin_ctz(mask);
+  }
+#endif
+  for( ; p < end; p++ ) {
+    if( (uint8_t) (*p - '0') > 9 ) return p;
+  }
+  return end;
+}
+
+// Returns the first byte in [p,end) that is not ASCII whitespace
+// (space, \t, \n, \v, \f or \r), or end.
+static inline
+const uint8_t* _qio_scan_skip_space(const uint8_t* p, const uint8_t* end)
+{
+#if defined(QIO_SCAN_AVX2)
+  const __m256i sp = _mm256_set1_epi8(' ');
+  const __m256i tab = _mm256_set1_epi8('\t');
+  const __m256i four = _mm256_set1_epi8(4);
+  for( ; end - p >= 32; p += 32 ) {
+    __m256i v = _mm256_loadu_si256((const __m256i*) p);
+    __m256i c = _mm256_sub_epi8(v, tab);
+    __m256i ws = _mm256_or_si256(_mm256_cmpeq_epi8(v, sp),
+                   _mm256_cmpeq_epi8(_mm256_min_epu8(c, four), c));
+    uint32_t mask = ~(uint32_t) _mm256_movemask_epi8(ws);
+    if( mask ) return p + __builtin_ctz(mask);
+  }
+#elif defined(QIO_SCAN_SSE2)
+  const __m128i sp = _mm_set1_epi8(' ');
+  const __m128i tab = _mm_set1_epi8('\t');
+  const __m128i four = _mm_set1_epi8(4);
+  for( ; end - p >= 16; p += 16 ) {
+    __m128i v = _mm_loadu_si128((const __m128i*) p);
+    __m128i c = _mm_sub_epi8(v, tab);
+    __m128i ws = _mm_or_si128(_mm_cmpeq_epi8(v, sp),
+                   _mm_cmpeq_epi8(_mm_min_epu8(c, four), c));
+    uint32_t mask = 0xffff & ~(uint32_t) _mm_movemask_epi8(ws);
+    if( mask ) return p + __builtin_ctz(mask);
+  }
+#endif
+  for( ; p < end; p++ ) {
+    if( ! (*p == ' ' || (uint8_t) (*p - '\t') <= 4) ) return p;
+  }
+  return end;
+}
+
+// Returns the first byte in [p,end) that is not ASCII, is a or b, or
+// (if stop_ctl) is a space or control character; or end.
+// Pass 0x80 for a or b to not stop on anything extra.
+static inline
+const uint8_t* _qio_scan_find_stop(const uint8_t* p, const uint8_t* end,
+                                   uint8_t a, uint8_t b, int stop_ctl)
+{
+#if defined(QIO_SCAN_AVX2)
+  const __m256i va = _mm256_set1_epi8(a);
+  const __m256i vb = _mm256_set1_epi8(b);
+  const __m256i ctl = _mm256_set1_epi8(stop_ctl ? ' ' : 0);
+  const __m256i ctlmask = _mm256_set1_epi8(stop_ctl ? -1 : 0);
+  for( ; end - p >= 32; p += 32 ) {
+    __m256i v = _mm256_loadu_si256((const __m256i*) p);
+    __m256i stop = _mm256_or_si256(_mm256_cmpeq_epi8(v, va),
+                                   _mm256_cmpeq_epi8(v, vb));
+    stop = _mm256_or_si256(stop, _mm256_and_si256(ctlmask,
+             _mm256_cmpeq_epi8(_mm256_min_epu8(v, ctl), v)));
+    // the sign bit of each byte marks non-ASCII
+    uint32_t mask = (uint32_t) _mm256_movemask_epi8(_mm256_or_si256(stop, v));
+    if( mask ) return p + __builtin_ctz(mask);
+  }
+#elif defined(QIO_SCAN_SSE2)
+  const __m128i va = _mm_set1_epi8(a);
+  const __m128i vb = _mm_set1_epi8(b);
+  const __m128i ctl = _mm_set1_epi8(stop_ctl ? ' ' : 0);
+  const __m128i ctlmask = _mm_set1_epi8(stop_ctl ? -1 : 0);
+  for( ; end - p >= 16; p += 16 ) {
+    __m128i v = _mm_loadu_si128((const __m128i*) p);
+    __m128i stop = _mm_or_si128(_mm_cmpeq_epi8(v, va),
+                                _mm_cmpeq_epi8(v, vb));
+    stop = _mm_or_si128(stop, _mm_and_si128(ctlmask,
+             _mm_cmpeq_epi8(_mm_min_epu8(v, ctl), v)));
+    // the sign bit of each byte marks non-ASCII
+    uint32_t mask = (uint32_t) _mm_movemask_epi8(_mm_or_si128(stop, v));
+    if( mask ) return p + __builtin_ctz(mask);
+  }
+#endif
+  for( ; p < end; p++ ) {
+    if( *p >= 0x80 || *p == a || *p == b || (stop_ctl && *p <= ' ') )
+      return p;
+  }
+  return end;
+}
+
 qioerr qio_channel_read_uvarint(const int threadsafe, qio_channel_t* restrict ch, uint64_t* restrict ptr) {
   qioerr err = 0;
   uint8_t byte;
@@ -164,6 +290,20 @@ qioerr _peek_until_byte(qio_channel_t* restrict ch, uint8_t term_byte, int64_t*
   uint64_t num = 0;
   uint8_t byte = 0;
   int found_term;
+  void* start;
+  void* end;
+  uint8_t* found;
+
+  // Fast path: the terminator is in the cached buffer window.
+  err = qio_channel_begin_peek_cached(false, ch, &start, &end);
+  if( err ) return err;
+  found = start ? memchr(start, term_byte, qio_ptr_diff(end, start)) : NULL;
+  qio_channel_end_peek_cached(false, ch, start);
+  if( found ) {
+    *amt_read_out = qio_ptr_diff(found, start);
+    *found_term_out = 1;
+    return 0;
+  }
 
   mark_offset = qio_channel_offset_unlocked(ch);
 
@@ -321,6 +461,42 @@ qioerr _append_char(char* restrict * restrict buf, size_t* restrict buf_len, siz
   return 0;
 }
 
+// Like _append_char, but appends len bytes that are already encoded.
+static
+qioerr _append_bytes(char* restrict * restrict buf, size_t* restrict buf_len, size_t* restrict buf_max, const void* restrict bytes, size_t len)
+{
+  char* buf_in = *buf;
+  size_t len_in = *buf_len;
+  size_t max_in = *buf_max;
+  char* newbuf;
+  size_t newsz;
+  size_t need;
+
+  need = len_in + len + 1;
+  if( need < len_in || need > (SSIZE_MAX-1) ) {
+    // Too big.
+    QIO_RETURN_CONSTANT_ERROR(EOVERFLOW, "");
+  }
+  if( need >= max_in ) {
+    newsz = 2 * max_in;
+    if( newsz < 16  ) newsz = 16;
+    if( newsz < need  ) newsz = need;
+    newbuf = qio_realloc(buf_in, newsz);
+    if( ! newbuf ) return QIO_ENOMEM;
+    buf_in = newbuf;
+    max_in = newsz;
+  }
+
+  qio_memcpy(&buf_in[len_in], bytes, len);
+  len_in += len;
+
+  *buf = buf_in;
+  *buf_len = len_in;
+  *buf_max = max_in;
+
+  return 0;
+}
+
 // string binary style:
 // QIO_BINARY_STRING_STYLE_LEN1B_DATA -1 -- 1 byte of length before
 // QIO_BINARY_STRING_STYLE_LEN2B_DATA -2 -- 2 bytes of length before
@@ -713,6 +889,42 @@ qioerr qio_channel_scan_string(const int threadsafe, qio_channel_t* restrict ch,
       break;
     } else {
       err = _append_char(&ret, &ret_len, &ret_max, chr);
+
+      if( ! err && qio_glocale_utf8 > 0 ) {
+        // Copy the run of ordinary ASCII characters that follows
+        // in bulk. Anything that might need attention (a backslash,
+        // the terminator, whitespace or non-ASCII) ends the run and
+        // goes around the loop as usual; 0x80 means nothing extra.
+        void* start;
+        void* end;
+        const uint8_t* stop;
+        ssize_t avail;
+        ssize_t left_chars = maxlen_chars - (nread + 1);
+        ssize_t left_bytes = maxlen_bytes -
+                             (qio_channel_offset_unlocked(ch) - mark_offset);
+
+        err = qio_channel_begin_peek_cached(false, ch, &start, &end);
+        if( err ) break;
+        if( start ) {
+          avail = qio_ptr_diff(end, start);
+          if( avail > left_chars ) avail = left_chars;
+          if( avail > left_bytes ) avail = left_bytes;
+          if( avail < 0 ) avail = 0;
+          stop = _qio_scan_find_stop(start,
+                   (const uint8_t*) start + avail,
+                   handle_back ? '\\' : 0x80,
+                   (!stop_space && 0 <= term_chr && term_chr < 0x80) ?
+                     term_chr : 0x80,
+                   stop_space);
+          err = _append_bytes(&ret, &ret_len, &ret_max, start,
+                              qio_ptr_diff((void*) stop, start));
+          if( ! err ) {
+            nread += qio_ptr_diff((void*) stop, start);
+            start = (void*) stop;
+          }
+        }
+        qio_channel_end_peek_cached(false, ch, start);
+      }
     }
   }
 
@@ -1885,6 +2097,100 @@ typedef struct number_reading_state_s {
                // set to -1 if we shouldn't yet be at the end.
 } number_reading_state_t;
 
+// Fast path for _peek_number_unlocked: handle a decimal number that
+// (together with any whitespace before it and the character after it)
+// is entirely in the cached buffer window, using the bulk scanners for
+// the whitespace and runs of digits. This sets the same fields in s
+// that the character-at-a-time version would.
+//
+// Returns 1 if it handled the number, or 0 (without changing s or the
+// channel) if the caller needs to take the general path - for example
+// because the number continues past the end of the window, uses a
+// base prefix, inf or nan, or there is a non-ASCII character nearby.
+static
+int _peek_number_cached(qio_channel_t* restrict ch, number_reading_state_t* restrict s, int64_t mark_offset)
+{
+  void* vstart;
+  void* vend;
+  const uint8_t* start;
+  const uint8_t* end;
+  const uint8_t* p;
+  int c;
+  signed char sign = 0;
+  int64_t digits_start;
+  int64_t point = -1;
+  int64_t exponent = -1;
+  int64_t num_end;
+  int ok = 0;
+
+#define CACHED_OFFSET(ptr) (mark_offset + ((ptr) - start))
+
+  if( qio_glocale_utf8 <= 0 ) return 0;
+  if( s->usebase != 10 || s->allow_i_after ) return 0;
+
+  if( qio_channel_begin_peek_cached(false, ch, &vstart, &vend) ) return 0;
+  start = vstart;
+  end = vend;
+  if( ! start ) goto done;
+
+  p = _qio_scan_skip_space(start, end);
+  // iswspace might accept other control characters
+  if( p == end || *p < ' ' || *p >= 0x80 ) goto done;
+  c = tolower(*p);
+
+  if( s->allow_pos_sign && c == s->positive_char ) {
+    sign = 1;
+  } else if( s->allow_neg_sign && c == s->negative_char ) {
+    sign = -1;
+  }
+
+  if( sign ) {
+    p++;
+    if( p == end || *p >= 0x80 ) goto done;
+    c = *p;
+  }
+
+  if( ! ('0' <= c && c <= '9') ) goto done;
+  if( c == '0' ) {
+    if( p + 1 == end || p[1] >= 0x80 ) goto done;
+    c = tolower(p[1]);
+    if( s->allow_base && (c == 'x' || c == 'o' || c == 'b') ) goto done;
+  }
+  digits_start = CACHED_OFFSET(p);
+
+  while( 1 ) {
+    p = _qio_scan_skip_digits(p, end);
+    if( p == end || *p >= 0x80 ) goto done;
+    c = tolower(*p);
+    if( s->allow_point && c == s->point_char && point == -1 ) {
+      num_end = point = CACHED_OFFSET(p) + 1;
+      p++;
+    } else if( s->allow_real && c == s->exponent_char && exponent == -1 ) {
+      num_end = exponent = CACHED_OFFSET(p) + 1;
+      p++;
+      if( p == end || *p >= 0x80 ) goto done;
+      c = tolower(*p);
+      if( c == s->positive_char || c == s->negative_char ) p++;
+    } else {
+      num_end = CACHED_OFFSET(p);
+      break;
+    }
+  }
+
+  s->sign = sign;
+  s->digits_start = digits_start;
+  s->point = point;
+  s->exponent = exponent;
+  s->end = num_end;
+  ok = 1;
+
+done:
+  qio_channel_end_peek_cached(false, ch, vstart);
+  return ok;
+
+#undef CACHED_OFFSET
+}
+
 static
 qioerr _peek_number_unlocked(qio_channel_t* restrict ch, number_reading_state_t* restrict s, int64_t* restrict amount)
 {
@@ -1938,6 +2244,11 @@ qioerr _peek_number_unlocked(qio_channel_t* restrict ch, number_reading_state_t*
 
   mark_offset = qio_channel_offset_unlocked(ch);
 
+  if( _peek_number_cached(ch, s, mark_offset) ) {
+    *amount = s->end - mark_offset;
+    return 0;
+  }
+
   err = qio_channel_mark(false, ch);
   if( err ) return err;
 
@@ -3383,6 +3694,23 @@ qioerr qio_channel_skip_past_newline(const int threadsafe, qio_channel_t* restri
   }
 
   while( 1 ) {
+    if( ! skipOnlyWs && qio_glocale_utf8 > 0 ) {
+      // Skip any ASCII in the cached buffer window in bulk.
+      void* start;
+      void* end;
+      const uint8_t* stop;
+
+      err = qio_channel_begin_peek_cached(false, ch, &start, &end);
+      if( err ) break;
+      stop = start;
+      if( start ) stop = _qio_scan_find_stop(start, end, '\n', 0x80, 0);
+      if( stop != end && *stop == '\n' ) {
+        qio_channel_end_peek_cached(false, ch, qio_ptr_add((void*) stop, 1));
+        break;
+      }
+      qio_channel_end_peek_cached(false, ch, (void*) stop);
+    }
+
     lastpos = qio_channel_offset_unlocked(ch);
     err = qio_channel_read_char(threadsafe, ch, &c);
     if( err  || c == '\n' ) break;
@@ -3811,7 +4139,7 @@ qioerr _qio_channel_read_char_slow_unlocked(qio_channel_t* restrict ch, int32_t*
         // We always read 1 character at least.
         gotch = qio_channel_read_byte(false, ch);
         if( gotch < 0 ) {
-          err = qio_int_to_err(-got);
+          err = qio_int_to_err(-gotch);
           *chr = -1;
           break;
         }
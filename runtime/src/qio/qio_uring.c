@@ -0,0 +1,472 @@
+/*
+ * Copyright 2004-2019 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "sys_basic.h"
+
+#ifndef CHPL_RT_UNIT_TEST
+#include "chplrt.h"
+#endif
+
+#include "qio.h"
+#include "qbuffer.h"
+#include "sys.h"
+
+#include "qio_uring.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+// Only use io_uring if we can make the system calls and have the
+// kernel's definitions of the shared ring structures.
+#ifdef __linux__
+#include <sys/syscall.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#ifdef __has_include
+#if __has_include(<linux/io_uring.h>)
+#define QIO_HAS_IOURING 1
+#endif
+#endif
+#endif
+#endif
+
+#ifdef QIO_HAS_IOURING
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+
+// How many rings to share among all of the threads on this locale.
+// Each is protected by a lock, so more rings means less contention.
+#define QIO_URING_NUM_RINGS 4
+// How many submission queue entries each ring has.
+#define QIO_URING_ENTRIES 64
+// The most requests a single read or write will have in flight at once.
+// Larger transfers are split into this many requests of up to IOV_MAX
+// iovecs each; anything beyond that is returned as a short transfer.
+#define QIO_URING_MAX_BATCH 16
+
+typedef struct qio_uring_req_s {
+  int done;
+  int32_t res;
+} qio_uring_req_t;
+
+typedef struct qio_uring_s {
+  qio_lock_t lock;
+  int ring_fd;
+  // number of requests submitted but not yet reaped;
+  // kept <= cq_entries so that the completion queue cannot overflow.
+  unsigned in_flight;
+
+  unsigned* sq_head;
+  unsigned* sq_tail;
+  unsigned* sq_array;
+  unsigned sq_mask;
+  unsigned sq_entries;
+  struct io_uring_sqe* sqes;
+
+  unsigned* cq_head;
+  unsigned* cq_tail;
+  unsigned cq_mask;
+  unsigned cq_entries;
+  struct io_uring_cqe* cqes;
+} qio_uring_t;
+
+static qio_uring_t qio_urings[QIO_URING_NUM_RINGS];
+static int qio_num_urings = 0;
+static unsigned qio_uring_next = 0;
+static pthread_once_t qio_uring_once = PTHREAD_ONCE_INIT;
+
+static
+int uring_setup(qio_uring_t* r)
+{
+  struct io_uring_params p;
+  size_t sq_sz, cq_sz, sqes_sz;
+  char* sq_ptr = MAP_FAILED;
+  char* cq_ptr = MAP_FAILED;
+  void* sqes = MAP_FAILED;
+  int fd;
+
+  memset(&p, 0, sizeof(p));
+  fd = syscall(__NR_io_uring_setup, QIO_URING_ENTRIES, &p);
+  if( fd < 0 ) return errno;
+
+  sq_sz = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+  cq_sz = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+  sqes_sz = p.sq_entries * sizeof(struct io_uring_sqe);
+
+  sq_ptr = mmap(NULL, sq_sz, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE,
+                fd, IORING_OFF_SQ_RING);
+  if( sq_ptr == MAP_FAILED ) goto error;
+  cq_ptr = mmap(NULL, cq_sz, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE,
+                fd, IORING_OFF_CQ_RING);
+  if( cq_ptr == MAP_FAILED ) goto error;
+  sqes = mmap(NULL, sqes_sz, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE,
+              fd, IORING_OFF_SQES);
+  if( sqes == MAP_FAILED ) goto error;
+
+  if( qio_lock_init(&r->lock) ) goto error;
+
+  r->ring_fd = fd;
+  r->in_flight = 0;
+  r->sq_head = (unsigned*) (sq_ptr + p.sq_off.head);
+  r->sq_tail = (unsigned*) (sq_ptr + p.sq_off.tail);
+  r->sq_array = (unsigned*) (sq_ptr + p.sq_off.array);
+  r->sq_mask = *(unsigned*) (sq_ptr + p.sq_off.ring_mask);
+  r->sq_entries = p.sq_entries;
+  r->sqes = (struct io_uring_sqe*) sqes;
+  r->cq_head = (unsigned*) (cq_ptr + p.cq_off.head);
+  r->cq_tail = (unsigned*) (cq_ptr + p.cq_off.tail);
+  r->cq_mask = *(unsigned*) (cq_ptr + p.cq_off.ring_mask);
+  r->cq_entries = p.cq_entries;
+  r->cqes = (struct io_uring_cqe*) (cq_ptr + p.cq_off.cqes);
+
+  return 0;
+
+error:
+  {
+    int err = errno;
+    if( sqes != MAP_FAILED ) munmap(sqes, sqes_sz);
+    if( cq_ptr != MAP_FAILED ) munmap(cq_ptr, cq_sz);
+    if( sq_ptr != MAP_FAILED ) munmap(sq_ptr, sq_sz);
+    close(fd);
+    return err;
+  }
+}
+
+static
+void uring_init(void)
+{
+  int i;
+
+  // The rings live until the program exits.
+  for( i = 0; i < QIO_URING_NUM_RINGS; i++ ) {
+    if( uring_setup(&qio_urings[i]) ) break;
+  }
+  qio_num_urings = i;
+}
+
+static
+void uring_yield(void)
+{
+#ifndef CHPL_RT_UNIT_TEST
+  chpl_task_yield();
+#else
+  sched_yield();
+#endif
+}
+
+// Record results for any completed requests. Ring must be locked.
+static
+void uring_reap(qio_uring_t* r)
+{
+  unsigned head = *r->cq_head;
+  unsigned tail = __atomic_load_n(r->cq_tail, __ATOMIC_ACQUIRE);
+
+  while( head != tail ) {
+    struct io_uring_cqe* cqe = &r->cqes[head & r->cq_mask];
+    qio_uring_req_t* req = (qio_uring_req_t*) (uintptr_t) cqe->user_data;
+    req->res = cqe->res;
+    req->done = 1;
+    head++;
+    r->in_flight--;
+  }
+
+  __atomic_store_n(r->cq_head, head, __ATOMIC_RELEASE);
+}
+
+// Add a request to the submission queue. Ring must be locked
+// and have room for it.
+static
+void uring_prep(qio_uring_t* r, int is_write, fd_t fd,
+                const struct iovec* iov, int iovcnt, int64_t offset,
+                qio_uring_req_t* req)
+{
+  unsigned tail = *r->sq_tail;
+  unsigned idx = tail & r->sq_mask;
+  struct io_uring_sqe* sqe = &r->sqes[idx];
+
+  memset(sqe, 0, sizeof(*sqe));
+  sqe->opcode = is_write ? IORING_OP_WRITEV : IORING_OP_READV;
+  sqe->fd = fd;
+  sqe->off = offset;
+  sqe->addr = (uintptr_t) iov;
+  sqe->len = iovcnt;
+  sqe->user_data = (uintptr_t) req;
+  r->sq_array[idx] = idx;
+
+  req->done = 0;
+  req->res = 0;
+
+  __atomic_store_n(r->sq_tail, tail + 1, __ATOMIC_RELEASE);
+}
+
+static
+err_t uring_rw(int is_write, fd_t fd, const struct iovec* iov, int iovcnt,
+               int64_t offset, ssize_t* num_out)
+{
+  qio_uring_t* r;
+  qio_uring_req_t reqs[QIO_URING_MAX_BATCH];
+  int64_t lens[QIO_URING_MAX_BATCH];
+  int nreqs, submitted;
+  int i, done;
+  int64_t piece_offset;
+  ssize_t total;
+  err_t err;
+
+  *num_out = 0;
+  if( iovcnt <= 0 ) return 0;
+
+  r = &qio_urings[__atomic_fetch_add(&qio_uring_next, 1, __ATOMIC_RELAXED) %
+                  qio_num_urings];
+
+  nreqs = (iovcnt + IOV_MAX - 1) / IOV_MAX;
+  if( nreqs > QIO_URING_MAX_BATCH ) nreqs = QIO_URING_MAX_BATCH;
+
+  qio_lock(&r->lock);
+
+  // Wait for room in both queues, then submit the whole batch with
+  // a single system call.
+  while( r->in_flight + nreqs > r->cq_entries ||
+         r->sq_entries - (*r->sq_tail -
+                          __atomic_load_n(r->sq_head, __ATOMIC_ACQUIRE))
+           < (unsigned) nreqs ) {
+    uring_reap(r);
+    qio_unlock(&r->lock);
+    uring_yield();
+    qio_lock(&r->lock);
+  }
+
+  piece_offset = offset;
+  for( i = 0; i < nreqs; i++ ) {
+    int start = i * IOV_MAX;
+    int cnt = iovcnt - start;
+    if( cnt > IOV_MAX ) cnt = IOV_MAX;
+    lens[i] = sys_iov_total_bytes(&iov[start], cnt);
+    uring_prep(r, is_write, fd, &iov[start], cnt, piece_offset, &reqs[i]);
+    piece_offset += lens[i];
+  }
+  r->in_flight += nreqs;
+
+  // The kernel can consume fewer entries than we hand it, for
+  // instance when it runs short of memory, so keep submitting the
+  // rest.  We hold the lock throughout, so the entries it has not
+  // consumed are always the last ones we added.
+  submitted = 0;
+  while( submitted < nreqs ) {
+    long ret = syscall(__NR_io_uring_enter, r->ring_fd, nreqs - submitted,
+                       0, 0, NULL, 0);
+    if( ret > 0 ) {
+      submitted += ret;
+      continue;
+    }
+    if( ret < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY ) {
+      // Take back the requests the kernel has not seen. Any it has
+      // seen still use our iovecs, so wait for those below.
+      err = errno;
+      *r->sq_tail -= nreqs - submitted;
+      r->in_flight -= nreqs - submitted;
+      if( submitted == 0 ) {
+        qio_unlock(&r->lock);
+        return err;
+      }
+      for( i = submitted; i < nreqs; i++ ) {
+        reqs[i].done = 1;
+        reqs[i].res = -err;
+      }
+      break;
+    }
+    uring_reap(r);
+  }
+
+  // Yield until all of our requests have completed. Whichever task
+  // holds the lock records completions for everyone using this ring.
+  while( 1 ) {
+    uring_reap(r);
+    done = 1;
+    for( i = 0; i < nreqs; i++ ) done = done && reqs[i].done;
+    if( done ) break;
+
+    // Give the kernel a chance to post completions that are waiting
+    // on this thread, without blocking.
+    syscall(__NR_io_uring_enter, r->ring_fd, 0, 0,
+            IORING_ENTER_GETEVENTS, NULL, 0);
+    uring_reap(r);
+    done = 1;
+    for( i = 0; i < nreqs; i++ ) done = done && reqs[i].done;
+    if( done ) break;
+
+    qio_unlock(&r->lock);
+    uring_yield();
+    qio_lock(&r->lock);
+  }
+
+  qio_unlock(&r->lock);
+
+  // Report only the bytes transferred before the first short
+  // or failed request, as preadv/pwritev would.
+  err = 0;
+  total = 0;
+  for( i = 0; i < nreqs; i++ ) {
+    if( reqs[i].res < 0 ) {
+      err = -reqs[i].res;
+      break;
+    }
+    total += reqs[i].res;
+    if( reqs[i].res != lens[i] ) break;
+  }
+
+  if( total > 0 ) err = 0;
+  if( ! is_write && err == 0 && total == 0 &&
+      sys_iov_total_bytes(iov, iovcnt) != 0 ) err = EEOF;
+
+  *num_out = total;
+  return err;
+}
+
+int qio_uring_available(void)
+{
+  pthread_once(&qio_uring_once, uring_init);
+  return qio_num_urings > 0;
+}
+
+#else
+
+int qio_uring_available(void)
+{
+  return 0;
+}
+
+static
+err_t uring_rw(int is_write, fd_t fd, const struct iovec* iov, int iovcnt,
+               int64_t offset, ssize_t* num_out)
+{
+  // Not reached; callers check qio_uring_available() first.
+  *num_out = 0;
+  return ENOSYS;
+}
+
+#endif
+
+qioerr qio_uring_preadv(qio_file_t* file, qbuffer_t* buf, qbuffer_iter_t start, qbuffer_iter_t end, int64_t seek_to_offset, ssize_t* num_read)
+{
+  ssize_t nread = 0;
+  int64_t num_bytes = qbuffer_iter_num_bytes(start, end);
+  ssize_t num_parts = qbuffer_iter_num_parts(start, end);
+  struct iovec* iov = NULL;
+  size_t iovcnt;
+  MAYBE_STACK_SPACE(struct iovec, iov_onstack);
+  qioerr err;
+
+  if( file->fd == -1 || ! qio_uring_available() ) {
+    return qio_preadv(file, buf, start, end, seek_to_offset, num_read);
+  }
+
+  if( num_bytes < 0 || num_parts < 0 || num_parts > INT_MAX ) {
+    QIO_RETURN_CONSTANT_ERROR(EINVAL, "negative count");
+  }
+
+  MAYBE_STACK_ALLOC(struct iovec, num_parts, iov, iov_onstack);
+  if( ! iov ) {
+    err = QIO_ENOMEM;
+    goto error;
+  }
+
+  err = qbuffer_to_iov(buf, start, end, num_parts, iov, NULL, &iovcnt);
+  if( err ) goto error;
+
+  err = qio_int_to_err(uring_rw(0, file->fd, iov, iovcnt, seek_to_offset, &nread));
+
+error:
+  MAYBE_STACK_FREE(iov, iov_onstack);
+
+  *num_read = nread;
+
+  return err;
+}
+
+qioerr qio_uring_pwritev(qio_file_t* file, qbuffer_t* buf, qbuffer_iter_t start, qbuffer_iter_t end, int64_t seek_to_offset, ssize_t* num_written)
+{
+  ssize_t nwritten = 0;
+  int64_t num_bytes = qbuffer_iter_num_bytes(start, end);
+  ssize_t num_parts = qbuffer_iter_num_parts(start, end);
+  struct iovec* iov = NULL;
+  size_t iovcnt;
+  MAYBE_STACK_SPACE(struct iovec, iov_onstack);
+  qioerr err;
+
+  if( file->fd == -1 || ! qio_uring_available() ) {
+    return qio_pwritev(file, buf, start, end, seek_to_offset, num_written);
+  }
+
+  if( num_bytes < 0 || num_parts < 0 || num_parts > INT_MAX ) {
+    QIO_RETURN_CONSTANT_ERROR(EINVAL, "negative count");
+  }
+
+  MAYBE_STACK_ALLOC(struct iovec, num_parts, iov, iov_onstack);
+  if( ! iov ) {
+    err = QIO_ENOMEM;
+    goto error;
+  }
+
+  err = qbuffer_to_iov(buf, start, end, num_parts, iov, NULL, &iovcnt);
+  if( err ) goto error;
+
+  err = qio_int_to_err(uring_rw(1, file->fd, iov, iovcnt, seek_to_offset, &nwritten));
+
+error:
+  MAYBE_STACK_FREE(iov, iov_onstack);
+
+  *num_written = nwritten;
+
+  return err;
+}
+
+qioerr qio_uring_pread(fd_t fd, void* buf, size_t count, off_t offset, ssize_t* num_read)
+{
+  struct iovec iov;
+
+  if( ! qio_uring_available() ) {
+    return qio_int_to_err(sys_pread(fd, buf, count, offset, num_read));
+  }
+
+  iov.iov_base = buf;
+  iov.iov_len = count;
+  return qio_int_to_err(uring_rw(0, fd, &iov, 1, offset, num_read));
+}
+
+qioerr qio_uring_pwrite(fd_t fd, const void* buf, size_t count, off_t offset, ssize_t* num_written)
+{
+  struct iovec iov;
+
+  if( ! qio_uring_available() ) {
+    return qio_int_to_err(sys_pwrite(fd, buf, count, offset, num_written));
+  }
+
+  iov.iov_base = (void*) buf;
+  iov.iov_len = count;
+  return qio_int_to_err(uring_rw(1, fd, &iov, 1, offset, num_written));
+}
@@ -24,7 +24,9 @@
 #include "chplrt.h"
 #include "chpl_rt_utils_static.h"
 #include "chplcgfns.h"
+#include "chpl-atomics.h"
 #include "chpl-comm.h"
+#include "chpl-env.h"
 #include "chplexit.h"
 #include "chpl-locale-model.h"
 #include "chpl-mem.h"
@@ -61,6 +63,9 @@ typedef struct task_pool_struct {
   task_pool_p      next;         // double-link pointers for pool
   task_pool_p      prev;
 
+  atomic_bool          claimed;  // work stealing: some thread will run it
+  atomic_int_least32_t refs;     // work stealing: deque/pool + list refs
+
   chpl_task_prvDataImpl_t chpl_data;
 
   chpl_task_bundle_t bundle; // ends in a variable-length array
@@ -76,10 +81,29 @@ typedef struct lockReport {
 } lockReport_t;
 
 
+//
+// Work stealing deque (Chase and Lev, "Dynamic Circular Work-Stealing
+// Deque", SPAA 2005, with the C11 orderings of Le et al., PPoPP 2013).
+// The owning thread pushes and pops at the bottom; other threads steal
+// from the top.  The size is fixed: when a deque is full, new tasks go
+// to the shared task pool instead.
+//
+#define WS_DEQUE_SIZE 4096
+
+typedef struct {
+  atomic_int_least64_t top;
+  atomic_int_least64_t bottom;
+  atomic_uintptr_t     tasks[WS_DEQUE_SIZE];
+} ws_deque_t;
+
+
 // This is the data that is private to each thread.
 typedef struct {
   task_pool_p   ptask;
   lockReport_t* lockRprt;
+  ws_deque_t*   deque;          // work stealing: this thread's deque
+  chpl_bool     deque_tried;    // work stealing: tried to get a deque
+  uint32_t      steal_seed;     // work stealing: victim selection
 } thread_private_data_t;
 
 
@@ -94,12 +118,14 @@ static volatile task_pool_p
 static volatile task_pool_p
                            task_pool_tail;     // tail of task pool
 
-static int                 queued_task_cnt;    // number of tasks in task pool
+static atomic_int_least32_t
+                           queued_task_cnt;    // number of tasks in task pool
 static int64_t             extra_task_cnt;     // number of tasks being run by
                                                //   threads occupied already
 static int                 blocked_thread_cnt; // number of threads that
                                                //   cannot make progress
-static int                 idle_thread_cnt;    // number of threads looking
+static atomic_int_least32_t
+                           idle_thread_cnt;    // number of threads looking
                                                //   for work
 static uint64_t            progress_cnt;       // number of unblock operations,
                                                //   as a proxy for progress
@@ -113,6 +139,43 @@ static chpl_thread_mutex_t taskTable_lock;     // critical section lock
 
 static chpl_fn_p comm_task_fn;
 
+//
+// Work stealing mode.  When CHPL_RT_FIFO_WORK_STEALING is set, a thread
+// that creates a task pushes it on its own deque rather than appending
+// it to the shared pool, and runs the most recently created task it
+// has when it finishes one.  Idle threads steal the oldest tasks from
+// the deques of randomly chosen other threads, and park on a condition
+// variable when none can be found.  The shared pool is still used by
+// threads without deques and for overflow.
+//
+// A task that is on a task list (for cobegin/coforall) can be started
+// either by a thread that takes it from a deque or the pool, or by the
+// task that owns the list, in chpl_task_executeTasksInList().  Since it
+// cannot be removed from the middle of a deque, the first of these to
+// set the task's 'claimed' flag runs it and the other just drops its
+// reference.  Each task has one reference for the deque or pool it is
+// on and one more for its task list, if any; it is freed when the last
+// of these is dropped.  Task lists are protected by a set of locks
+// selected by the list head address.
+//
+static chpl_bool ws_mode = false;
+
+static atomic_uintptr_t*   ws_deques;          // all deques, for stealing
+static int32_t             ws_max_deques;
+static atomic_int_least32_t
+                           ws_num_deques;
+
+#define WS_NUM_LIST_LOCKS 64
+static chpl_thread_mutex_t ws_list_locks[WS_NUM_LIST_LOCKS];
+
+#define WS_SPINS_BEFORE_PARK 64
+#define WS_PARK_USECS 100000
+static chpl_thread_mutex_t ws_park_lock;
+static chpl_thread_condvar_t
+                           ws_park_cond;
+static atomic_int_least32_t
+                           ws_parked_cnt;      // number of parked threads
+
 //
 // Internal functions.
 //
@@ -141,6 +204,11 @@ static task_pool_p             add_to_task_pool(chpl_fn_int_t, chpl_fn_p,
                                                 chpl_task_bundle_t*, size_t,
                                                 chpl_bool, task_pool_p*,
                                                 chpl_bool, int, int32_t);
+static void                    ws_init(void);
+static void                    ws_enqueue_task(task_pool_p, task_pool_p*);
+static task_pool_p             ws_take_from_list(task_pool_p*);
+static task_pool_p             ws_wait_for_task(void);
+static void                    ws_release_task(task_pool_p);
 
 //
 // Condition variable methods
@@ -333,14 +401,17 @@ void chpl_task_init(void) {
   chpl_thread_mutexInit(&extra_task_lock);
   chpl_thread_mutexInit(&task_id_lock);
   chpl_thread_mutexInit(&task_list_lock);
-  queued_task_cnt = 0;
+  atomic_init_int_least32_t(&queued_task_cnt, 0);
   blocked_thread_cnt = 0;
-  idle_thread_cnt = 0;
+  atomic_init_int_least32_t(&idle_thread_cnt, 0);
   extra_task_cnt = 0;
   task_pool_head = task_pool_tail = NULL;
 
   chpl_thread_init(thread_begin, thread_end);
 
+  if (chpl_env_rt_get_bool("FIFO_WORK_STEALING", false))
+    ws_init();
+
   //
   // Set main thread private data, so that things that require access
   // to it, like chpl_task_getID() and chpl_task_setSerial(), can be
@@ -517,47 +588,23 @@ static void comm_task_wrapper(void* arg) {
 
 
 //
-// Enqueue and dequeue tasks from the pool.
+// Add tasks to and remove them from the pool and task lists.  The
+// caller holds the lock protecting the pool or list.
 //
 static inline
-void enqueue_task(task_pool_p ptask, task_pool_p* p_task_list_head) {
-  queued_task_cnt++;
-
-  //
-  // Add to pool.
-  //
+void add_to_pool(task_pool_p ptask) {
+  ptask->next = NULL;
   if (task_pool_tail)
     task_pool_tail->next = ptask;
   else
     task_pool_head = ptask;
   ptask->prev = task_pool_tail;
   task_pool_tail = ptask;
-
-  //
-  // Add to list, if any.
-  //
-  if (p_task_list_head == NULL) {
-    ptask->p_list_head = NULL;
-  }
-  else {
-    ptask->p_list_head = p_task_list_head;
-    ptask->list_next = *p_task_list_head;
-    if (*p_task_list_head != NULL)
-      (*p_task_list_head)->list_prev = ptask;
-    ptask->list_prev = NULL;
-    *p_task_list_head = ptask;
-  }
 }
 
 
 static inline
-void dequeue_task(task_pool_p ptask) {
-  assert(queued_task_cnt > 0);
-  queued_task_cnt--;
-
-  //
-  // Remove from pool.
-  //
+void remove_from_pool(task_pool_p ptask) {
   if (ptask == task_pool_head) {
     if ((task_pool_head = task_pool_head->next) == NULL)
       task_pool_tail = NULL;
@@ -570,10 +617,27 @@ void dequeue_task(task_pool_p ptask) {
     else
       ptask->next->prev = ptask->prev;
   }
+}
 
-  //
-  // Remove from list, if on one.
-  //
+
+static inline
+void add_to_list(task_pool_p ptask, task_pool_p* p_task_list_head) {
+  if (p_task_list_head == NULL) {
+    ptask->p_list_head = NULL;
+  }
+  else {
+    ptask->p_list_head = p_task_list_head;
+    ptask->list_next = *p_task_list_head;
+    if (*p_task_list_head != NULL)
+      (*p_task_list_head)->list_prev = ptask;
+    ptask->list_prev = NULL;
+    *p_task_list_head = ptask;
+  }
+}
+
+
+static inline
+void remove_from_list(task_pool_p ptask) {
   if (ptask->p_list_head != NULL) {
     if (ptask == *(ptask->p_list_head))
       *(ptask->p_list_head) = ptask->list_next;
@@ -585,6 +649,28 @@ void dequeue_task(task_pool_p ptask) {
 }
 
 
+//
+// Enqueue and dequeue tasks from the pool.
+//
+static inline
+void enqueue_task(task_pool_p ptask, task_pool_p* p_task_list_head) {
+  (void) atomic_fetch_add_int_least32_t(&queued_task_cnt, 1);
+
+  add_to_pool(ptask);
+  add_to_list(ptask, p_task_list_head);
+}
+
+
+static inline
+void dequeue_task(task_pool_p ptask) {
+  assert(atomic_load_int_least32_t(&queued_task_cnt) > 0);
+  (void) atomic_fetch_sub_int_least32_t(&queued_task_cnt, 1);
+
+  remove_from_pool(ptask);
+  remove_from_list(ptask);
+}
+
+
 void chpl_task_addToTaskList(chpl_fn_int_t fid,
                              chpl_task_bundle_t* arg, size_t arg_size,
                              c_sublocid_t subloc,
@@ -596,7 +682,8 @@ void chpl_task_addToTaskList(chpl_fn_int_t fid,
   assert(subloc == c_sublocid_any);
 
   // begin critical section
-  chpl_thread_mutexLock(&threading_lock);
+  if (!ws_mode)
+    chpl_thread_mutexLock(&threading_lock);
 
   if (task_list_locale == chpl_nodeID) {
     (void) add_to_task_pool(fid, chpl_ftable[fid], arg, arg_size,
@@ -616,7 +703,8 @@ void chpl_task_addToTaskList(chpl_fn_int_t fid,
   }
 
   // end critical section
-  chpl_thread_mutexUnlock(&threading_lock);
+  if (!ws_mode)
+    chpl_thread_mutexUnlock(&threading_lock);
 }
 
 
@@ -633,16 +721,26 @@ void chpl_task_executeTasksInList(void** p_task_list_void) {
   while (*p_task_list_head != NULL) {
     chpl_fn_p task_to_run_fun = NULL;
 
-    // begin critical section
-    chpl_thread_mutexLock(&threading_lock);
-
-    if ((child_ptask = *p_task_list_head) != NULL) {
+    if (ws_mode) {
+      if ((child_ptask = ws_take_from_list(p_task_list_head)) == NULL) {
+        // The rest are being started elsewhere; wait for them to go.
+        chpl_thread_yield();
+        continue;
+      }
       task_to_run_fun = child_ptask->bundle.requested_fn;
-      dequeue_task(child_ptask);
     }
+    else {
+      // begin critical section
+      chpl_thread_mutexLock(&threading_lock);
 
-    // end critical section
-    chpl_thread_mutexUnlock(&threading_lock);
+      if ((child_ptask = *p_task_list_head) != NULL) {
+        task_to_run_fun = child_ptask->bundle.requested_fn;
+        dequeue_task(child_ptask);
+      }
+
+      // end critical section
+      chpl_thread_mutexUnlock(&threading_lock);
+    }
 
     if (task_to_run_fun == NULL)
       continue;
@@ -699,7 +797,10 @@ void chpl_task_executeTasksInList(void** p_task_list_void) {
     chpl_thread_mutexUnlock(&extra_task_lock);
 
     set_current_ptask(curr_ptask);
-    chpl_mem_free(child_ptask, 0, 0);
+    if (ws_mode)
+      ws_release_task(child_ptask);
+    else
+      chpl_mem_free(child_ptask, 0, 0);
 
   }
 }
@@ -719,13 +820,15 @@ void taskCallBody(chpl_fn_int_t fid, chpl_fn_p fp,
                   c_sublocid_t subloc,
                   int lineno, int32_t filename) {
   // begin critical section
-  chpl_thread_mutexLock(&threading_lock);
+  if (!ws_mode)
+    chpl_thread_mutexLock(&threading_lock);
 
   (void) add_to_task_pool(fid, fp, arg, arg_size, true,
                           NULL, false, lineno, filename);
 
   // end critical section
-  chpl_thread_mutexUnlock(&threading_lock);
+  if (!ws_mode)
+    chpl_thread_mutexUnlock(&threading_lock);
 }
 
 
@@ -847,7 +950,7 @@ size_t chpl_task_getCallStackSize(void) {
 }
 
 uint32_t chpl_task_getNumQueuedTasks(void) {
-  return queued_task_cnt;
+  return atomic_load_int_least32_t(&queued_task_cnt);
 }
 
 int32_t chpl_task_getNumBlockedTasks(void) {
@@ -858,7 +961,8 @@ int32_t chpl_task_getNumBlockedTasks(void) {
     chpl_thread_mutexLock(&threading_lock);
     chpl_thread_mutexLock(&block_report_lock);
 
-    numBlockedTasks = blocked_thread_cnt - idle_thread_cnt;
+    numBlockedTasks = blocked_thread_cnt
+                      - atomic_load_int_least32_t(&idle_thread_cnt);
 
     // end critical section
     chpl_thread_mutexUnlock(&block_report_lock);
@@ -951,6 +1055,13 @@ static void report_locked_threads(void) {
 // This signal handler prints an overall task report, containing
 // pending tasks and those that are running.
 //
+static void report_pending_task(task_pool_p pendingTask) {
+  if (ws_mode && atomic_load_bool(&pendingTask->claimed))
+    return;
+  printf("- %s:%d\n", chpl_lookupFilename(pendingTask->bundle.filename),
+         pendingTask->bundle.lineno);
+}
+
 static void report_all_tasks(void) {
   task_pool_p pendingTask = task_pool_head;
 
@@ -960,10 +1071,34 @@ static void report_all_tasks(void) {
   // print out pending tasks
   printf("Pending tasks:\n");
   while (pendingTask != NULL) {
-    printf("- %s:%d\n", chpl_lookupFilename(pendingTask->bundle.filename),
-           pendingTask->bundle.lineno);
+    report_pending_task(pendingTask);
     pendingTask = pendingTask->next;
   }
+  if (ws_mode) {
+    //
+    // Tasks on the deques can be stolen, run, and freed while we look,
+    // so we can't safely print them.  Just say how many there are.
+    //
+    int32_t num_deques = atomic_load_int_least32_t(&ws_num_deques);
+    int64_t num_tasks = 0;
+    int32_t i;
+
+    if (num_deques > ws_max_deques)
+      num_deques = ws_max_deques;
+    for (i = 0; i < num_deques; i++) {
+      ws_deque_t* d = (ws_deque_t*) atomic_load_uintptr_t(&ws_deques[i]);
+      int64_t t, b;
+
+      if (d == NULL)
+        continue;
+      t = atomic_load_int_least64_t(&d->top);
+      b = atomic_load_int_least64_t(&d->bottom);
+      if (b > t)
+        num_tasks += b - t;
+    }
+    if (num_tasks > 0)
+      printf("- up to %" PRId64 " more in work-stealing deques\n", num_tasks);
+  }
   printf("\n");
 
   // print out running tasks
@@ -1110,23 +1245,11 @@ static void check_for_deadlock(void) {
 
 
 //
-// When we create a thread it runs this wrapper function, which just
-// executes tasks out of the pool as they become available.
+// Wait for a task to appear in the shared pool, take it out, and
+// return it.
 //
-static void
-thread_begin(void* ptask_void) {
+static task_pool_p fifo_wait_for_task(void) {
   task_pool_p ptask;
-  thread_private_data_t *tp;
-
-  tp = (thread_private_data_t*) chpl_mem_alloc(sizeof(thread_private_data_t),
-                                               CHPL_RT_MD_THREAD_PRV_DATA,
-                                               0, 0);
-  chpl_thread_setPrivateData(tp);
-
-  tp->ptask = NULL;
-  tp->lockRprt = NULL;
-  if (blockreport)
-    initializeLockReportForThread();
 
   while (true) {
     //
@@ -1193,13 +1316,51 @@ thread_begin(void* ptask_void) {
     // for task-reports on deadlock or Ctrl+C).
     //
     ptask = task_pool_head;
-    idle_thread_cnt--;
+    (void) atomic_fetch_sub_int_least32_t(&idle_thread_cnt, 1);
 
     dequeue_task(ptask);
 
     // end critical section
     chpl_thread_mutexUnlock(&threading_lock);
 
+    return ptask;
+  }
+}
+
+
+//
+// When we create a thread it runs this wrapper function, which just
+// executes tasks out of the pool as they become available.
+//
+static void
+thread_begin(void* ptask_void) {
+  task_pool_p ptask;
+  thread_private_data_t *tp;
+
+  tp = (thread_private_data_t*) chpl_mem_alloc(sizeof(thread_private_data_t),
+                                               CHPL_RT_MD_THREAD_PRV_DATA,
+                                               0, 0);
+  chpl_thread_setPrivateData(tp);
+
+  tp->ptask = NULL;
+  tp->lockRprt = NULL;
+  tp->deque = NULL;
+  tp->deque_tried = false;
+  tp->steal_seed = (uint32_t) (intptr_t) tp | 1;
+  if (blockreport)
+    initializeLockReportForThread();
+
+  while (true) {
+    if (ws_mode) {
+      ptask = ws_wait_for_task();
+      if (blockreport)
+        progress_cnt++;
+      (void) atomic_fetch_sub_int_least32_t(&idle_thread_cnt, 1);
+    }
+    else {
+      ptask = fifo_wait_for_task();
+    }
+
     tp->ptask = ptask;
 
     if (do_taskReport) {
@@ -1231,18 +1392,25 @@ thread_begin(void* ptask_void) {
     }
 
     tp->ptask = NULL;
-    chpl_mem_free(ptask, 0, 0);
 
-    // begin critical section
-    chpl_thread_mutexLock(&threading_lock);
+    if (ws_mode) {
+      ws_release_task(ptask);
+      (void) atomic_fetch_add_int_least32_t(&idle_thread_cnt, 1);
+    }
+    else {
+      chpl_mem_free(ptask, 0, 0);
 
-    //
-    // finished task; increment idle count
-    //
-    idle_thread_cnt++;
+      // begin critical section
+      chpl_thread_mutexLock(&threading_lock);
 
-    // end critical section
-    chpl_thread_mutexUnlock(&threading_lock);
+      //
+      // finished task; increment idle count
+      //
+      (void) atomic_fetch_add_int_least32_t(&idle_thread_cnt, 1);
+
+      // end critical section
+      chpl_thread_mutexUnlock(&threading_lock);
+    }
   }
 }
 
@@ -1274,7 +1442,7 @@ static void maybe_add_thread(void) {
 
   if (!warning_issued && chpl_thread_canCreate()) {
     if (chpl_thread_create(NULL) == 0) {
-      idle_thread_cnt++;
+      (void) atomic_fetch_add_int_least32_t(&idle_thread_cnt, 1);
     }
     else {
       int32_t max_threads = chpl_thread_getMaxThreads();
@@ -1299,7 +1467,8 @@ static void maybe_add_thread(void) {
 
 // create a task from the given function pointer and arguments
 // and append it to the end of the task pool
-// assumes threading_lock has already been acquired!
+// assumes threading_lock has already been acquired, unless in work
+// stealing mode!
 static inline
 task_pool_p add_to_task_pool(chpl_fn_int_t fid, chpl_fn_p fp,
                              chpl_task_bundle_t* a, size_t a_size,
@@ -1338,8 +1507,10 @@ task_pool_p add_to_task_pool(chpl_fn_int_t fid, chpl_fn_p fp,
   ptask->bundle.requested_fn    = fp;
   ptask->bundle.id              = get_next_task_id();
 
-  enqueue_task(ptask, p_task_list_head);
-
+  //
+  // In work-stealing mode the task can be stolen, run, and freed as
+  // soon as it's enqueued, so do everything that refers to it first.
+  //
   chpl_task_do_callbacks(chpl_task_cb_event_kind_create,
                          ptask->bundle.requested_fid,
                          ptask->bundle.filename,
@@ -1355,12 +1526,426 @@ task_pool_p add_to_task_pool(chpl_fn_int_t fid, chpl_fn_p fp,
     chpl_thread_mutexUnlock(&taskTable_lock);
   }
 
+  if (ws_mode)
+    ws_enqueue_task(ptask, p_task_list_head);
+  else
+    enqueue_task(ptask, p_task_list_head);
+
   // If we now have more tasks than threads to run them on, try to start
   // another thread
-  if (queued_task_cnt > idle_thread_cnt) {
-    maybe_add_thread();
+  if (atomic_load_int_least32_t(&queued_task_cnt)
+      > atomic_load_int_least32_t(&idle_thread_cnt)) {
+    if (ws_mode) {
+      chpl_thread_mutexLock(&threading_lock);
+      maybe_add_thread();
+      chpl_thread_mutexUnlock(&threading_lock);
+    }
+    else {
+      maybe_add_thread();
+    }
+  }
+
+  return ptask;
+}
+
+
+// Work stealing
+
+static void ws_init(void) {
+  int32_t max_threads;
+  int32_t i;
+
+  //
+  // There can be a deque for every thread we create, plus the main
+  // and comm threads and a few others that might create tasks.  Any
+  // beyond that just use the shared pool.
+  //
+  max_threads = chpl_thread_getMaxThreads();
+  ws_max_deques = ((max_threads > 0) ? max_threads : 1024) + 4;
+  ws_deques = (atomic_uintptr_t*)
+              chpl_mem_alloc(ws_max_deques * sizeof(ws_deques[0]),
+                             CHPL_RT_MD_TASK_POOL_DESC, 0, 0);
+  for (i = 0; i < ws_max_deques; i++)
+    atomic_init_uintptr_t(&ws_deques[i], (uintptr_t) NULL);
+  atomic_init_int_least32_t(&ws_num_deques, 0);
+
+  for (i = 0; i < WS_NUM_LIST_LOCKS; i++)
+    chpl_thread_mutexInit(&ws_list_locks[i]);
+
+  chpl_thread_mutexInit(&ws_park_lock);
+  chpl_thread_condvar_init(&ws_park_cond);
+  atomic_init_int_least32_t(&ws_parked_cnt, 0);
+
+  ws_mode = true;
+}
+
+
+//
+// Get the calling thread's deque, creating it if this is the first
+// time.  Returns NULL if the thread doesn't have one.
+//
+static ws_deque_t* ws_get_my_deque(void) {
+  thread_private_data_t* tp;
+
+  tp = (thread_private_data_t*) chpl_thread_getPrivateData();
+  if (tp == NULL)
+    return NULL;
+
+  if (tp->deque == NULL && !tp->deque_tried) {
+    int32_t i;
+
+    tp->deque_tried = true;
+    i = atomic_fetch_add_int_least32_t(&ws_num_deques, 1);
+    if (i < ws_max_deques) {
+      ws_deque_t* d;
+      int j;
+
+      d = (ws_deque_t*) chpl_mem_alloc(sizeof(ws_deque_t),
+                                       CHPL_RT_MD_TASK_POOL_DESC, 0, 0);
+      atomic_init_int_least64_t(&d->top, 0);
+      atomic_init_int_least64_t(&d->bottom, 0);
+      for (j = 0; j < WS_DEQUE_SIZE; j++)
+        atomic_init_uintptr_t(&d->tasks[j], (uintptr_t) NULL);
+      atomic_store_uintptr_t(&ws_deques[i], (uintptr_t) d);
+      tp->deque = d;
+    }
+  }
+
+  return tp->deque;
+}
+
+
+//
+// Push a task on the bottom of our own deque.  Returns false if the
+// deque is full.
+//
+static chpl_bool ws_deque_push(ws_deque_t* d, task_pool_p ptask) {
+  int64_t b = atomic_load_explicit_int_least64_t(&d->bottom,
+                                                 memory_order_relaxed);
+  int64_t t = atomic_load_explicit_int_least64_t(&d->top,
+                                                 memory_order_acquire);
+
+  if (b - t >= WS_DEQUE_SIZE)
+    return false;
+
+  atomic_store_explicit_uintptr_t(&d->tasks[b % WS_DEQUE_SIZE],
+                                  (uintptr_t) ptask, memory_order_relaxed);
+  chpl_atomic_thread_fence(memory_order_release);
+  atomic_store_explicit_int_least64_t(&d->bottom, b + 1,
+                                      memory_order_relaxed);
+  return true;
+}
+
+
+//
+// Pop the most recently pushed task from the bottom of our own deque.
+//
+static task_pool_p ws_deque_pop(ws_deque_t* d) {
+  int64_t b = atomic_load_explicit_int_least64_t(&d->bottom,
+                                                 memory_order_relaxed) - 1;
+  int64_t t;
+  task_pool_p ptask;
+
+  atomic_store_explicit_int_least64_t(&d->bottom, b, memory_order_relaxed);
+  chpl_atomic_thread_fence(memory_order_seq_cst);
+  t = atomic_load_explicit_int_least64_t(&d->top, memory_order_relaxed);
+
+  if (t > b) {
+    // empty
+    atomic_store_explicit_int_least64_t(&d->bottom, b + 1,
+                                        memory_order_relaxed);
+    return NULL;
+  }
+
+  ptask = (task_pool_p)
+          atomic_load_explicit_uintptr_t(&d->tasks[b % WS_DEQUE_SIZE],
+                                         memory_order_relaxed);
+  if (t == b) {
+    // last one; race any thieves for it
+    if (!atomic_compare_exchange_strong_explicit_int_least64_t(
+           &d->top, t, t + 1, memory_order_seq_cst))
+      ptask = NULL;
+    atomic_store_explicit_int_least64_t(&d->bottom, b + 1,
+                                        memory_order_relaxed);
+  }
+
+  return ptask;
+}
+
+
+//
+// Steal the oldest task from the top of another thread's deque.
+// Returns NULL if it is empty or another thread got there first.
+//
+static task_pool_p ws_deque_steal(ws_deque_t* d) {
+  int64_t t = atomic_load_explicit_int_least64_t(&d->top,
+                                                 memory_order_acquire);
+  int64_t b;
+  task_pool_p ptask;
+
+  chpl_atomic_thread_fence(memory_order_seq_cst);
+  b = atomic_load_explicit_int_least64_t(&d->bottom, memory_order_acquire);
+  if (t >= b)
+    return NULL;
+
+  ptask = (task_pool_p)
+          atomic_load_explicit_uintptr_t(&d->tasks[t % WS_DEQUE_SIZE],
+                                         memory_order_relaxed);
+  if (!atomic_compare_exchange_strong_explicit_int_least64_t(
+         &d->top, t, t + 1, memory_order_seq_cst))
+    return NULL;
+
+  return ptask;
+}
+
+
+static inline
+chpl_thread_mutex_t* ws_list_lock(task_pool_p* p_task_list_head) {
+  return &ws_list_locks[((uintptr_t) p_task_list_head >> 3)
+                        % WS_NUM_LIST_LOCKS];
+}
+
+
+//
+// Claim a task for running.  Only the first claim of a task succeeds.
+//
+static inline
+chpl_bool ws_claim_task(task_pool_p ptask) {
+  if (atomic_exchange_bool(&ptask->claimed, true))
+    return false;
+  (void) atomic_fetch_sub_int_least32_t(&queued_task_cnt, 1);
+  return true;
+}
+
+
+static void ws_release_task(task_pool_p ptask) {
+  if (atomic_fetch_sub_int_least32_t(&ptask->refs, 1) == 1)
+    chpl_mem_free(ptask, 0, 0);
+}
+
+
+static void ws_enqueue_task(task_pool_p ptask,
+                            task_pool_p* p_task_list_head) {
+  ws_deque_t* d;
+
+  atomic_init_bool(&ptask->claimed, false);
+  atomic_init_int_least32_t(&ptask->refs,
+                            (p_task_list_head == NULL) ? 1 : 2);
+
+  //
+  // The task has to be on its list before anyone can find it to run.
+  //
+  if (p_task_list_head == NULL) {
+    ptask->p_list_head = NULL;
+  }
+  else {
+    chpl_thread_mutex_t* lock = ws_list_lock(p_task_list_head);
+
+    chpl_thread_mutexLock(lock);
+    add_to_list(ptask, p_task_list_head);
+    chpl_thread_mutexUnlock(lock);
+  }
+
+  (void) atomic_fetch_add_int_least32_t(&queued_task_cnt, 1);
+
+  if ((d = ws_get_my_deque()) == NULL || !ws_deque_push(d, ptask)) {
+    chpl_thread_mutexLock(&threading_lock);
+    add_to_pool(ptask);
+    chpl_thread_mutexUnlock(&threading_lock);
+  }
+
+  if (atomic_load_int_least32_t(&ws_parked_cnt) > 0) {
+    chpl_thread_mutexLock(&ws_park_lock);
+    (void) pthread_cond_signal(&ws_park_cond);
+    chpl_thread_mutexUnlock(&ws_park_lock);
+  }
+}
+
+
+//
+// Claim and remove a task from a task list, for the list's owner to
+// run.  Returns NULL if all the tasks on the list have been claimed by
+// other threads, which will remove them shortly.
+//
+static task_pool_p ws_take_from_list(task_pool_p* p_task_list_head) {
+  chpl_thread_mutex_t* lock = ws_list_lock(p_task_list_head);
+  task_pool_p ptask;
+
+  chpl_thread_mutexLock(lock);
+  for (ptask = *p_task_list_head; ptask != NULL; ptask = ptask->list_next) {
+    if (ws_claim_task(ptask)) {
+      remove_from_list(ptask);
+      break;
+    }
+  }
+  chpl_thread_mutexUnlock(lock);
+
+  return ptask;
+}
+
+
+//
+// Remove a task we've claimed from its task list, if it's on one.
+//
+static void ws_unlist_task(task_pool_p ptask) {
+  if (ptask->p_list_head != NULL) {
+    chpl_thread_mutex_t* lock = ws_list_lock(ptask->p_list_head);
+
+    chpl_thread_mutexLock(lock);
+    remove_from_list(ptask);
+    chpl_thread_mutexUnlock(lock);
+    ws_release_task(ptask);
+  }
+}
+
+
+static task_pool_p ws_take_from_pool(void) {
+  task_pool_p ptask;
+
+  chpl_thread_mutexLock(&threading_lock);
+  if ((ptask = task_pool_head) != NULL)
+    remove_from_pool(ptask);
+  chpl_thread_mutexUnlock(&threading_lock);
+
+  return ptask;
+}
+
+
+//
+// Try each of the other threads' deques once, starting at a random one.
+//
+static task_pool_p ws_steal(thread_private_data_t* tp) {
+  int32_t num_deques = atomic_load_int_least32_t(&ws_num_deques);
+  int32_t start;
+  int32_t i;
+
+  if (num_deques > ws_max_deques)
+    num_deques = ws_max_deques;
+  if (num_deques == 0)
+    return NULL;
+
+  // xorshift32
+  if (tp->steal_seed == 0)
+    tp->steal_seed = (uint32_t) (intptr_t) tp | 1;
+  tp->steal_seed ^= tp->steal_seed << 13;
+  tp->steal_seed ^= tp->steal_seed >> 17;
+  tp->steal_seed ^= tp->steal_seed << 5;
+  start = tp->steal_seed % num_deques;
+
+  for (i = 0; i < num_deques; i++) {
+    ws_deque_t* d;
+    task_pool_p ptask;
+
+    d = (ws_deque_t*)
+        atomic_load_uintptr_t(&ws_deques[(start + i) % num_deques]);
+    if (d == NULL || d == tp->deque)
+      continue;
+    if ((ptask = ws_deque_steal(d)) != NULL)
+      return ptask;
+  }
+
+  return NULL;
+}
+
+
+//
+// Find a task to run: the newest one on our own deque, else the oldest
+// in the shared pool, else one stolen from another thread.  Tasks that
+// were already started from their task lists are dropped as we go.
+//
+static task_pool_p ws_find_task(thread_private_data_t* tp) {
+  while (true) {
+    task_pool_p ptask = NULL;
+
+    if (tp->deque != NULL)
+      ptask = ws_deque_pop(tp->deque);
+    if (ptask == NULL && task_pool_head != NULL)
+      ptask = ws_take_from_pool();
+    if (ptask == NULL)
+      ptask = ws_steal(tp);
+    if (ptask == NULL)
+      return NULL;
+
+    if (ws_claim_task(ptask)) {
+      ws_unlist_task(ptask);
+      return ptask;
+    }
+
+    ws_release_task(ptask);
+  }
+}
+
+
+//
+// Wait for there to be tasks, for a limited time.  A thread creating a
+// task wakes one parked thread, but we also time out in case we miss
+// that and so that idle threads can take part in deadlock detection.
+//
+static void ws_park(void) {
+  struct timeval now;
+  struct timespec ts;
+
+  gettimeofday(&now, NULL);
+  now.tv_usec += WS_PARK_USECS;
+  ts.tv_sec  = now.tv_sec + now.tv_usec / 1000000;
+  ts.tv_nsec = (now.tv_usec % 1000000) * 1000UL;
+
+  chpl_thread_mutexLock(&ws_park_lock);
+  (void) atomic_fetch_add_int_least32_t(&ws_parked_cnt, 1);
+  if (atomic_load_int_least32_t(&queued_task_cnt) == 0)
+    (void) pthread_cond_timedwait(&ws_park_cond,
+                                  (pthread_mutex_t*) &ws_park_lock, &ts);
+  (void) atomic_fetch_sub_int_least32_t(&ws_parked_cnt, 1);
+  chpl_thread_mutexUnlock(&ws_park_lock);
+}
+
+
+//
+// Get a task to run, waiting until there is one.  Idle threads spin
+// for a while looking for work, and then park.
+//
+static task_pool_p ws_wait_for_task(void) {
+  thread_private_data_t* tp = get_thread_private_data();
+  task_pool_p ptask;
+  chpl_bool maybe_deadlocked;
+  struct timeval deadline, now;
+  int spins;
+
+  if ((ptask = ws_find_task(tp)) != NULL)
+    return ptask;
+
+  maybe_deadlocked = set_block_loc(0, CHPL_FILE_IDX_IDLE_TASK);
+  if (maybe_deadlocked) {
+    // all other tasks appear to be blocked
+    gettimeofday(&deadline, NULL);
+    deadline.tv_sec += 1;
+  }
+
+  //
+  // Yield every time around, even after parking, because that is
+  // where the threading layer lets us be canceled at shutdown.
+  //
+  spins = 0;
+  while ((ptask = ws_find_task(tp)) == NULL) {
+    if (++spins >= WS_SPINS_BEFORE_PARK)
+      ws_park();
+    chpl_thread_yield();
+
+    if (maybe_deadlocked) {
+      gettimeofday(&now, NULL);
+      if (now.tv_sec > deadline.tv_sec
+          || (now.tv_sec == deadline.tv_sec
+              && now.tv_usec >= deadline.tv_usec)) {
+        check_for_deadlock();
+        unset_block_loc();
+        maybe_deadlocked = set_block_loc(0, CHPL_FILE_IDX_IDLE_TASK);
+        deadline = now;
+        deadline.tv_sec += 1;
+      }
+    }
   }
 
+  unset_block_loc();
   return ptask;
 }
 
@@ -1372,5 +1957,5 @@ uint32_t chpl_task_getNumThreads(void) {
 }
 
 uint32_t chpl_task_getNumIdleThreads(void) {
-  return idle_thread_cnt;
+  return atomic_load_int_least32_t(&idle_thread_cnt);
 }
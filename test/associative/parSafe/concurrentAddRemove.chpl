@@ -0,0 +1,35 @@
+// Concurrently add, look up and remove indices of a parSafe associative
+// domain, with duplicates added by several tasks at once and the table
+// growing and shrinking underneath them.
+
+config const n = 20000;
+config const dups = 4;
+
+var D: domain(int, parSafe=true);
+var A: [D] int;
+
+forall i in 1..n*dups with (ref D) {
+  const k = (i-1) % n;
+  D += k;
+  if !D.contains(k) then
+    halt("index ", k, " missing right after it was added");
+}
+
+writeln(D.size == n);
+writeln(&& reduce [k in 0..#n] D.contains(k));
+writeln(A.size == n, " ", + reduce A);
+
+var removed: [0..#n] atomic int;
+forall i in 1..n*dups with (ref D) {
+  const k = (i-1) % n;
+  if k % 2 == 0 then
+    removed[k].add(D.remove(k));
+}
+
+writeln(D.size == n/2);
+writeln(&& reduce [k in 0..#n] (D.contains(k) == (k % 2 == 1)));
+writeln(&& reduce [k in 0..#n by 2] (removed[k].read() == 1));
+
+forall k in 0..#n with (ref D) do
+  D -= k;
+writeln(D.size);
@@ -0,0 +1,44 @@
+// Check that a program split into several C translation units with
+// --c-units still builds and runs, with globals, dynamic dispatch,
+// generics and parallel iteration crossing the units.
+
+config const n = 100;
+
+var counter = 0;
+
+class Shape {
+  proc area(): real { return 0.0; }
+}
+
+class Square : Shape {
+  var side: real;
+  override proc area(): real { return side * side; }
+}
+
+class Circle : Shape {
+  var radius: real;
+  override proc area(): real { return 3.0 * radius * radius; }
+}
+
+record Pair {
+  type t;
+  var a, b: t;
+}
+
+proc sum(p: Pair) { counter += 1; return p.a + p.b; }
+
+iter evens(hi: int) {
+  for i in 0..hi by 2 do yield i;
+}
+
+var shapes: [1..2] unmanaged Shape = [new unmanaged Square(2.0): unmanaged Shape,
+                                      new unmanaged Circle(1.0): unmanaged Shape];
+writeln(+ reduce [s in shapes] s.area());
+for s in shapes do delete s;
+
+writeln(sum(new Pair(int, 1, 2)), " ", sum(new Pair(real, 0.5, 0.25)));
+writeln(counter);
+
+var A: [1..n] int;
+forall i in 1..n do A[i] = i;
+writeln(+ reduce A, " ", + reduce evens(n));
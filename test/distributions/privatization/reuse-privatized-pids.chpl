@@ -0,0 +1,31 @@
+// Creating and destroying distributed domains and arrays in a loop
+// should keep reusing the same privatized ids.
+
+use BlockDist;
+
+config const n = 100;
+config const iters = 1000;
+
+extern proc chpl_numPrivatizedClasses(): int;
+
+proc numPrivatized() {
+  var total = 0;
+  for loc in Locales do on loc do
+    total += chpl_numPrivatizedClasses();
+  return total;
+}
+
+const before = numPrivatized();
+var maxPid = 0;
+
+for i in 1..iters {
+  const D = {1..n} dmapped Block({1..n});
+  var A: [D] int = i;
+  maxPid = max(maxPid, D._pid, A._pid);
+  assert(+ reduce A == n*i);
+}
+
+assert(numPrivatized() == before);
+// Only a handful of ids are needed at once.
+assert(maxPid < 10);
+writeln("OK");
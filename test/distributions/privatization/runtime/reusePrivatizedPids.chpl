@@ -0,0 +1,38 @@
+use PrivatizationWrappers;
+
+extern proc chpl_privatization_allocPid(): int;
+extern proc chpl_privatization_releasePid(pid:int);
+extern proc chpl_numPrivatizedClasses(): int;
+
+config const n = 5000;
+config const rounds = 10;
+
+var pids: [0..#n] int;
+
+for 1..rounds {
+  forall p in pids do
+    p = chpl_privatization_allocPid();
+
+  // The pids handed out at once are distinct, and once the first round
+  // has released them they are reused instead of new ones.
+  var counts: [0..#n] int;
+  for p in pids {
+    assert(0 <= p && p < n);
+    counts[p] += 1;
+  }
+  assert(&& reduce (counts == 1));
+
+  forall p in pids do
+    insertPrivatized(new unmanaged C(p), p);
+
+  forall p in pids {
+    var c = getPrivatized(p);
+    assert(c.i == p);
+    delete c;
+    clearPrivatized(p);
+    chpl_privatization_releasePid(p);
+  }
+}
+
+assert(chpl_numPrivatizedClasses() == 0);
+writeln("OK");
@@ -0,0 +1,34 @@
+use IO;
+
+config const n = 100000;
+config const nTasks = 4;
+
+var f = opentmp(hints=IOHINT_ASYNC);
+
+{
+  var w = f.writer(kind=ionative, hints=IOHINT_ASYNC);
+  for i in 1..n do
+    w.write(i);
+  w.close();
+}
+
+assert(f.length() == n * numBytes(int));
+
+// Read disjoint regions of the file from several tasks at once.
+const perTask = n / nTasks;
+coforall t in 0..#nTasks {
+  const lo = t * perTask + 1;
+  const hi = if t == nTasks-1 then n else lo + perTask - 1;
+  var r = f.reader(kind=ionative, hints=IOHINT_ASYNC,
+                   start=(lo-1) * numBytes(int), end=hi * numBytes(int));
+  var x: int;
+  for i in lo..hi {
+    assert(r.read(x));
+    assert(x == i);
+  }
+  assert(!r.read(x));
+  r.close();
+}
+
+f.close();
+writeln("OK");
@@ -0,0 +1,68 @@
+use IO;
+
+config const n = 10000;
+config const path = "chunk-readers.txt";
+
+{
+  var f = open(path, iomode.cw);
+  var w = f.writer();
+  for i in 1..n do w.writeln(i);
+  w.close();
+  f.close();
+}
+
+var f = open(path, iomode.r);
+
+// Every piece starts at the beginning of a line
+for nChunks in [1, 3, 7, 64] {
+  const offsets = f.splitOffsets(nChunks);
+  assert(offsets[0] == 0);
+  assert(offsets[nChunks] == f.length());
+  for i in 1..nChunks-1 {
+    assert(offsets[i-1] <= offsets[i]);
+    var r = f.reader(start=offsets[i]-1, end=offsets[i]);
+    var b:uint(8);
+    r.readbits(b, 8);
+    assert(b == ascii("\n"));
+    r.close();
+  }
+}
+
+// More pieces than lines leaves some empty
+{
+  var g = open(path + ".small", iomode.cw);
+  var w = g.writer();
+  w.writeln("a"); w.writeln("b");
+  w.close();
+  const offsets = g.splitOffsets(10);
+  assert(offsets[10] == 4);
+  var total = 0;
+  for i in 0..9 do total += offsets[i+1] - offsets[i];
+  assert(total == 4);
+  g.close();
+}
+
+// Reading all of the pieces in parallel sees every line once
+var sum = 0, count = 0;
+forall r in f.chunkReaders(nChunks=13) with (+ reduce sum, + reduce count) {
+  var x:int;
+  while r.read(x) {
+    sum += x;
+    count += 1;
+  }
+  r.close();
+}
+assert(count == n);
+assert(sum == n*(n+1)/2);
+
+// And serially
+var serialCount = 0;
+for r in f.chunkReaders(nChunks=5) {
+  var x:int;
+  while r.read(x) do serialCount += 1;
+  r.close();
+}
+assert(serialCount == n);
+
+f.close();
+writeln("OK");
@@ -1492,6 +1492,90 @@ void test_quoted_string_maxlength(void)
   if( verbose ) printf("PASS: quoted max length\n");
 }
 
+// Scan many values so that some of them straddle the edges of the
+// cached buffer window, once with the bulk scanning fast paths enabled
+// and once with them disabled.
+void test_scan_many(void)
+{
+  qioerr err;
+  qio_file_t* f;
+  qio_channel_t* writing;
+  qio_channel_t* reading;
+  qio_style_t style;
+  char line[128];
+  int64_t got_int;
+  double got_real;
+  const char* got_str;
+  int64_t got_len;
+  int n = 2000;
+  int i, j;
+  int save_glocale = qio_glocale_utf8;
+
+  if( verbose ) printf("Testing scanning many values\n");
+
+  err = qio_file_open_tmp(&f, 0, NULL);
+  assert(!err);
+
+  err = qio_channel_create(&writing, f, QIO_CH_BUFFERED, 0, 1, 0, INT64_MAX, NULL);
+  assert(!err);
+  for( i = 0; i < n; i++ ) {
+    // vary the widths so that values land at every alignment
+    snprintf(line, sizeof(line), "%*d %d.%de%d word%0*d \"q\\\\%d\" skip %d\n",
+             1 + i % 7, -i, i, i % 10, i % 3, 1 + i % 23, i, i, i);
+    err = qio_channel_write_amt(true, writing, line, strlen(line));
+    assert(!err);
+  }
+  qio_channel_release(writing);
+
+  for( j = 0; j < 2; j++ ) {
+    qio_glocale_utf8 = (j == 0) ? QIO_GLOCALE_ASCII : QIO_GLOCALE_OTHER;
+
+    style = qio_style_default();
+    err = qio_channel_create(&reading, f, QIO_CH_BUFFERED, 1, 0, 0, INT64_MAX, &style);
+    assert(!err);
+
+    for( i = 0; i < n; i++ ) {
+      err = qio_channel_scan_int(true, reading, &got_int, 8, 1);
+      assert(!err);
+      assert(got_int == -i);
+
+      err = qio_channel_scan_float(true, reading, &got_real, 8);
+      assert(!err);
+      snprintf(line, sizeof(line), "%d.%de%d", i, i % 10, i % 3);
+      assert(got_real == strtod(line, NULL));
+
+      reading->style.string_format = QIO_STRING_FORMAT_WORD;
+      err = qio_channel_scan_string(true, reading, &got_str, &got_len, -1);
+      assert(!err);
+      snprintf(line, sizeof(line), "word%0*d", 1 + i % 23, i);
+      assert(got_len == strlen(line) && 0 == strcmp(got_str, line));
+      qio_free((void*) got_str);
+
+      err = qio_channel_scan_literal(true, reading, " ", 1, 1);
+      assert(!err);
+      reading->style.string_format = QIO_STRING_FORMAT_CHPL;
+      err = qio_channel_scan_string(true, reading, &got_str, &got_len, -1);
+      assert(!err);
+      snprintf(line, sizeof(line), "q\\%d", i);
+      assert(got_len == strlen(line) && 0 == strcmp(got_str, line));
+      qio_free((void*) got_str);
+
+      err = qio_channel_skip_past_newline(true, reading, 0);
+      assert(!err);
+    }
+
+    err = qio_channel_scan_int(true, reading, &got_int, 8, 1);
+    assert(qio_err_to_int(err) == EEOF);
+
+    qio_channel_release(reading);
+  }
+
+  qio_glocale_utf8 = save_glocale;
+  qio_file_release(f);
+
+  if( verbose ) printf("PASS: scanning many values\n");
+}
+
 int main(int argc, char** argv)
 {
   int sizes[] = {qbytes_iobuf_size, 64, 1, 2, 0};
@@ -1538,6 +1622,8 @@ int main(int argc, char** argv)
     test_scanmatch();
 
     test_quoted_string_maxlength();
+
+    test_scan_many();
   }
 
   printf("qio_formatted_test PASS\n");
@@ -0,0 +1,54 @@
+use IO;
+
+// Large enough that the file is not mapped all at once by default,
+// so readers walk it in windows.
+config const n = 3 * 1024 * 1024;
+config const fileName = "mmap-windows.bin";
+
+{
+  var f = open(fileName, iomode.cw);
+  var w = f.writer(kind=ionative);
+  for i in 1..n do
+    w.write(i);
+  w.close();
+  f.close();
+}
+
+proc check(fileHints, chHints) {
+  var f = open(fileName, iomode.r, hints=fileHints);
+  assert(f.length() == n * numBytes(int));
+
+  // Read the whole file into an array in one call.
+  {
+    var A: [1..n] int;
+    var r = f.reader(kind=ionative, hints=chHints);
+    r.read(A);
+    r.close();
+    for i in 1..n do
+      assert(A[i] == i);
+  }
+
+  // Read a region in the middle one element at a time.
+  {
+    const lo = n / 3, hi = 2 * n / 3;
+    var r = f.reader(kind=ionative, hints=chHints,
+                     start=(lo-1) * numBytes(int), end=hi * numBytes(int));
+    var x: int;
+    for i in lo..hi {
+      assert(r.read(x));
+      assert(x == i);
+    }
+    assert(!r.read(x));
+    r.close();
+  }
+
+  f.close();
+}
+
+check(IOHINT_NONE, IOHINT_NONE);
+check(IOHINT_SEQUENTIAL, IOHINT_SEQUENTIAL);
+check(IOHINT_RANDOM, IOHINT_RANDOM);
+check(IOHINT_PARALLEL, IOHINT_SEQUENTIAL);
+check(IOHINT_CACHED, IOHINT_CACHED);
+
+writeln("OK");
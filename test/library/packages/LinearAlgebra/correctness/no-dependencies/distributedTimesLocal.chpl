@@ -0,0 +1,11 @@
+use LinearAlgebra;
+use BlockDist;
+
+/* A distributed matrix times a local one is rejected, rather than reaching
+   a kernel that reads the distributed matrix as if it were local */
+
+const D = {1..4, 1..4} dmapped Block({1..4, 1..4});
+var DA: [D] real;
+var A: [1..4, 1..4] real;
+
+var C = dot(DA, A);
@@ -0,0 +1,11 @@
+use LinearAlgebra;
+use BlockDist;
+
+/* A distributed matrix times a vector is rejected, rather than reaching
+   a kernel that reads the distributed matrix as if it were local */
+
+const D = {1..4, 1..4} dmapped Block({1..4, 1..4});
+var DA: [D] real;
+var x: [1..4] real;
+
+var y = DA.dot(x);
@@ -0,0 +1,72 @@
+use LinearAlgebra;
+use BlockDist;
+use TestUtils;
+
+/* Native matrix-matrix and matrix-vector multiplication over sizes that are
+   not multiples of the kernel's tiles, compared against naive loops
+
+   Any output denotes failure
+*/
+
+config const m = 131,
+             n = 70,
+             k = 600;
+
+proc naiveMatMat(A: [?Adom] ?t, B: [?Bdom] t) {
+  var C: [Adom.dim(1), Bdom.dim(2)] t;
+  for i in Adom.dim(1) do
+    for j in Bdom.dim(2) do
+      for (ka, kb) in zip(Adom.dim(2), Bdom.dim(1)) do
+        C[i, j] += A[i, ka] * B[kb, j];
+  return C;
+}
+
+proc test_multiplication(type t) {
+  var A: [1..m, 0..#k] t;
+  var B: [3..#k, 1..n] t;
+  forall (i, j) in A.domain do A[i, j] = ((i*7 + j*3) % 11 - 5):t;
+  forall (i, j) in B.domain do B[i, j] = ((i*5 + j*2) % 13 - 6):t;
+
+  const C = naiveMatMat(A, B);
+  assertEqual(dot(A, B), C, "dot(A, B) " + t:string);
+
+  /* strided */
+  var S: [1..2*m by 2, 1..k] t = A;
+  assertEqual(dot(S, B), C, "dot(S, B) " + t:string);
+
+  /* matrix-vector */
+  var x: [5..#k] t = [i in 5..#k] (i % 3):t;
+  var Ax: [1..m] t;
+  for i in 1..m do
+    for (kk, j) in zip(0..#k, 5..) do
+      Ax[i] += A[i, kk] * x[j];
+  assertEqual(dot(A, x), Ax, "dot(A, x) " + t:string);
+
+  /* vector-matrix */
+  var y: [7..#m] t = [i in 7..#m] (i % 4):t;
+  var yA: [0..#k] t;
+  for j in 0..#k do
+    for (i, yi) in zip(1..m, 7..) do
+      yA[j] += A[i, j] * y[yi];
+  assertEqual(dot(y, A), yA, "dot(y, A) " + t:string);
+
+  /* Block-distributed */
+  const AD = {1..m, 1..k} dmapped Block({1..m, 1..k}),
+        BD = {1..k, 1..n} dmapped Block({1..k, 1..n});
+  var DA: [AD] t = A;
+  var DB: [BD] t = B;
+  const DC = dot(DA, DB);
+  var LC: [1..m, 1..n] t = DC;
+  assertEqual(LC, C, "dot(DA, DB) " + t:string);
+
+  /* C's columns are split by its own width, not by A's */
+  for loc in DC.targetLocales() do on loc do
+    if DC.localSubdomain().size == 0 then
+      writeln("locale ", here.id, " owns none of dot(DA, DB) ", t:string);
+}
+
+test_multiplication(int);
+test_multiplication(int(32));
+test_multiplication(real);
+test_multiplication(real(32));
+test_multiplication(complex);
@@ -0,0 +1,86 @@
+use LinearAlgebra, LinearAlgebra.Sparse;
+use BlockDist, LayoutCS;
+use TestUtils;
+
+/* CSR matrix-vector and matrix-matrix multiplication on matrices with a few
+   dense rows among many short ones, so that the kernels' row chunks differ
+   from equal numbers of rows, compared against dense loops.  Also covers
+   CSR blocks of a SparseBlock array.
+
+   Any output denotes failure
+*/
+
+config const n = 1500,
+             denseEvery = 37;
+
+/* Column indices of the non-zeros of row i */
+iter rowCols(i) {
+  if i % denseEvery == 0 {
+    for j in 1..n by 2 do yield j;
+  } else {
+    for j in 1..1 + i % 5 do yield 1 + (i * 7 + j * 131) % n;
+  }
+}
+
+proc nonzeros() {
+  var inds: [1..0] 2*int;
+  for i in 1..n do
+    for j in rowCols(i) do
+      inds.push_back((i, j));
+  return inds;
+}
+
+proc value(i, j) return ((i * 3 + j * 5) % 17 - 8):real;
+
+proc test_multiplication(ref Dom, ref Dense) {
+  Dom += nonzeros();
+
+  var A: [Dom] real;
+  forall (i, j) in Dom do A[i, j] = value(i, j);
+
+  Dense = 0.0;
+  for (i, j) in Dom do Dense[i, j] = value(i, j);
+
+  var x: [1..n] real = [i in 1..n] (i % 7):real;
+
+  /* matrix-vector */
+  var Ax: [1..n] real;
+  for (i, j) in Dense.domain do Ax[i] += Dense[i, j] * x[j];
+  var y: [1..n] real = dot(A, x);
+  assertEqual(y, Ax, "dot(A, x)");
+
+  /* vector-matrix */
+  var xA: [1..n] real;
+  for (i, j) in Dense.domain do xA[j] += x[i] * Dense[i, j];
+  y = dot(x, A);
+  assertEqual(y, xA, "dot(x, A)");
+
+  return A;
+}
+
+/* CSR */
+{
+  const Parent = {1..n, 1..n};
+  var Dom: sparse subdomain(Parent) dmapped CS(sortedIndices=false);
+  var Dense: [Parent] real;
+  var A = test_multiplication(Dom, Dense);
+
+  /* matrix-matrix */
+  const AA = dot(A, A);
+  var DenseAA: [Parent] real;
+  for (i, j) in Dom do
+    for k in rowCols(j) do
+      DenseAA[i, k] += Dense[i, j] * Dense[j, k];
+  var AAdense: [Parent] real;
+  for (i, k) in AA.domain do AAdense[i, k] = AA[i, k];
+  assertEqual(AAdense, DenseAA, "dot(A, A)");
+}
+
+/* SparseBlock with CSR blocks */
+{
+  const Parent = {1..n, 1..n} dmapped Block({1..n, 1..n},
+                                            sparseLayoutType=CS);
+  var Dom: sparse subdomain(Parent);
+  var Dense: [1..n, 1..n] real;
+  test_multiplication(Dom, Dense);
+}
@@ -0,0 +1,85 @@
+/*
+ Generate a sparse matrix whose rows hold very different numbers of
+ non-zeros and multiply it by a dense vector.
+*/
+
+use LinearAlgebra;
+use LinearAlgebra.Sparse;
+use Time;
+
+
+config const n = 1000,
+             /* Non-zeros in most rows */
+             rowNnz = 10,
+             /* Every denseEvery'th row holds denseNnz non-zeros */
+             denseEvery = 100,
+             denseNnz = 100,
+             trials = 1,
+             /* Omit non-timing output */
+             performance = false,
+             /* Omit timing output */
+             correctness = false;
+
+proc main() {
+  if !performance {
+    writeln('CSR Matrix');
+    writeln('n        : ', n);
+    writeln('rowNnz   : ', rowNnz);
+  }
+
+  if !performance {
+    writeln('Creating A');
+  }
+
+  const R = 1..n;
+  const D = {R, R};
+  var csrD = CSRDomain(D);
+  var A = CSRMatrix(csrD);
+
+  var indices: [1..0] 2*int;
+  for i in R {
+    const cols = min(n, if i % denseEvery == 0 then denseNnz else rowNnz);
+    for k in 1..cols do
+      indices.push_back((i, 1 + (i + k * (n / cols)) % n));
+  }
+  csrD += indices;
+  A = 2.0;
+
+  var x: [R] real = 1.0;
+
+  if !performance {
+    writeln('Multiplying A*x');
+  }
+
+  var t: Timer;
+
+  t.start();
+  var y = A.dot(x);
+  t.stop();
+
+  for 2..trials {
+    t.start();
+    A.dot(x);
+    t.stop();
+  }
+
+  if !correctness {
+    writeln('nnz      : ', csrD.numIndices);
+    writeln('time (s) : ', t.elapsed() / trials);
+  }
+
+  /* Every row sums its non-zeros */
+  if !performance {
+    writeln("Checking A*x");
+  }
+
+  var fails = 0;
+  forall i in R with (+ reduce fails) {
+    var expected = 0.0;
+    for j in csrD.dimIter(2, i) do expected += 2.0;
+    if y[i] != expected then fails += 1;
+  }
+  if fails != 0 || !performance {
+    writeln('Row failures: ', fails);
+  }
+}
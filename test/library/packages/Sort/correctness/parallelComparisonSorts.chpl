@@ -0,0 +1,82 @@
+// Exercise quickSort and mergeSort on arrays large enough that they
+// sort and merge in parallel.
+
+use Random;
+use Sort;
+
+config const n = 100000;
+config const seed = 2718;
+
+record R {
+  var key: int;
+  var pos: int;
+}
+
+record KeyComparator {
+  proc compare(a: R, b: R) return a.key - b.key;
+}
+
+// Is A sorted by key, and were equal keys kept in order if stable?
+proc check(A: [] R, param stable: bool, desc: string) {
+  var ok = true;
+  var Count: [0..#n] int;
+
+  for i in A.domain {
+    if i != A.domain.low {
+      const prev = A[i - A.domain.stride];
+      if prev.key > A[i].key then ok = false;
+      if stable && prev.key == A[i].key && prev.pos > A[i].pos then ok = false;
+    }
+    Count[A[i].pos] += 1;
+  }
+  for c in Count[0..#A.size] do
+    if c != 1 then ok = false;
+
+  writeln(desc, ": ", if ok then "OK" else "FAILED");
+}
+
+proc fill(A: [] R, numKeys: int) {
+  var Keys: [A.domain] int;
+  fillRandom(Keys, seed);
+  for (a, k, p) in zip(A, Keys, 0..) {
+    a.key = mod(k, numKeys);
+    a.pos = p;
+  }
+}
+
+for numKeys in (n, 10) {
+  const desc = if numKeys == n then "random" else "duplicates";
+  var A: [1..n] R;
+
+  fill(A, numKeys);
+  quickSort(A, comparator=new KeyComparator());
+  check(A, false, "quickSort " + desc);
+
+  fill(A, numKeys);
+  mergeSort(A, comparator=new KeyComparator());
+  check(A, true, "mergeSort " + desc);
+
+  // already sorted and reversed input
+  quickSort(A, comparator=new KeyComparator());
+  check(A, false, "quickSort sorted " + desc);
+
+  fill(A, numKeys);
+  mergeSort(A, comparator=new ReverseComparator(new KeyComparator()));
+  mergeSort(A, comparator=new KeyComparator());
+  check(A, true, "mergeSort reversed " + desc);
+
+  // the default sort of records falls back to quickSort
+  fill(A, numKeys);
+  sort(A, comparator=new KeyComparator());
+  check(A, false, "sort " + desc);
+
+  // strided arrays
+  var S: [0..#2*n by 2] R;
+  fill(S, numKeys);
+  quickSort(S, comparator=new KeyComparator());
+  check(S, false, "strided quickSort " + desc);
+
+  fill(S, numKeys);
+  mergeSort(S, comparator=new KeyComparator());
+  check(S, true, "strided mergeSort " + desc);
+}
@@ -0,0 +1,78 @@
+// Sort Block- and Cyclic-distributed arrays, which sort() does with a
+// distributed sample sort when they span more than one locale.
+
+use BlockDist, CyclicDist;
+use Random;
+use Sort;
+
+config const n = 2000;
+config const seed = 31415;
+
+proc checkSort(ref A: [], ref Ref: [], comparator, desc: string) {
+  sort(A, comparator);
+  sort(Ref, comparator);
+
+  var ok = isSorted(A, comparator);
+  for (a, r) in zip(A, Ref) do
+    if a != r then ok = false;
+
+  writeln(desc, ": ", if ok then "OK" else "FAILED");
+}
+
+proc test(D: domain, name: string) {
+  var A: [D] int;
+  var Ref: [1..D.size] int;
+
+  // random values
+  fillRandom(A, seed);
+  Ref = A;
+  checkSort(A, Ref, defaultComparator, name + " random int");
+
+  // many duplicates
+  forall (a, i) in zip(A, D) do a = i % 7;
+  Ref = A;
+  checkSort(A, Ref, defaultComparator, name + " duplicate int");
+
+  // already sorted, sorted in reverse
+  checkSort(A, Ref, defaultComparator, name + " sorted int");
+  checkSort(A, Ref, reverseComparator, name + " reversed int");
+
+  // nearly all equal, so that every splitter is the same
+  forall (a, i) in zip(A, D) do a = if i % 50 == 0 then i else 0;
+  Ref = A;
+  checkSort(A, Ref, defaultComparator, name + " mostly equal int");
+
+  // real with a key comparator
+  record AbsComparator { proc key(x) return abs(x); }
+  var R: [D] real;
+  var RefR: [1..D.size] real;
+  fillRandom(R, seed);
+  R -= 0.5;
+  RefR = R;
+  checkSort(R, RefR, new AbsComparator(), name + " real by key");
+
+  // strings
+  var S: [D] string;
+  forall (s, i) in zip(S, D) do s = ((i * 7919) % D.size):string;
+  var RefS: [1..D.size] string = S;
+  checkSort(S, RefS, defaultComparator, name + " string");
+
+  // a slice of the distributed array
+  var B: [D] int;
+  fillRandom(B, seed);
+  const inner = D.low+3..D.high-5;
+  var RefB: [1..inner.size] int = B[inner];
+  checkSort(B[inner], RefB, defaultComparator, name + " slice");
+
+  // the elements outside the slice are unchanged
+  var C: [D] int;
+  fillRandom(C, seed);
+  var ok = true;
+  forall i in D with (&& reduce ok) do
+    ok &&= inner.contains(i) || B[i] == C[i];
+  writeln(name, " outside slice: ", if ok then "OK" else "FAILED");
+}
+
+test({1..n} dmapped Block({1..n}), "Block");
+test({0..#n} dmapped Cyclic(startIdx=0), "Cyclic");
+test({1..3} dmapped Block({1..3}), "small Block");
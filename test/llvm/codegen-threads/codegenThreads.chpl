@@ -0,0 +1,22 @@
+/* Checks that a program with code in several modules links and runs when
+   the LLVM module is split across code generation threads. */
+use codegenThreadsHelper;
+
+config const n = 1000;
+
+var pts: [1..n] Point = [i in 1..n] new Point(i:real, -i:real);
+var total: real;
+forall p in pts with (+ reduce total) do total += p.norm2();
+writeln(total);
+
+var shapes: [1..4] owned Shape;
+shapes[1] = new owned Rect(w=2.0, h=3.0);
+shapes[2] = new owned Circle(r=1.0);
+shapes[3] = new owned Rect(w=1.0, h=1.0);
+shapes[4] = new owned Circle(r=2.0);
+writeln(+ reduce [s in shapes] s.area());
+
+var ints: [1..10] int;
+for (a, i) in zip(ints, evens(18)) do a = i;
+var reals: [1..10] real = [i in 1..10] i / 4.0;
+writeln(sumOf(ints), " ", sumOf(reals));
@@ -0,0 +1,33 @@
+module codegenThreadsHelper {
+  record Point {
+    var x, y: real;
+
+    proc norm2() return x*x + y*y;
+  }
+
+  class Shape {
+    proc area(): real return 0.0;
+  }
+
+  class Rect: Shape {
+    var w, h: real;
+
+    override proc area(): real return w * h;
+  }
+
+  class Circle: Shape {
+    var r: real;
+
+    override proc area(): real return 3.0 * r * r;
+  }
+
+  iter evens(n: int) {
+    for i in 0..n by 2 do yield i;
+  }
+
+  proc sumOf(xs: [] ?t) {
+    var s: t;
+    for x in xs do s += x;
+    return s;
+  }
+}
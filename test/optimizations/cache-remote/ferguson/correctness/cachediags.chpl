@@ -0,0 +1,38 @@
+use CommDiagnostics;
+
+config const n = 100000;
+
+var A: [1..n] int;
+
+on Locales[1] {
+  resetCacheDiagnosticsHere();
+
+  var sum = 0;
+  for i in 1..n do
+    sum += A[i];
+  assert(sum == 0);
+
+  for i in 1..n do
+    A[i] = i;
+
+  const cd = getCacheDiagnosticsHere();
+  assert(cd.get_hits > 0);
+  assert(cd.get_misses > 0);
+  assert(cd.get_hits > cd.get_misses);
+  assert(cd.readahead_triggered > 0);
+  assert(cd.write_behind_flushes > 0);
+}
+
+for i in 1..n do
+  assert(A[i] == i);
+
+on Locales[1] {
+  resetCacheDiagnosticsHere();
+  const cd = getCacheDiagnosticsHere();
+  assert(cd.get_hits == 0 && cd.get_misses == 0);
+}
+
+// Whole-program counts; only the shape is checked since the calls
+// themselves communicate.
+const allCD = getCacheDiagnostics();
+assert(allCD.size == numLocales);
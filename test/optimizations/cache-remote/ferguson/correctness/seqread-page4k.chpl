@@ -0,0 +1 @@
+seqread.chpl
\ No newline at end of file
@@ -0,0 +1 @@
+seqrevread.chpl
\ No newline at end of file
@@ -0,0 +1,28 @@
+config const n = 100000;
+config const iters = 3;
+
+// Many tasks on one locale read the same remote array while the
+// per-locale shared read tier is enabled (see sharedread.execenv).
+// Values written between parallel phases must always be seen.
+proc doit(memory:locale, running:locale) {
+  on memory {
+    var A:[1..n] int;
+    for i in 1..n do A[i] = i;
+
+    on running {
+      for it in 1..iters {
+        forall t in 1..here.maxTaskPar*2 {
+          for i in 1..n do
+            assert(A[i] == i + (it-1)*n);
+        }
+        forall i in 1..n do
+          A[i] += n;
+      }
+    }
+
+    for i in 1..n do assert(A[i] == i + iters*n);
+  }
+}
+
+doit(Locales[1], Locales[0]);
+doit(Locales[0], Locales[1]);
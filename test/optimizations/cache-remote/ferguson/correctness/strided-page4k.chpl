@@ -0,0 +1 @@
+strided.chpl
\ No newline at end of file
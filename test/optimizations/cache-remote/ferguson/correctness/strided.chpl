@@ -0,0 +1,52 @@
+config const n = 64;
+
+// Mix scalar (cached) accesses with strided bulk transfers so that
+// strided GETs and PUTs have to see, and leave behind, consistent
+// cache contents.
+proc doit(memory:locale, running:locale) {
+  on memory {
+    var A:[1..n, 1..n] int;
+    var B:[1..n, 1..n] int;
+    for (i,j) in A.domain do A[i,j] = i*n + j;
+
+    on running {
+      var L:[1..n, 1..n] int;
+
+      // scalar reads to populate the cache
+      for j in 1..n do assert(A[1,j] == n + j);
+
+      // scalar writes that are still pending in the cache
+      for j in 1..n do A[2,j] = -j;
+
+      // strided GET must see the pending writes
+      L[1..n by 2, 1..n by 2] = A[1..n by 2, 1..n by 2];
+      L[2..n by 2, 1..n] = A[2..n by 2, 1..n];
+      for j in 1..n do assert(L[2,j] == -j);
+      for (i,j) in {3..n, 1..n} do
+        if i % 2 == 0 || j % 2 == 1 then assert(L[i,j] == i*n + j);
+
+      // strided PUT followed by scalar reads of the same elements
+      for (i,j) in L.domain do L[i,j] = -(i*n + j);
+      B[1..n by 3, 1..n by 2] = L[1..n by 3, 1..n by 2];
+      for i in 1..n by 3 do
+        for j in 1..n by 2 do
+          assert(B[i,j] == -(i*n + j));
+
+      // scalar write followed by a strided PUT to the same element
+      B[1,1] = 17;
+      B[1..n by 3, 1..1] = L[1..n by 3, 1..1];
+      assert(B[1,1] == L[1,1]);
+
+      // a large contiguous chunk bypasses the cache
+      A[3..n, 1..n] = L[3..n, 1..n];
+      for j in 1..n do assert(A[3,j] == -(3*n + j));
+    }
+
+    for (i,j) in {3..n, 1..n} do assert(A[i,j] == -(i*n + j));
+    for j in 1..n do assert(A[2,j] == -j);
+    assert(B[1,1] == -(n + 1));
+  }
+}
+
+doit(Locales[1], Locales[0]);
+doit(Locales[0], Locales[1]);
@@ -0,0 +1,36 @@
+use CommDiagnostics;
+
+var x: int = 1;
+var A: [1..4] int;
+
+startCommLatencyHistograms();
+resetCommDiagnostics();
+startCommDiagnostics();
+on Locales[numLocales-1] {
+  x = x + 1;
+  var B: [1..4] int = 5;
+  A = B;
+}
+stopCommDiagnostics();
+stopCommLatencyHistograms();
+
+const D = getCommDiagnostics();
+const DD = getCommDetailDiagnostics();
+const M = getCommMatrix();
+writeln(D);
+writeln(DD);
+for i in LocaleSpace do
+  writeln([e in M[i, ..]] e.ops);
+
+// Each row of the matrix accounts for all the bytes GETs and PUTs moved.
+for i in LocaleSpace do
+  writeln((+ reduce [e in M[i, ..]] e.bytes)
+          >= DD[i].get_bytes + DD[i].put_bytes);
+
+// Blocking operations that were counted were also timed.
+const H = getCommLatencyHistograms();
+for i in LocaleSpace {
+  writeln((+ reduce H[i].get > 0) == (D[i].get > 0), " ",
+          (+ reduce H[i].put > 0) == (D[i].put > 0), " ",
+          (+ reduce H[i].execute_on > 0) == (D[i].execute_on > 0));
+}
@@ -0,0 +1,55 @@
+// Mix unordered copies of different sizes with unordered atomics of
+// different types, all targeting the same remote locales, so that GETs
+// and atomics share batches and the batches fill up.
+
+use UnorderedCopy, UnorderedAtomics;
+
+config const n = 5000;
+
+var i8:  [1..n] int(8);
+var i32: [1..n] int(32);
+var r64: [1..n] real;
+
+var ai32: atomic int(32);
+var au64: atomic uint(64);
+var ar32: atomic real(32);
+var ar64: atomic real;
+
+for i in 1..n {
+  i8[i] = (i % 100):int(8);
+  i32[i] = i:int(32);
+  r64[i] = i:real;
+}
+
+coforall loc in Locales do on loc {
+  var l8:  [1..n] int(8);
+  var l32: [1..n] int(32);
+  var l64: [1..n] real;
+
+  forall i in 1..n {
+    unorderedCopy(l8[i], i8[i]);
+    unorderedCopy(l32[i], i32[i]);
+    ai32.unorderedAdd(1);
+    au64.unorderedXor(i:uint);
+    ar32.unorderedAdd(1.0:real(32));
+    unorderedCopy(l64[i], r64[i]);
+    ar64.unorderedSub(1.0);
+  }
+
+  for i in 1..n {
+    assert(l8[i] == i % 100);
+    assert(l32[i] == i);
+    assert(l64[i] == i);
+  }
+}
+
+// Each locale xor's in the same values, so with an even number of
+// locales they cancel out.
+var x: uint;
+if numLocales % 2 != 0 then
+  for i in 1..n do x ^= i:uint;
+
+writeln(ai32.read() == numLocales * n);
+writeln(au64.read() == x);
+writeln(ar32.read() == numLocales * n);
+writeln(ar64.read() == -numLocales * n);
@@ -0,0 +1,34 @@
+// Exercise the work-stealing scheduler in fifo tasking with nested
+// parallelism, begins waited on with sync, and dynamically balanced
+// forall loops.
+
+use DynamicIters;
+
+config const n = 1000;
+
+proc fib(i: int): int {
+  if i < 2 then return i;
+  var a, b: int;
+  sync {
+    begin with (ref a) a = fib(i-1);
+    b = fib(i-2);
+  }
+  return a + b;
+}
+
+var counts: [1..8, 1..8] atomic int;
+coforall i in 1..8 do
+  coforall j in 1..8 do
+    counts[i, j].add(i * j);
+writeln(+ reduce [c in counts] c.read());
+
+writeln(fib(16));
+
+var total: atomic int;
+forall i in dynamic(1..n, chunkSize=3) do
+  total.add(i);
+writeln(total.read() == n*(n+1)/2);
+
+var s$: sync int;
+begin s$ = 42;
+writeln(s$.readFE());
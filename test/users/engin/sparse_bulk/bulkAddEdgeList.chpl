@@ -0,0 +1,65 @@
+// Build a sparse domain from an unsorted edge list with duplicates, large
+// enough that the bulk addition sorts, deduplicates and fills the domain in
+// parallel, and compare it with adding the same indices one at a time.
+use LayoutCS;
+use Random;
+
+config const N = 300;
+config const numEdges = 40000;
+config const seed = 17;
+
+const ParentDom = {0..#N, 1..N};
+
+config type layoutType = DefaultDist;
+config param compressRows = true;
+var layout = if isCSType(layoutType) then new unmanaged CS(compressRows=compressRows)
+             else new unmanaged layoutType();
+var SparseDom: sparse subdomain(ParentDom) dmapped new dmap(layout);
+var RefDom: sparse subdomain(ParentDom);
+
+// A few rows and columns hold many more edges than the rest
+var edges: [1..numEdges] 2*int;
+var R: [1..2*numEdges] int;
+fillRandom(R, seed);
+for (e, k) in zip(edges, 1..) {
+  const (a, b) = (mod(R[2*k-1], N), mod(R[2*k], N));
+  e = if k % 3 == 0 then (a % 10, 1 + b) else (a, 1 + b % 40);
+}
+
+proc check(msg) {
+  var ok = SparseDom.size == RefDom.size;
+  for i in ParentDom do
+    if SparseDom.contains(i) != RefDom.contains(i) then ok = false;
+  writeln(msg, ": ", SparseDom.size, " indices, ",
+          if ok then "OK" else "FAILED");
+}
+
+// into an empty domain
+for e in edges[1..numEdges/2] do RefDom += e;
+SparseDom += edges[1..numEdges/2];
+check("empty domain");
+
+var SparseMat: [SparseDom] int;
+forall (i, j) in SparseDom do SparseMat[i, j] = i * N + j;
+
+// into a non-empty domain, keeping the array's values
+for e in edges[numEdges/2+1..] do RefDom += e;
+SparseDom += edges[numEdges/2+1..];
+check("non-empty domain");
+
+var ok = true;
+for e in edges[1..numEdges/2] do
+  if SparseMat[e] != e[1] * N + e[2] then ok = false;
+writeln("array values: ", if ok then "OK" else "FAILED");
+
+// already sorted, unique indices
+SparseDom.clear();
+var Sorted: [1..0] 2*int;
+for i in RefDom do Sorted.push_back(i);
+if isCSType(layoutType) && !compressRows {
+  record ColumnMajor { proc key(x) return (x[2], x[1]); }
+  use Sort;
+  sort(Sorted, comparator=new ColumnMajor());
+}
+SparseDom.bulkAdd(Sorted, dataSorted=true, isUnique=true);
+check("sorted unique");
@@ -0,0 +1,60 @@
+// Build a SparseBlock domain from an unsorted edge list with duplicates,
+// which routes the indices to the locales that own them in bulk, and
+// compare it with adding the same indices one at a time.
+use BlockDist;
+use LayoutCS;
+use Random;
+
+config const N = 100;
+config const numEdges = 10000;
+config const seed = 17;
+
+config type sparseLayoutType = DefaultDist;
+
+const ParentDom = {0..#N, 1..N} dmapped Block({0..#N, 1..N},
+    sparseLayoutType=sparseLayoutType);
+
+var SparseDom: sparse subdomain(ParentDom);
+var RefDom: sparse subdomain({0..#N, 1..N});
+
+// A few rows and columns hold many more edges than the rest
+var edges: [1..numEdges] 2*int;
+var R: [1..2*numEdges] int;
+fillRandom(R, seed);
+for (e, k) in zip(edges, 1..) {
+  const (a, b) = (mod(R[2*k-1], N), mod(R[2*k], N));
+  e = if k % 3 == 0 then (a % 10, 1 + b) else (a, 1 + b % 40);
+}
+
+proc check(msg) {
+  var ok = SparseDom.size == RefDom.size;
+  for i in {0..#N, 1..N} do
+    if SparseDom.contains(i) != RefDom.contains(i) then ok = false;
+  writeln(msg, ": ", SparseDom.size, " indices, ",
+          if ok then "OK" else "FAILED");
+}
+
+// into an empty domain
+for e in edges[1..numEdges/2] do RefDom += e;
+SparseDom += edges[1..numEdges/2];
+check("empty domain");
+
+var SparseMat: [SparseDom] int;
+forall (i, j) in SparseDom do SparseMat[i, j] = i * N + j;
+
+// into a non-empty domain, keeping the array's values
+for e in edges[numEdges/2+1..] do RefDom += e;
+SparseDom += edges[numEdges/2+1..];
+check("non-empty domain");
+
+var ok = true;
+for e in edges[1..numEdges/2] do
+  if SparseMat[e] != e[1] * N + e[2] then ok = false;
+writeln("array values: ", if ok then "OK" else "FAILED");
+
+// already sorted, unique indices
+SparseDom.clear();
+var Sorted: [1..0] 2*int;
+for i in RefDom do Sorted.push_back(i);
+SparseDom.bulkAdd(Sorted, dataSorted=true, isUnique=true);
+check("sorted unique");
@@ -0,0 +1,44 @@
+# FCA Makefile fragment
+# This Makefile fragment is used to build GASNet conduits 
+# it is not meant to be used directly 
+#
+# To use in a conduit Makefile.am just include this fragment.
+# Example:
+#    include $(top_builddir)/other/fca/fca.mak
+#
+# This fragment defines the following variables for use
+# in the corresponding CONDUIT_* variables.  For instance,
+# one should include $(fca_sourcelist) in CONDUIT_SOURCELIST
+#
+# fca_sourcelist     - C files to build normally
+# fca_extralibcflags - CFLAGS needed for FCA headers
+# fca_extraheaders   - FCA header(s) to install from fca directory
+# fca_privheaders    - FCA header(s) not to install from fca or conduit directory
+# fca_extradeps      - dependencies on FCA .c and .h files
+# fca_special_objs   - FCA .o files with "abonormal" build requirements
+#
+# fca_{src,bld}dir are also set, but probably aren't needed outside this fragment
+
+fca_srcdir = $(top_srcdir)/other/fca
+fca_blddir = $(top_builddir)/other/fca
+fca_sourcelist = 
+fca_extraheaders = $(fca_srcdir)/gasnet_fca.h
+fca_privheaders = gasnet_fca_api.h gasnet_fca_team.h
+fca_extralibcflags = -I$(fca_srcdir) 
+fca_extradeps = $(fca_srcdir)/*.[ch] $(fca_blddir)/fca.mak
+fca_special_objs =                                   \
+	$(builddir)/fca-component-$(THREAD_MODEL).o      \
+	$(builddir)/fca-ops-$(THREAD_MODEL).o
+
+# Some source files need special treatment:
+$(builddir)/fca-component-$(THREAD_MODEL).o: force
+	keeptmps='$(KEEPTMPS)'; \
+	/usr/bin/gcc $(LIBCFLAGS)   -o $@ -c $(fca_srcdir)/gasnet_fca_component.c
+
+$(builddir)/fca-ops-$(THREAD_MODEL).o: force
+	keeptmps='$(KEEPTMPS)'; \
+	/usr/bin/gcc $(LIBCFLAGS)   -o $@ -c $(fca_srcdir)/gasnet_fca_ops.c
+
+# How to rebuild this file
+$(fca_blddir)/fca.mak: $(fca_srcdir)/fca.mak.in
+	cd $(@D) && $(MAKE) $(@F)
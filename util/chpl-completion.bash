@@ -21,10 +21,10 @@ _chpl ()
   case "$cur" in
     -*)
       # developer options
-      local devel_opts="-M -g -I -l -L -O -o -s -h --count-tokens --main-module --module-dir --print-code-size --print-module-files --print-search-dirs --permit-unhandled-module-errors --warn-unstable --warnings --local --baseline --cache-remote --copy-propagation --dead-code-elimination --fast --fast-followers --ieee-float --ignore-local-classes --inline --inline-iterators --inline-iterators-yield-limit --live-analysis --loop-invariant-code-motion --optimize-forall-unordered-ops --optimize-range-iterators --optimize-loop-iterators --optimize-on-clauses --optimize-on-clause-limit --privatization --remote-value-forwarding --remote-serialization --remove-copy-calls --scalar-replacement --scalar-replace-limit --tuple-copy-opt --tuple-copy-limit --use-noinit --infer-local-fields --vectorize --no-checks --bounds-checks --cast-checks --div-by-zero-checks --formal-domain-checks --local-checks --nil-checks --stack-checks --codegen --cpp-lines --max-c-ident-len --munge-user-idents --savec --ccflags --debug --dynamic --hdr-search-path --ldflags --lib-linkage --lib-search-path --optimize --specialize --output --static --llvm --llvm-wide-opt --mllvm --print-commands --print-passes --print-passes-file --devel --explain-call --explain-instantiation --explain-verbose --instantiate-max --print-callgraph --print-callstack-on-error --print-unused-functions --set --task-tracking --home --atomics --network-atomics --aux-filesys --comm --comm-substrate --gasnet-segment --gmp --hwloc --launcher --locale-model --make --mem --regexp --target-arch --target-compiler --target-cpu --target-platform --tasks --timers --copyright --help --help-env --help-settings --license --version --cc-warnings --gen-ids --html --html-user --html-wrap-lines --html-print-block-ids --html-chpl-home --log --log-dir --log-ids --log-module --log-pass --log-node --llvm-print-ir --llvm-print-ir-stage --verify --parse-only --parser-debug --debug-short-loc --print-emitted-code-size --print-module-resolution --print-dispatch --print-statistics --report-aliases --report-blocking --report-inlining --report-dead-blocks --report-dead-modules --report-optimized-loop-iterators --report-inlined-iterators --report-vectorized-loops --report-optimized-on --report-optimized-forall-unordered-ops --report-promotion --report-scalar-replace --default-unmanaged --legacy-new --break-on-id --break-on-remove-id --break-on-codegen --break-on-codegen-id --default-dist --explain-call-id --break-on-resolve-id --denormalize --gdb --lldb --interprocedural-alias-analysis --lifetime-checking --compile-time-nil-checking --heterogeneous --ignore-errors --ignore-user-errors --ignore-errors-for-pass --infer-const-refs --library --library-dir --library-header --library-makefile --library-fortran --library-fortran-name --library-python --library-python-name --localize-global-consts --local-temp-names --log-deleted-ids-to --memory-frees --override-checking --preserve-inlined-line-numbers --print-id-on-error --print-unused-internal-functions --region-vectorizer --remove-empty-records --remove-unreachable-blocks --replace-array-accesses-with-ref-temps --incremental --minimal-modules --print-chpl-settings --stop-after-pass --force-vectorize --warn-const-loops --warn-domain-literal --warn-tuple-iteration --warn-special --print-chpl-home --no-count-tokens --no-print-code-size --no-print-search-dirs --no-permit-unhandled-module-errors --no-warn-unstable --no-warnings --no-local --no-cache-remote --no-copy-propagation --no-dead-code-elimination --no-fast-followers --no-ieee-float --no-ignore-local-classes --no-inline --no-inline-iterators --no-live-analysis --no-loop-invariant-code-motion --no-optimize-forall-unordered-ops --no-optimize-range-iterators --no-optimize-loop-iterators --no-optimize-on-clauses --no-privatization --no-remote-value-forwarding --no-remote-serialization --no-remove-copy-calls --no-scalar-replacement --no-tuple-copy-opt --no-use-noinit --no-infer-local-fields --no-vectorize --no-bounds-checks --no-cast-checks --no-div-by-zero-checks --no-formal-domain-checks --no-local-checks --no-nil-checks --no-stack-checks --no-codegen --no-cpp-lines --no-munge-user-idents --no-debug --no-optimize --no-specialize --no-llvm --no-llvm-wide-opt --no-print-commands --no-print-passes --no-devel --no-explain-verbose --no-print-callgraph --no-print-callstack-on-error --no-print-unused-functions --no-task-tracking --no-cc-warnings --no-gen-ids --no-html-wrap-lines --no-html-print-block-ids --no-log-ids --no-verify --no-parse-only --no-debug-short-loc --no-report-aliases --no-report-blocking --no-default-unmanaged --no-legacy-new --no-denormalize --no-interprocedural-alias-analysis --no-lifetime-checking --no-compile-time-nil-checking --no-ignore-errors --no-ignore-user-errors --no-ignore-errors-for-pass --no-infer-const-refs --no-localize-global-consts --no-local-temp-names --no-memory-frees --no-override-checking --no-preserve-inlined-line-numbers --no-print-id-on-error --no-print-unused-internal-functions --no-region-vectorizer --no-remove-empty-records --no-remove-unreachable-blocks --no-replace-array-accesses-with-ref-temps --no-incremental --no-minimal-modules --no-force-vectorize --no-warn-const-loops --no-warn-domain-literal --no-warn-tuple-iteration --no-warn-special"
+      local devel_opts="-M -g -I -l -L -O -o -s -h --count-tokens --main-module --module-dir --print-code-size --print-module-files --print-search-dirs --permit-unhandled-module-errors --warn-unstable --warnings --local --baseline --cache-remote --copy-propagation --dead-code-elimination --fast --fast-followers --ieee-float --ignore-local-classes --inline --inline-iterators --inline-iterators-yield-limit --live-analysis --loop-invariant-code-motion --optimize-forall-unordered-ops --optimize-range-iterators --optimize-loop-iterators --optimize-on-clauses --optimize-on-clause-limit --privatization --remote-value-forwarding --remote-serialization --remove-copy-calls --scalar-replacement --scalar-replace-limit --tuple-copy-opt --tuple-copy-limit --use-noinit --infer-local-fields --vectorize --no-checks --bounds-checks --cast-checks --div-by-zero-checks --formal-domain-checks --local-checks --nil-checks --stack-checks --c-units --codegen --cpp-lines --max-c-ident-len --munge-user-idents --savec --ccflags --debug --dynamic --hdr-search-path --ldflags --lib-linkage --lib-search-path --optimize --specialize --output --static --llvm --llvm-codegen-threads --llvm-wide-opt --mllvm --print-commands --print-passes --print-passes-file --print-pass-profile --print-pass-profile-json --devel --explain-call --explain-instantiation --explain-verbose --instantiate-max --print-callgraph --print-callstack-on-error --print-unused-functions --set --task-tracking --home --atomics --network-atomics --aux-filesys --comm --comm-substrate --gasnet-segment --gmp --hwloc --launcher --locale-model --make --mem --regexp --target-arch --target-compiler --target-cpu --target-platform --tasks --timers --copyright --help --help-env --help-settings --license --version --cc-warnings --gen-ids --html --html-user --html-wrap-lines --html-print-block-ids --html-chpl-home --log --log-dir --log-ids --log-module --log-pass --log-node --llvm-print-ir --llvm-print-ir-stage --verify --parse-only --parser-debug --debug-short-loc --print-emitted-code-size --print-module-resolution --print-dispatch --print-statistics --report-aliases --report-blocking --report-inlining --report-dead-blocks --report-dead-modules --report-optimized-loop-iterators --report-inlined-iterators --report-vectorized-loops --report-optimized-on --report-optimized-forall-unordered-ops --report-promotion --report-scalar-replace --default-unmanaged --legacy-new --break-on-id --break-on-remove-id --break-on-codegen --break-on-codegen-id --default-dist --explain-call-id --break-on-resolve-id --denormalize --gdb --lldb --interprocedural-alias-analysis --lifetime-checking --compile-time-nil-checking --heterogeneous --ignore-errors --ignore-user-errors --ignore-errors-for-pass --infer-const-refs --library --library-dir --library-header --library-makefile --library-fortran --library-fortran-name --library-python --library-python-name --localize-global-consts --local-temp-names --log-deleted-ids-to --memory-frees --override-checking --preserve-inlined-line-numbers --print-id-on-error --print-unused-internal-functions --region-vectorizer --remove-empty-records --remove-unreachable-blocks --replace-array-accesses-with-ref-temps --incremental --minimal-modules --print-chpl-settings --stop-after-pass --force-vectorize --warn-const-loops --warn-domain-literal --warn-tuple-iteration --warn-special --print-chpl-home --no-count-tokens --no-print-code-size --no-print-search-dirs --no-permit-unhandled-module-errors --no-warn-unstable --no-warnings --no-local --no-cache-remote --no-copy-propagation --no-dead-code-elimination --no-fast-followers --no-ieee-float --no-ignore-local-classes --no-inline --no-inline-iterators --no-live-analysis --no-loop-invariant-code-motion --no-optimize-forall-unordered-ops --no-optimize-range-iterators --no-optimize-loop-iterators --no-optimize-on-clauses --no-privatization --no-remote-value-forwarding --no-remote-serialization --no-remove-copy-calls --no-scalar-replacement --no-tuple-copy-opt --no-use-noinit --no-infer-local-fields --no-vectorize --no-bounds-checks --no-cast-checks --no-div-by-zero-checks --no-formal-domain-checks --no-local-checks --no-nil-checks --no-stack-checks --no-codegen --no-cpp-lines --no-munge-user-idents --no-debug --no-optimize --no-specialize --no-llvm --no-llvm-wide-opt --no-print-commands --no-print-passes --no-print-pass-profile --no-devel --no-explain-verbose --no-print-callgraph --no-print-callstack-on-error --no-print-unused-functions --no-task-tracking --no-cc-warnings --no-gen-ids --no-html-wrap-lines --no-html-print-block-ids --no-log-ids --no-verify --no-parse-only --no-debug-short-loc --no-report-aliases --no-report-blocking --no-default-unmanaged --no-legacy-new --no-denormalize --no-interprocedural-alias-analysis --no-lifetime-checking --no-compile-time-nil-checking --no-ignore-errors --no-ignore-user-errors --no-ignore-errors-for-pass --no-infer-const-refs --no-localize-global-consts --no-local-temp-names --no-memory-frees --no-override-checking --no-preserve-inlined-line-numbers --no-print-id-on-error --no-print-unused-internal-functions --no-region-vectorizer --no-remove-empty-records --no-remove-unreachable-blocks --no-replace-array-accesses-with-ref-temps --no-incremental --no-minimal-modules --no-force-vectorize --no-warn-const-loops --no-warn-domain-literal --no-warn-tuple-iteration --no-warn-special"
 
       # non-developer options
-      local nodevel_opts="-M -g -I -l -L -O -o -s -h --count-tokens --main-module --module-dir --print-code-size --print-module-files --print-search-dirs --permit-unhandled-module-errors --warn-unstable --warnings --local --baseline --cache-remote --copy-propagation --dead-code-elimination --fast --fast-followers --ieee-float --ignore-local-classes --inline --inline-iterators --inline-iterators-yield-limit --live-analysis --loop-invariant-code-motion --optimize-forall-unordered-ops --optimize-range-iterators --optimize-loop-iterators --optimize-on-clauses --optimize-on-clause-limit --privatization --remote-value-forwarding --remote-serialization --remove-copy-calls --scalar-replacement --scalar-replace-limit --tuple-copy-opt --tuple-copy-limit --use-noinit --infer-local-fields --vectorize --no-checks --bounds-checks --cast-checks --div-by-zero-checks --formal-domain-checks --local-checks --nil-checks --stack-checks --codegen --cpp-lines --max-c-ident-len --munge-user-idents --savec --ccflags --debug --dynamic --hdr-search-path --ldflags --lib-linkage --lib-search-path --optimize --specialize --output --static --llvm --llvm-wide-opt --mllvm --print-commands --print-passes --print-passes-file --devel --explain-call --explain-instantiation --explain-verbose --instantiate-max --print-callgraph --print-callstack-on-error --print-unused-functions --set --task-tracking --home --atomics --network-atomics --aux-filesys --comm --comm-substrate --gasnet-segment --gmp --hwloc --launcher --locale-model --make --mem --regexp --target-arch --target-compiler --target-cpu --target-platform --tasks --timers --copyright --help --help-env --help-settings --license --version --no-count-tokens --no-print-code-size --no-print-search-dirs --no-permit-unhandled-module-errors --no-warn-unstable --no-warnings --no-local --no-cache-remote --no-copy-propagation --no-dead-code-elimination --no-fast-followers --no-ieee-float --no-ignore-local-classes --no-inline --no-inline-iterators --no-live-analysis --no-loop-invariant-code-motion --no-optimize-forall-unordered-ops --no-optimize-range-iterators --no-optimize-loop-iterators --no-optimize-on-clauses --no-privatization --no-remote-value-forwarding --no-remote-serialization --no-remove-copy-calls --no-scalar-replacement --no-tuple-copy-opt --no-use-noinit --no-infer-local-fields --no-vectorize --no-bounds-checks --no-cast-checks --no-div-by-zero-checks --no-formal-domain-checks --no-local-checks --no-nil-checks --no-stack-checks --no-codegen --no-cpp-lines --no-munge-user-idents --no-debug --no-optimize --no-specialize --no-llvm --no-llvm-wide-opt --no-print-commands --no-print-passes --no-devel --no-explain-verbose --no-print-callgraph --no-print-callstack-on-error --no-print-unused-functions --no-task-tracking"
+      local nodevel_opts="-M -g -I -l -L -O -o -s -h --count-tokens --main-module --module-dir --print-code-size --print-module-files --print-search-dirs --permit-unhandled-module-errors --warn-unstable --warnings --local --baseline --cache-remote --copy-propagation --dead-code-elimination --fast --fast-followers --ieee-float --ignore-local-classes --inline --inline-iterators --inline-iterators-yield-limit --live-analysis --loop-invariant-code-motion --optimize-forall-unordered-ops --optimize-range-iterators --optimize-loop-iterators --optimize-on-clauses --optimize-on-clause-limit --privatization --remote-value-forwarding --remote-serialization --remove-copy-calls --scalar-replacement --scalar-replace-limit --tuple-copy-opt --tuple-copy-limit --use-noinit --infer-local-fields --vectorize --no-checks --bounds-checks --cast-checks --div-by-zero-checks --formal-domain-checks --local-checks --nil-checks --stack-checks --c-units --codegen --cpp-lines --max-c-ident-len --munge-user-idents --savec --ccflags --debug --dynamic --hdr-search-path --ldflags --lib-linkage --lib-search-path --optimize --specialize --output --static --llvm --llvm-codegen-threads --llvm-wide-opt --mllvm --print-commands --print-passes --print-passes-file --print-pass-profile --print-pass-profile-json --devel --explain-call --explain-instantiation --explain-verbose --instantiate-max --print-callgraph --print-callstack-on-error --print-unused-functions --set --task-tracking --home --atomics --network-atomics --aux-filesys --comm --comm-substrate --gasnet-segment --gmp --hwloc --launcher --locale-model --make --mem --regexp --target-arch --target-compiler --target-cpu --target-platform --tasks --timers --copyright --help --help-env --help-settings --license --version --no-count-tokens --no-print-code-size --no-print-search-dirs --no-permit-unhandled-module-errors --no-warn-unstable --no-warnings --no-local --no-cache-remote --no-copy-propagation --no-dead-code-elimination --no-fast-followers --no-ieee-float --no-ignore-local-classes --no-inline --no-inline-iterators --no-live-analysis --no-loop-invariant-code-motion --no-optimize-forall-unordered-ops --no-optimize-range-iterators --no-optimize-loop-iterators --no-optimize-on-clauses --no-privatization --no-remote-value-forwarding --no-remote-serialization --no-remove-copy-calls --no-scalar-replacement --no-tuple-copy-opt --no-use-noinit --no-infer-local-fields --no-vectorize --no-bounds-checks --no-cast-checks --no-div-by-zero-checks --no-formal-domain-checks --no-local-checks --no-nil-checks --no-stack-checks --no-codegen --no-cpp-lines --no-munge-user-idents --no-debug --no-optimize --no-specialize --no-llvm --no-llvm-wide-opt --no-print-commands --no-print-passes --no-print-pass-profile --no-devel --no-explain-verbose --no-print-callgraph --no-print-callstack-on-error --no-print-unused-functions --no-task-tracking"
 
       # Look for --devel or --no-devel on the command line.
       # It overrides the CHPL_DEVELOPER environment variable.